@@ -159,6 +159,16 @@ typedef struct ActorShape {
 // Flag controlling the use of `Actor.sfx`. Do not use directly. See Actor_PlaySfx_FlaggedTimer
 #define ACTOR_FLAG_SFX_TIMER (1 << 28)
 
+// Actor may update less often while it is far from Player and outside its culling volume, see `Actor_ThrottleUpdate`.
+// Only for actors that still behave correctly when some of their updates are skipped: an update moves timers and
+// animations by one frame regardless, so skipped frames are not made up. Clear it for actors whose update moves them,
+// which would slow down, and while an actor runs a timer that must keep pace.
+#if ACTOR_UPDATE_LOD
+#define ACTOR_FLAG_UPDATE_LOD (1 << 29)
+#else
+#define ACTOR_FLAG_UPDATE_LOD 0
+#endif
+
 #define ACTOR_FLAGS_CHECK_ALL(thisx, mask) (((thisx)->flags & (mask)) == (mask))
 
 #define COLORFILTER_GET_COLORINTENSITY(colorFilterParams) (((colorFilterParams) & 0x1F00) >> 5)
@@ -240,10 +250,25 @@ typedef struct Actor {
     /* 0x130 */ ActorFunc update; // Update Routine. Called by `Actor_UpdateAll`
     /* 0x134 */ ActorFunc draw; // Draw Routine. Called by `Actor_Draw`
     /* 0x138 */ struct ActorOverlay* overlayEntry; // Pointer to the overlay table entry for this actor
+    // The offsets of the optional fields below assume that all of the optional fields before them are present
+#if ACTOR_ID_INDEX
+    /* 0x13C */ struct Actor* idPrev; // Previous actor with the same ID, in any category
+    /* 0x140 */ struct Actor* idNext; // Next actor with the same ID, in any category. See `Actor_FindFirstOfId`
+#endif
+#if ACTOR_GRID
+    /* 0x144 */ struct Actor* gridPrev; // Previous actor in the same grid bucket
+    /* 0x148 */ struct Actor* gridNext; // Next actor in the same grid bucket
+    /* 0x14C */ u32 gridOrder; // Set when added to a category, the front of a category list has the highest
+    /* 0x150 */ s16 gridCellX;
+    /* 0x152 */ s16 gridCellZ;
+#endif
+#if ACTOR_UPDATE_LOD
+    /* 0x154 */ u8 updateLodTimer; // Updates left to skip while throttled
+#endif
 #if DEBUG_FEATURES
-    /* 0x13C */ char dbgPad[0x10];
+    /* 0x155 */ char dbgPad[0x10];
 #endif
-} Actor; // size = 0x14C
+} Actor; // size = 0x14C (+ 0x8 with ACTOR_ID_INDEX, + 0x10 with ACTOR_GRID, + 0x4 with ACTOR_UPDATE_LOD)
 
 typedef enum ActorFootIndex {
     /* 0 */ FOOT_LEFT,
@@ -472,6 +497,27 @@ typedef struct ActorListEntry {
     /* 0x04 */ Actor* head; // pointer to head of the linked list of this category (most recent actor added)
 } ActorListEntry; // size = 0x08
 
+#if ACTOR_GRID
+// Cells of 256x256 units in XZ, 256 per axis cover the whole s16 range
+#define ACTOR_GRID_CELL_SIZE 256
+#define ACTOR_GRID_CELLS 256
+// Cells are hashed into buckets by wrapping every 16 cells per axis, so a block of up to 16x16 cells uses each bucket
+// once
+#define ACTOR_GRID_WRAP 16
+#define ACTOR_GRID_BUCKETS (ACTOR_GRID_WRAP * ACTOR_GRID_WRAP)
+
+typedef struct ActorGrid {
+    /* 0x000 */ Actor* buckets[ACTOR_GRID_BUCKETS]; // Actors of the cells in each bucket, linked by `Actor.gridNext`
+    /* 0x400 */ u32 nextOrder;
+    /* 0x404 */ f32 playerMinX; // XZ bounds of Player's positions when the distances to Player were computed this frame
+    /* 0x408 */ f32 playerMaxX;
+    /* 0x40C */ f32 playerMinZ;
+    /* 0x410 */ f32 playerMaxZ;
+    /* 0x414 */ u8 distancesCurrent; // Every actor with an update function had its distance to Player computed this
+                                     // frame, see `ActorGrid_BeginFrame`
+} ActorGrid; // size = 0x418
+#endif
+
 typedef struct ActorContextSceneFlags {
     /* 0x00 */ u32 swch;
     /* 0x04 */ u32 tempSwch;
@@ -497,7 +543,13 @@ typedef struct ActorContext {
     /* 0x128 */ TitleCardContext titleCtx;
     /* 0x138 */ char unk_138[0x04];
     /* 0x13C */ void* absoluteSpace; // Space used to allocate actor overlays with alloc type ACTOROVL_ALLOC_ABSOLUTE
-} ActorContext; // size = 0x140
+#if ACTOR_ID_INDEX
+    /* 0x140 */ Actor* idLists[ACTOR_ID_MAX]; // Most recently added actor of each ID, linked by `Actor.idNext`
+#endif
+#if ACTOR_GRID
+    /* 0x788 */ ActorGrid grid; // Offset with ACTOR_ID_INDEX
+#endif
+} ActorContext; // size = 0x140 (+ 0x648 with ACTOR_ID_INDEX, + 0x418 with ACTOR_GRID)
 
 // EnDoor and DoorKiller share openAnim and playerIsOpening
 // Due to alignment, a substruct cannot be used in the structs of these actors.
@@ -736,6 +788,27 @@ Actor* Actor_Delete(ActorContext* actorCtx, Actor* actor, struct PlayState* play
 Actor* Attention_FindActor(struct PlayState* play, ActorContext* actorCtx, Actor** attentionActorP,
                            struct Player* player);
 Actor* Actor_Find(ActorContext* actorCtx, s32 actorId, s32 actorCategory);
+#if ACTOR_ID_INDEX
+Actor* Actor_FindFirstOfId(ActorContext* actorCtx, s32 actorId);
+#if DEBUG_FEATURES
+void Actor_DisplayIdIndexStats(void);
+#endif
+#endif
+#if ACTOR_UPDATE_LOD && DEBUG_FEATURES
+void Actor_DisplayUpdateLodStats(void);
+#endif
+#if ACTOR_GRID
+void ActorGrid_Insert(ActorGrid* grid, Actor* actor);
+void ActorGrid_Remove(ActorGrid* grid, Actor* actor);
+void ActorGrid_Update(ActorGrid* grid, Actor* actor);
+void ActorGrid_BeginFrame(ActorGrid* grid);
+void ActorGrid_BeginActor(ActorGrid* grid, Actor* actor, Actor* player);
+Actor** ActorGrid_Gather(ActorContext* actorCtx, f32 x, f32 z, f32 radius, u32 categoryMask, s32* outCount);
+#if DEBUG_FEATURES
+void ActorGrid_SpawnBenchmark(struct PlayState* play);
+void ActorGrid_Display(void);
+#endif
+#endif
 void Enemy_StartFinishingBlow(struct PlayState* play, Actor* actor);
 void BodyBreak_Alloc(BodyBreak* bodyBreak, s32 count, struct PlayState* play);
 void BodyBreak_SetInfo(BodyBreak* bodyBreak, s32 limbIndex, s32 minLimbIndex, s32 maxLimbIndex, u32 count, Gfx** dList,
@@ -0,0 +1,46 @@
+#ifndef ARENA_TRACE_H
+#define ARENA_TRACE_H
+
+#include "ultra64.h"
+
+// Allocation tracing is only available in debug builds
+#define ARENA_TRACE_ENABLED (DEBUG_FEATURES && ARENA_TRACE)
+
+typedef enum ArenaTraceArena {
+    /* 0 */ ARENA_TRACE_SYSTEM,
+    /* 1 */ ARENA_TRACE_ZELDA,
+    /* 2 */ ARENA_TRACE_MAX
+} ArenaTraceArena;
+
+typedef enum ArenaTraceOp {
+    /* 0 */ ARENA_TRACE_OP_INIT,     // ptr is the start of the arena, size its size
+    /* 1 */ ARENA_TRACE_OP_CLEANUP,
+    /* 2 */ ARENA_TRACE_OP_MALLOC,   // ptr is the allocation, NULL if it failed
+    /* 3 */ ARENA_TRACE_OP_MALLOC_R,
+    /* 4 */ ARENA_TRACE_OP_REALLOC,  // oldPtr is the reallocated block, ptr the new one
+    /* 5 */ ARENA_TRACE_OP_FREE      // ptr is the freed block
+} ArenaTraceOp;
+
+typedef struct ArenaTraceRecord {
+    /* 0x00 */ u8 arena;
+    /* 0x01 */ u8 op;
+    /* 0x02 */ u16 line;
+    /* 0x04 */ u32 frame;
+    /* 0x08 */ u32 size;
+    /* 0x0C */ void* ptr;
+    /* 0x10 */ void* oldPtr;
+    /* 0x14 */ const char* file; // NULL for allocations without debug info
+} ArenaTraceRecord; // size = 0x18
+
+#if ARENA_TRACE_ENABLED
+void ArenaTrace_Record(s32 arena, s32 op, void* ptr, void* oldPtr, u32 size, const char* file, int line);
+void ArenaTrace_NextFrame(void);
+void ArenaTrace_Dump(void);
+
+#define ARENA_TRACE_RECORD(arena, op, ptr, oldPtr, size, file, line) \
+    ArenaTrace_Record(arena, op, ptr, oldPtr, size, file, line)
+#else
+#define ARENA_TRACE_RECORD(arena, op, ptr, oldPtr, size, file, line) (void)0
+#endif
+
+#endif
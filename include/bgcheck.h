@@ -241,6 +241,21 @@ typedef struct SurfaceType {
     u32 data[2];
 } SurfaceType;
 
+#if COLLISION_BVH
+typedef struct CollisionBvhNode {
+    /* 0x00 */ Vec3s min;
+    /* 0x06 */ Vec3s max;
+    /* 0x0C */ u16 start; // leaf: index of its first poly id in polyIds, inner node: index of its first child node
+    /* 0x0E */ u16 count; // leaf: number of poly ids, inner node: 0. The second child follows the first one.
+} CollisionBvhNode; // size = 0x10
+
+typedef struct CollisionBvh {
+    /* 0x00 */ u16 numNodes;
+    /* 0x04 */ CollisionBvhNode* nodes; // root first
+    /* 0x08 */ u16* polyIds;
+} CollisionBvh; // size = 0xC
+#endif
+
 typedef struct CollisionHeader {
     /* 0x00 */ Vec3s minBounds; // minimum coordinates of poly bounding box
     /* 0x06 */ Vec3s maxBounds; // maximum coordinates of poly bounding box
@@ -252,6 +267,13 @@ typedef struct CollisionHeader {
     /* 0x20 */ BgCamInfo* bgCamList;
     /* 0x24 */ u16 numWaterBoxes;
     /* 0x28 */ WaterBox* waterBoxes;
+#if COLLISION_BVH
+    /* 0x2C */ CollisionBvh* bvh; // bounding volume hierarchy of the polys, built by the asset extraction for scenes
+#endif
+#if COLLISION_BAKED_LOOKUP
+    // StaticLookup tables, built by the asset extraction for scenes. At 0x2C without COLLISION_BVH
+    /* 0x30 */ struct CollisionBakedLookup* bakedLookup;
+#endif
 } CollisionHeader; // original name: BGDataInfo
 
 typedef struct SSNode {
@@ -283,6 +305,15 @@ typedef struct StaticLookup {
     SSList ceiling;
 } StaticLookup;
 
+#if COLLISION_BAKED_LOOKUP
+typedef struct CollisionBakedLookup {
+    /* 0x00 */ Vec3s subdivAmount; // the tables are only valid for these subdivisions
+    /* 0x06 */ u16 numNodes;
+    /* 0x08 */ StaticLookup* lookupTbl;
+    /* 0x0C */ SSNode* nodes;
+} CollisionBakedLookup; // size = 0x10
+#endif
+
 typedef struct DynaLookup {
     u16 polyStartIndex;
     SSList ceiling;
@@ -473,6 +504,12 @@ s32 func_800427B4(CollisionPoly* polyA, CollisionPoly* polyB, Vec3f* pointA, Vec
 void BgCheck_DrawDynaCollision(struct PlayState*, CollisionContext*);
 void BgCheck_DrawStaticCollision(struct PlayState*, CollisionContext*);
 #endif
+#if COLLISION_BVH
+void BgCheck_BuildPendingStaticLookups(CollisionContext* colCtx);
+#if DEBUG_FEATURES
+void BgCheck_DisplayBvhStats(void);
+#endif
+#endif
 
 void func_80043334(CollisionContext* colCtx, struct Actor* actor, s32 bgId);
 s32 DynaPolyActor_TransformCarriedActor(CollisionContext* colCtx, s32 bgId, struct Actor* carriedActor);
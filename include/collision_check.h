@@ -324,6 +324,22 @@ typedef struct OcLine {
 typedef struct CollisionCheckContext {
     /* 0x000 */ s16 colATCount;
     /* 0x002 */ u16 sacFlags;
+#if COLLISION_LIST_GROWTH
+    /* 0x004 */ Collider** colAT;
+    /* 0x008 */ s32 colACCount;
+    /* 0x00C */ Collider** colAC;
+    /* 0x010 */ s32 colOCCount;
+    /* 0x014 */ Collider** colOC;
+    /* 0x018 */ s32 colLineCount;
+    /* 0x01C */ OcLine* colLine[COLLISION_CHECK_OC_LINE_MAX];
+    // The lists start as these arrays, and move to the Zelda arena when a scene needs more
+    /* 0x028 */ s32 colATCapacity;
+    /* 0x02C */ s32 colACCapacity;
+    /* 0x030 */ s32 colOCCapacity;
+    /* 0x034 */ Collider* colATDefault[COLLISION_CHECK_AT_MAX];
+    /* 0x0FC */ Collider* colACDefault[COLLISION_CHECK_AC_MAX];
+    /* 0x1EC */ Collider* colOCDefault[COLLISION_CHECK_OC_MAX];
+#else
     /* 0x004 */ Collider* colAT[COLLISION_CHECK_AT_MAX];
     /* 0x0CC */ s32 colACCount;
     /* 0x0D0 */ Collider* colAC[COLLISION_CHECK_AC_MAX];
@@ -331,7 +347,8 @@ typedef struct CollisionCheckContext {
     /* 0x1C4 */ Collider* colOC[COLLISION_CHECK_OC_MAX];
     /* 0x28C */ s32 colLineCount;
     /* 0x290 */ OcLine* colLine[COLLISION_CHECK_OC_LINE_MAX];
-} CollisionCheckContext; // size = 0x29C
+#endif
+} CollisionCheckContext; // size = 0x29C (0x2B4 with COLLISION_LIST_GROWTH)
 
 /*
  * Collider properties, for all shapes
@@ -550,8 +567,17 @@ s32 CollisionCheck_SetOC(struct PlayState* play, CollisionCheckContext* colChkCt
 s32 CollisionCheck_SetOC_SAC(struct PlayState* play, CollisionCheckContext* colChkCtx, Collider* collider, s32 index);
 s32 CollisionCheck_SetOCLine(struct PlayState* play, CollisionCheckContext* colChkCtx, OcLine* collider);
 void CollisionCheck_BlueBlood(struct PlayState* play, Collider* collider, Vec3f* v);
+#if COLLISION_LIST_GROWTH && DEBUG_FEATURES
+void CollisionCheck_DisplayListStats(CollisionCheckContext* colChkCtx);
+#endif
 void CollisionCheck_AT(struct PlayState* play, CollisionCheckContext* colChkCtx);
+#if COLLISION_BROADPHASE && DEBUG_FEATURES
+void CollisionCheck_DisplayBroadphaseStats(void);
+#endif
 void CollisionCheck_OC(struct PlayState* play, CollisionCheckContext* colChkCtx);
+#if COLLISION_OC_SWEEP && DEBUG_FEATURES
+void CollisionCheck_DisplayOCSweepStats(void);
+#endif
 void CollisionCheck_InitInfo(CollisionCheckInfo* info);
 void CollisionCheck_ResetDamage(CollisionCheckInfo* info);
 void CollisionCheck_SetInfoNoDamageTable(CollisionCheckInfo* info, CollisionCheckInfoInit* init);
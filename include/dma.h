@@ -5,6 +5,16 @@
 #include "alignment.h"
 #include "romfile.h"
 
+#if DMA_PRIORITY_CLASSES
+// Requests are processed by class, most urgent first, and each class in the order the requests are received
+typedef enum DmaPriority {
+    DMA_PRIORITY_HIGH,   // Small transfers a thread is waiting on. May run while a file is being decompressed.
+    DMA_PRIORITY_NORMAL, // Asynchronous loads, such as rooms and objects
+    DMA_PRIORITY_LOW,    // Speculative loads, see DmaMgr_RequestPrefetch
+    DMA_PRIORITY_MAX
+} DmaPriority;
+#endif
+
 typedef struct DmaRequest {
     /* 0x00 */ uintptr_t    vromAddr; // VROM address (source)
     /* 0x04 */ void*        dramAddr; // DRAM address (destination)
@@ -14,7 +24,11 @@ typedef struct DmaRequest {
     /* 0x14 */ s32          unk_14;
     /* 0x18 */ OSMesgQueue* notifyQueue; // Message queue for the notification message
     /* 0x1C */ OSMesg       notifyMsg;   // Completion notification message
-} DmaRequest; // size = 0x20
+#if DMA_PRIORITY_CLASSES
+    /* 0x20 */ u32          priority;    // See DmaPriority
+    /* 0x24 */ u32          queuedTime;  // osGetCount() when the request was queued, for the wait time statistics
+#endif
+} DmaRequest; // size = 0x20 (0x28 with DMA_PRIORITY_CLASSES)
 
 typedef struct DmaEntry {
     /* 0x00 */ RomFile file;
@@ -22,6 +36,15 @@ typedef struct DmaEntry {
     /* 0x0C */ uintptr_t romEnd;
 } DmaEntry;
 
+#if CHUNKED_YAZ0 || LZ4_COMPRESSION
+// ROM segments are 16-byte aligned, so the low bits of a compressed entry's romEnd are free to describe its format
+#define DMA_ENTRY_ROM_END_FLAGS 0xF
+// The file is a chunked Yaz0 container, see Yaz0_DecompressChunked
+#define DMA_ENTRY_CHUNKED (1 << 0)
+// The file is compressed with LZ4 instead of Yaz0/gzip, see Lz4_Decompress
+#define DMA_ENTRY_LZ4 (1 << 1)
+#endif
+
 extern DmaEntry gDmaDataTable[];
 
 extern u32 gDmaMgrVerbose;
@@ -34,6 +57,13 @@ extern size_t gDmaMgrDmaBuffSize;
 s32 DmaMgr_RequestAsync(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk5, OSMesgQueue* queue,
                         OSMesg msg);
 s32 DmaMgr_RequestSync(void* ram, uintptr_t vrom, size_t size);
+#if ROOM_PREFETCH
+s32 DmaMgr_RequestPrefetch(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, OSMesgQueue* queue, OSMesg msg);
+#endif
+#if DMA_PRIORITY_CLASSES
+s32 DmaMgr_RequestAsyncPriority(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk5, OSMesgQueue* queue,
+                                OSMesg msg, DmaPriority priority);
+#endif
 #if DEBUG_FEATURES
 s32 DmaMgr_RequestAsyncDebug(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk5, OSMesgQueue* queue,
                              OSMesg msg, const char* file, int line);
@@ -43,8 +73,14 @@ s32 DmaMgr_RequestSyncDebug(void* ram, uintptr_t vrom, size_t size, const char*
 // Special-purpose DMA Requests
 
 s32 DmaMgr_DmaRomToRam(uintptr_t rom, void* ram, size_t size);
+#if YAZ0_ASYNC_DMA
+s32 DmaMgr_DmaRomToRamAsync(OSIoMesg* ioMsg, OSMesgQueue* queue, uintptr_t rom, void* ram, size_t size);
+#endif
 void DmaMgr_DmaFromDriveRom(void* ram, uintptr_t rom, size_t size);
 s32 DmaMgr_AudioDmaHandler(OSPiHandle* pihandle, OSIoMesg* mb, s32 direction);
+#if DMA_PRIORITY_CLASSES
+void DmaMgr_RunPreemptingRequests(void);
+#endif
 
 // Initialization
 
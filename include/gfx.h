@@ -14,6 +14,39 @@
 // Texture memory size, 4 KiB
 #define TMEM_SIZE 0x1000
 
+#if GFX_POOL_ADAPTIVE
+
+typedef enum GfxPoolBuffer {
+    /* 0 */ GFXPOOL_POLY_OPA,
+    /* 1 */ GFXPOOL_POLY_XLU,
+    /* 2 */ GFXPOOL_OVERLAY,
+    /* 3 */ GFXPOOL_WORK,
+    /* 4 */ GFXPOOL_MAX
+} GfxPoolBuffer;
+
+// The POLY_OPA, POLY_XLU and OVERLAY buffers share dispBuffer, split between them by Graph_BalanceGfxPool
+typedef struct GfxPool {
+    /* 0x00000 */ u16 headMagic; // GFXPOOL_HEAD_MAGIC
+    /* 0x00008 */ Gfx dispBuffer[0x17E0 + 0x800 + 0x400];
+    /* 0x11F08 */ Gfx workBuffer[0x80];
+    /* 0x11308 */ Gfx unusedBuffer[0x20];
+    /* 0x12408 */ u16 tailMagic; // GFXPOOL_TAIL_MAGIC
+} GfxPool; // size = 0x12410
+
+typedef struct GfxPoolStats {
+    /* 0x00 */ u32 size[GFXPOOL_MAX];      // Size of each buffer in the frame being built, in bytes
+    /* 0x10 */ u32 highWater[GFXPOOL_MAX]; // Most bytes used by each buffer in a frame, over the last one to two windows
+    /* 0x20 */ u32 windowMax[GFXPOOL_MAX]; // Most bytes used by each buffer in a frame, in the current window
+    /* 0x30 */ u32 peak[GFXPOOL_MAX];      // Most bytes used by each buffer in a frame, since the last reset
+    /* 0x40 */ u32 overflows[GFXPOOL_MAX]; // Frames each buffer overflowed in, since the last reset
+    /* 0x50 */ u32 frames;                 // Frames since the last reset
+    /* 0x54 */ u32 windowFrames;
+} GfxPoolStats; // size = 0x58
+
+extern GfxPoolStats gGfxPoolStats;
+
+#else
+
 typedef struct GfxPool {
     /* 0x00000 */ u16 headMagic; // GFXPOOL_HEAD_MAGIC
     /* 0x00008 */ Gfx polyOpaBuffer[0x17E0];
@@ -24,6 +57,8 @@ typedef struct GfxPool {
     /* 0x12408 */ u16 tailMagic; // GFXPOOL_TAIL_MAGIC
 } GfxPool; // size = 0x12410
 
+#endif
+
 typedef struct GraphicsContext {
     /* 0x0000 */ Gfx* polyOpaBuffer; // Pointer to "Zelda 0"
     /* 0x0004 */ Gfx* polyXluBuffer; // Pointer to "Zelda 1"
@@ -78,6 +113,11 @@ void func_80095974(GraphicsContext* gfxCtx);
 void* Graph_Alloc(GraphicsContext* gfxCtx, size_t size);
 void* Graph_Alloc2(GraphicsContext* gfxCtx, size_t size);
 
+#if GFX_POOL_ADAPTIVE
+void Graph_ResetGfxPoolStats(void);
+void Graph_PrintGfxPoolStats(s32 sceneId);
+#endif
+
 #define WORK_DISP       __gfxCtx->work.p
 #define POLY_OPA_DISP   __gfxCtx->polyOpa.p
 #define POLY_XLU_DISP   __gfxCtx->polyXlu.p
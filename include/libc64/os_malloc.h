@@ -5,6 +5,11 @@
 
 struct ArenaNode;
 
+#if ARENA_SIZE_CLASSES
+// Number of size classes of free blocks, class n holds the blocks of size 2^n to 2^(n+1)-1
+#define ARENA_SIZE_CLASS_MAX 32
+#endif
+
 typedef struct Arena {
     /* 0x00 */ struct ArenaNode* head;
     /* 0x04 */ void* start;
@@ -16,8 +21,12 @@ typedef struct Arena {
     /* 0x20 */ u8 allocFailures; // only used in non-debug builds
     /* 0x21 */ u8 isInit;
     /* 0x22 */ u8 flag;
+#if ARENA_SIZE_CLASSES
+    /* 0x24 */ u32 freeListMask; // Bit n is set if freeLists[n] isn't empty
+    /* 0x28 */ struct ArenaNode* freeLists[ARENA_SIZE_CLASS_MAX];
+#endif
 #endif
-} Arena; // size = 0x10 (N64), size = 0x24 (GC)
+} Arena; // size = 0x10 (N64), size = 0x24 (GC), size = 0xA8 (GC with ARENA_SIZE_CLASSES)
 
 typedef struct ArenaNode {
     /* 0x00 */ s16 magic;
@@ -31,9 +40,18 @@ typedef struct ArenaNode {
     /* 0x18 */ OSId threadId;
     /* 0x1C */ Arena* arena;
     /* 0x20 */ OSTime time;
+#if !PLATFORM_N64 && ARENA_SIZE_CLASSES
+    /* 0x28 */ struct ArenaNode* nextFree; // Links in the free list of the block's size class, only for free blocks
+    /* 0x2C */ struct ArenaNode* prevFree;
+#else
     /* 0x28 */ u8 unk_28[0x30-0x28]; // probably padding
 #endif
-} ArenaNode; // size = 0x30 (N64 and GC debug), size = 0x10 (GC retail)
+#elif ARENA_SIZE_CLASSES
+    /* 0x10 */ struct ArenaNode* nextFree;
+    /* 0x14 */ struct ArenaNode* prevFree;
+    /* 0x18 */ u8 unk_18[0x20-0x18]; // Keeps blocks 16-byte aligned
+#endif
+} ArenaNode; // size = 0x30 (N64 and GC debug), size = 0x10 (GC retail), size = 0x20 (GC retail with ARENA_SIZE_CLASSES)
 
 #if PLATFORM_N64
 #define DECLARE_INTERRUPT_MASK OSIntMask __mask;
@@ -0,0 +1,10 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include "stddef.h"
+#include "stdint.h"
+#include "ultra64.h"
+
+void Lz4_Decompress(uintptr_t romStart, u8* dst, size_t size);
+
+#endif
@@ -170,5 +170,8 @@ s32 Room_RequestNewRoom(struct PlayState* play, RoomContext* roomCtx, s32 roomNu
 s32 Room_ProcessRoomRequest(struct PlayState* play, RoomContext* roomCtx);
 void Room_Draw(struct PlayState* play, Room* room, u32 flags);
 void Room_FinishRoomChange(struct PlayState* play, RoomContext* roomCtx);
+#if ROOM_PREFETCH
+void Room_StopPrefetch(void);
+#endif
 
 #endif
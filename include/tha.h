@@ -24,4 +24,11 @@ void THA_Reset(TwoHeadArena* tha);
 void THA_Init(TwoHeadArena* tha, void* start, size_t size);
 void THA_Destroy(TwoHeadArena* tha);
 
+#if THA_SCRATCH
+void* THA_MarkHead(TwoHeadArena* tha);
+void* THA_MarkTail(TwoHeadArena* tha);
+void THA_ReleaseHead(TwoHeadArena* tha, void* mark);
+void THA_ReleaseTail(TwoHeadArena* tha, void* mark);
+#endif
+
 #endif
@@ -6,5 +6,8 @@
 #include "ultra64.h"
 
 void Yaz0_Decompress(uintptr_t romStart, u8* dst, size_t size);
+#if CHUNKED_YAZ0
+void Yaz0_DecompressChunked(uintptr_t romStart, u8* dst, size_t offset, size_t size);
+#endif
 
 #endif
@@ -71,4 +71,14 @@ void ActorOverlayTable_LogPrint(void);
 void ActorOverlayTable_Init(void);
 void ActorOverlayTable_Cleanup(void);
 
+#if ACTOR_OVERLAY_CACHE
+u32 ActorOverlayTable_GetDataSize(ActorOverlay* overlayEntry);
+void ActorOverlayTable_SaveData(ActorOverlay* overlayEntry);
+s32 ActorOverlayTable_CacheEvict(void);
+s32 ActorOverlayTable_CacheKeep(ActorOverlay* overlayEntry);
+void ActorOverlayTable_CacheTake(ActorOverlay* overlayEntry);
+void ActorOverlayTable_CacheClear(void);
+void ActorOverlayTable_CacheDisplay(void);
+#endif
+
 #endif
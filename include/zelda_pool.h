@@ -0,0 +1,38 @@
+#ifndef ZELDA_POOL_H
+#define ZELDA_POOL_H
+
+#include "ultra64.h"
+#include "zelda_arena.h"
+
+#if ZELDA_POOLS
+
+void ZeldaPool_Init(void);
+void ZeldaPool_Cleanup(void);
+void* ZeldaPool_Malloc(u32 size);
+void ZeldaPool_Free(void* ptr);
+s32 ZeldaPool_GetCount(void);
+void ZeldaPool_GetUsage(s32 index, u32* outBlockSize, u32* outCount, u32* outUsed, u32* outPeak);
+
+#if DEBUG_FEATURES
+void* ZeldaPool_MallocDebug(u32 size, const char* file, int line);
+void ZeldaPool_FreeDebug(void* ptr, const char* file, int line);
+void ZeldaPool_Display(void);
+
+#define ZELDA_POOL_MALLOC(size, file, line) ZeldaPool_MallocDebug(size, file, line)
+#define ZELDA_POOL_FREE(ptr, file, line) ZeldaPool_FreeDebug(ptr, file, line)
+
+#else
+
+#define ZELDA_POOL_MALLOC(size, file, line) ZeldaPool_Malloc(size)
+#define ZELDA_POOL_FREE(ptr, file, line) ZeldaPool_Free(ptr)
+
+#endif
+
+#else
+
+#define ZELDA_POOL_MALLOC(size, file, line) ZELDA_ARENA_MALLOC(size, file, line)
+#define ZELDA_POOL_FREE(ptr, file, line) ZELDA_ARENA_FREE(ptr, file, line)
+
+#endif
+
+#endif
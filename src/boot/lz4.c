@@ -0,0 +1,145 @@
+/**
+ * @file lz4.c
+ *
+ * Decoder for files compressed with `compress lz4` in the spec, an alternative to Yaz0 for files where load latency
+ * matters more than size.
+ *
+ * The data is a 0x10 bytes header ("LZ4B", the big-endian uncompressed size, 8 zero bytes) followed by an LZ4 block.
+ * The block is a series of sequences, each made of:
+ *  - a token byte, holding the literal length in the upper nibble and the match length minus 4 in the lower nibble.
+ *    A nibble of 15 means the length continues in the following bytes, which are added to it until one isn't 255.
+ *  - the literal bytes
+ *  - the match offset (little-endian u16) and the match length continuation bytes. The last sequence ends after its
+ *    literals.
+ * Everything is byte-aligned, so unlike Yaz0 there is no per-byte flag bit to test and literal runs are copied in bulk.
+ *
+ * Like Yaz0_Decompress, the compressed data is streamed from ROM through a small buffer.
+ */
+#include "lz4.h"
+
+#include "alignment.h"
+#include "ultra64.h"
+#include "dma.h"
+
+#define LZ4_HEADER_SIZE 0x10
+
+// A sequence's token, length bytes and offset are read without checking for the end of the buffer, so the buffer is
+// refilled before starting a sequence when fewer than this many bytes are left. Lengths needing more continuation
+// bytes check for the end of the buffer as they go.
+#define LZ4_SEQUENCE_HEADER_MAX 0x20
+
+ALIGNED(16) u8 sLz4DataBuffer[0x400];
+uintptr_t sLz4CurRomStart;
+size_t sLz4CurSize;
+u8* sLz4DataEnd;
+
+/**
+ * Moves the unread data left in the buffer (from `curSrcPos`) to its start, and fills the rest of the buffer from ROM.
+ *
+ * @return the new position of `curSrcPos` in the buffer
+ */
+u8* Lz4_NextDMA(u8* curSrcPos) {
+    size_t restSize = sLz4DataEnd - curSrcPos;
+    // Place the rest of the data so that the DMA destination is 8-byte aligned
+    u8* dst = (restSize & 7) ? (sLz4DataBuffer - (restSize & 7)) + 8 : sLz4DataBuffer;
+    size_t dmaSize;
+
+#if DMA_PRIORITY_CLASSES
+    DmaMgr_RunPreemptingRequests();
+#endif
+
+    bcopy(curSrcPos, dst, restSize);
+    dmaSize = (sLz4DataBuffer + sizeof(sLz4DataBuffer)) - (dst + restSize);
+    if (sLz4CurSize < dmaSize) {
+        dmaSize = sLz4CurSize;
+    }
+
+    if (dmaSize != 0) {
+        DmaMgr_DmaRomToRam(sLz4CurRomStart, dst + restSize, dmaSize);
+        sLz4CurRomStart += dmaSize;
+        sLz4CurSize -= dmaSize;
+    }
+    sLz4DataEnd = dst + restSize + dmaSize;
+
+    return dst;
+}
+
+#define LZ4_READ_LENGTH(src, len)         \
+    do {                                  \
+        u32 b_;                           \
+        do {                              \
+            if ((src) == sLz4DataEnd) {   \
+                (src) = Lz4_NextDMA(src); \
+            }                             \
+            b_ = *(src)++;                \
+            (len) += b_;                  \
+        } while (b_ == 0xFF);             \
+    } while (0)
+
+void Lz4_DecompressImpl(u8* src, u8* dst, u8* dstEnd) {
+    u32 token;
+    size_t litLen;
+    size_t matchLen;
+    u8* backPtr;
+
+    while (true) {
+        if ((sLz4DataEnd - src < LZ4_SEQUENCE_HEADER_MAX) && (sLz4CurSize != 0)) {
+            src = Lz4_NextDMA(src);
+        }
+
+        token = *src++;
+
+        litLen = token >> 4;
+        if (litLen == 0xF) {
+            LZ4_READ_LENGTH(src, litLen);
+        }
+
+        // Literal runs may be longer than what is left in the buffer
+        while (litLen > (size_t)(sLz4DataEnd - src)) {
+            size_t n = sLz4DataEnd - src;
+
+            bcopy(src, dst, n);
+            src += n;
+            dst += n;
+            litLen -= n;
+            src = Lz4_NextDMA(src);
+        }
+        bcopy(src, dst, litLen);
+        src += litLen;
+        dst += litLen;
+
+        if (dst == dstEnd) {
+            // The last sequence only has literals
+            break;
+        }
+
+        if ((sLz4DataEnd - src < LZ4_SEQUENCE_HEADER_MAX) && (sLz4CurSize != 0)) {
+            src = Lz4_NextDMA(src);
+        }
+
+        backPtr = dst - (src[0] | (src[1] << 8));
+        src += 2;
+
+        matchLen = token & 0xF;
+        if (matchLen == 0xF) {
+            LZ4_READ_LENGTH(src, matchLen);
+        }
+        matchLen += 4;
+
+        // The match may overlap the bytes it produces, so copy forwards one byte at a time
+        do {
+            *dst++ = *backPtr++;
+        } while (--matchLen != 0);
+    }
+}
+
+void Lz4_Decompress(uintptr_t romStart, u8* dst, size_t size) {
+    u8* src;
+
+    sLz4CurRomStart = romStart;
+    sLz4CurSize = size;
+    sLz4DataEnd = sLz4DataBuffer;
+    src = Lz4_NextDMA(sLz4DataBuffer);
+
+    Lz4_DecompressImpl(src + LZ4_HEADER_SIZE, dst, dst + (src[4] << 24 | src[5] << 16 | src[6] << 8 | src[7]));
+}
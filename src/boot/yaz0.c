@@ -3,16 +3,109 @@
 #include "alignment.h"
 #include "ultra64.h"
 #include "dma.h"
+#if CHUNKED_YAZ0
+#include "fault.h"
+#endif
 
 #pragma increment_block_number "gc-eu:0 gc-eu-mq:0 gc-jp:0 gc-jp-ce:0 gc-jp-mq:0 gc-us:0 gc-us-mq:0 ntsc-1.2:128" \
                                "pal-1.1:128"
 
+#if !YAZ0_ASYNC_DMA
 ALIGNED(16) u8 sYaz0DataBuffer[0x400];
+#endif
 u8* sYaz0DataBufferEnd;
 uintptr_t sYaz0CurRomStart;
 size_t sYaz0CurSize;
 u8* sYaz0MaxPtr;
 
+#if YAZ0_ASYNC_DMA
+/**
+ * The compressed data is read into two halves of the buffer in turn: while one half is decoded, the following part of
+ * the file is read into the other. Each half is preceded by room for the data left undecoded at the end of the other
+ * half when switching to it, so that the decoder always reads contiguous data.
+ *
+ * sYaz0CurSize counts the data not read yet as well as the read in progress, so that the decoder keeps asking for more
+ * data until it has received all of it.
+ */
+#define YAZ0_HALF_SIZE 0x200
+// At most 0x19 bytes are left when switching halves, this also keeps the halves 16-byte aligned
+#define YAZ0_HALF_PREFIX_SIZE 0x20
+
+// The halves are aligned to cache lines at runtime, so that the CPU writing to the prefixes never touches a cache line
+// being filled by a DMA. Declared as u64 so that they are suitably aligned for DMA with IDO too.
+u64 sYaz0DmaBufferSpace[(2 * (YAZ0_HALF_PREFIX_SIZE + YAZ0_HALF_SIZE) + 0x10) / sizeof(u64)];
+u8* sYaz0Halves[2];
+s32 sYaz0CurHalf;
+size_t sYaz0PendingSize; // size of the read in progress into the other half
+OSIoMesg sYaz0IoMsg;
+OSMesgQueue sYaz0DmaQueue;
+OSMesg sYaz0DmaMsg;
+
+/**
+ * Starts reading the next part of the file into `half`.
+ */
+void Yaz0_StartDMA(s32 half) {
+    size_t dmaSize = (sYaz0CurSize > YAZ0_HALF_SIZE) ? YAZ0_HALF_SIZE : sYaz0CurSize;
+
+    if (dmaSize != 0) {
+        DmaMgr_DmaRomToRamAsync(&sYaz0IoMsg, &sYaz0DmaQueue, sYaz0CurRomStart, sYaz0Halves[half], dmaSize);
+        sYaz0CurRomStart += dmaSize;
+    }
+    sYaz0PendingSize = dmaSize;
+}
+
+/**
+ * Waits for the read in progress, if any.
+ */
+void Yaz0_WaitDMA(void) {
+    if (sYaz0PendingSize != 0) {
+        osRecvMesg(&sYaz0DmaQueue, NULL, OS_MESG_BLOCK);
+        sYaz0CurSize -= sYaz0PendingSize;
+        sYaz0PendingSize = 0;
+    }
+}
+
+void* Yaz0_FirstDMA(void) {
+    u8* base = (u8*)ALIGN16((uintptr_t)sYaz0DmaBufferSpace);
+
+    sYaz0Halves[0] = base + YAZ0_HALF_PREFIX_SIZE;
+    sYaz0Halves[1] = sYaz0Halves[0] + YAZ0_HALF_SIZE + YAZ0_HALF_PREFIX_SIZE;
+    osCreateMesgQueue(&sYaz0DmaQueue, &sYaz0DmaMsg, 1);
+
+    sYaz0CurHalf = 0;
+    Yaz0_StartDMA(0);
+    sYaz0DataBufferEnd = sYaz0Halves[0] + sYaz0PendingSize;
+    sYaz0MaxPtr = sYaz0DataBufferEnd - 0x19;
+    Yaz0_WaitDMA();
+
+    Yaz0_StartDMA(1);
+    return sYaz0Halves[0];
+}
+
+void* Yaz0_NextDMA(u8* curSrcPos) {
+    size_t restSize = sYaz0DataBufferEnd - curSrcPos;
+    s32 nextHalf = sYaz0CurHalf ^ 1;
+    u8* dst = sYaz0Halves[nextHalf] - restSize;
+    size_t dataSize;
+
+#if DMA_PRIORITY_CLASSES
+    DmaMgr_RunPreemptingRequests();
+#endif
+
+    bcopy(curSrcPos, dst, restSize);
+
+    dataSize = sYaz0PendingSize;
+    Yaz0_WaitDMA();
+    sYaz0DataBufferEnd = sYaz0Halves[nextHalf] + dataSize;
+    sYaz0MaxPtr = sYaz0DataBufferEnd - 0x19;
+
+    // The half that was just decoded is free again
+    Yaz0_StartDMA(sYaz0CurHalf);
+    sYaz0CurHalf = nextHalf;
+
+    return dst;
+}
+#else
 void* Yaz0_FirstDMA(void) {
     s32 pad[2];
     size_t dmaSize;
@@ -34,6 +127,10 @@ void* Yaz0_NextDMA(u8* curSrcPos) {
     size_t restSize;
     size_t dmaSize;
 
+#if DMA_PRIORITY_CLASSES
+    DmaMgr_RunPreemptingRequests();
+#endif
+
     restSize = sYaz0DataBufferEnd - curSrcPos;
     dst = (restSize & 7) ? (sYaz0DataBuffer - (restSize & 7)) + 8 : sYaz0DataBuffer;
 
@@ -54,6 +151,7 @@ void* Yaz0_NextDMA(u8* curSrcPos) {
 
     return dst;
 }
+#endif
 
 typedef struct Yaz0Header {
     /* 0x00 */ char magic[4]; // Yaz0
@@ -62,6 +160,139 @@ typedef struct Yaz0Header {
     /* 0x0C */ u32 uncompDataOffset; // only used in mio0
 } Yaz0Header;                        // size = 0x10
 
+#if YAZ0_FAST_DECODER
+/**
+ * Copies a back-reference of `size` bytes starting `dist` bytes before `dst`.
+ *
+ * When `dist` is at least 4 the source and destination of any 4 consecutive bytes don't overlap, so they are copied 4
+ * at a time, as whole words when both pointers end up word-aligned. Shorter distances repeat a 1 to 3 bytes pattern,
+ * with `dist` 1 (runs of the same byte) being a plain fill.
+ *
+ * @return the end of the copied bytes
+ */
+u8* Yaz0_CopyBackRef(u8* dst, u32 dist, u32 size) {
+    u8* backPtr = dst - dist;
+
+    if (dist >= 4) {
+        if ((dist & 3) == 0) {
+            while (((uintptr_t)dst & 3) && (size != 0)) {
+                *dst++ = *backPtr++;
+                size--;
+            }
+            while (size >= 4) {
+                *(u32*)dst = *(u32*)backPtr;
+                dst += 4;
+                backPtr += 4;
+                size -= 4;
+            }
+        } else {
+            while (size >= 4) {
+                dst[0] = backPtr[0];
+                dst[1] = backPtr[1];
+                dst[2] = backPtr[2];
+                dst[3] = backPtr[3];
+                dst += 4;
+                backPtr += 4;
+                size -= 4;
+            }
+        }
+    } else if (dist == 1) {
+        u8 val = *backPtr;
+
+        do {
+            *dst++ = val;
+        } while (--size != 0);
+        return dst;
+    }
+
+    while (size != 0) {
+        *dst++ = *backPtr++;
+        size--;
+    }
+    return dst;
+}
+
+// Back-references shorter than this are copied byte by byte in place, without calling Yaz0_CopyBackRef
+#define YAZ0_SHORT_BACKREF 8
+
+// Decodes the chunk described by bit `bit` of the group's header byte, returning once the output is complete
+#define YAZ0_CHUNK(bit)                                      \
+    if (chunkHeader & (1 << (bit))) {                        \
+        *dst++ = *src++;                                     \
+    } else {                                                 \
+        dist = ((src[0] & 0xF) << 8 | src[1]) + 1;           \
+        chunkSize = src[0] >> 4;                             \
+        if (chunkSize == 0) {                                \
+            chunkSize = src[2] + 0x12;                       \
+            src += 3;                                        \
+        } else {                                             \
+            chunkSize += 2;                                  \
+            src += 2;                                        \
+        }                                                    \
+        if (chunkSize < YAZ0_SHORT_BACKREF) {                \
+            backPtr = dst - dist;                            \
+            do {                                             \
+                *dst++ = *backPtr++;                         \
+            } while (--chunkSize != 0);                      \
+        } else {                                             \
+            dst = Yaz0_CopyBackRef(dst, dist, chunkSize);    \
+        }                                                    \
+    }                                                        \
+    if (dst == dstEnd) {                                     \
+        return;                                              \
+    }                                                        \
+    (void)0
+
+/**
+ * Same as the byte-by-byte decoder below, with the loop over a group's 8 chunks unrolled, groups made only of
+ * literals copied in one go, and longer back-references copied by Yaz0_CopyBackRef.
+ * The buffer is still refilled before each group only, a group being at most 8 * 3 + 1 = 0x19 bytes.
+ */
+void Yaz0_DecompressImpl(u8* src, u8* dst) {
+    Yaz0Header* header = (Yaz0Header*)src;
+    u8* dstEnd = dst + header->decSize;
+    u32 chunkHeader;
+    u32 chunkSize;
+    u32 dist;
+    u8* backPtr;
+
+    src += sizeof(Yaz0Header);
+
+    while (true) {
+        if ((sYaz0MaxPtr < src) && (sYaz0CurSize != 0)) {
+            src = Yaz0_NextDMA(src);
+        }
+
+        chunkHeader = *src++;
+
+        if ((chunkHeader == 0xFF) && (dstEnd - dst >= 8)) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = src[3];
+            dst[4] = src[4];
+            dst[5] = src[5];
+            dst[6] = src[6];
+            dst[7] = src[7];
+            dst += 8;
+            src += 8;
+            if (dst == dstEnd) {
+                return;
+            }
+            continue;
+        }
+
+        YAZ0_CHUNK(7);
+        YAZ0_CHUNK(6);
+        YAZ0_CHUNK(5);
+        YAZ0_CHUNK(4);
+        YAZ0_CHUNK(3);
+        YAZ0_CHUNK(2);
+        YAZ0_CHUNK(1);
+        YAZ0_CHUNK(0);
+    }
+}
+#else
 void Yaz0_DecompressImpl(u8* src, u8* dst) {
     Yaz0Header* header = (Yaz0Header*)src;
     u32 bitIdx = 0;
@@ -107,10 +338,87 @@ void Yaz0_DecompressImpl(u8* src, u8* dst) {
         bitIdx--;
     } while (dst != dstEnd);
 }
+#endif
 
 void Yaz0_Decompress(uintptr_t romStart, u8* dst, size_t size) {
     sYaz0CurRomStart = romStart;
     sYaz0CurSize = size;
+#if YAZ0_ASYNC_DMA
+    Yaz0_DecompressImpl(Yaz0_FirstDMA(), dst);
+    // The decoder doesn't need the padding at the end of the file, which may still be being read
+    Yaz0_WaitDMA();
+#else
     sYaz0DataBufferEnd = sYaz0DataBuffer + sizeof(sYaz0DataBuffer);
     Yaz0_DecompressImpl(Yaz0_FirstDMA(), dst);
+#endif
+}
+
+#if CHUNKED_YAZ0
+/**
+ * A chunked Yaz0 container holds the uncompressed data split into blocks of `blockSize` bytes (the last one may be
+ * shorter), each compressed independently as a regular Yaz0 file. The header is followed by `numBlocks + 1` offsets
+ * from the start of the container, the last one being the end of the last block.
+ * Since blocks don't reference each other, any range of the data can be loaded by decompressing only the blocks it
+ * overlaps, and the blocks can be compressed in parallel.
+ */
+typedef struct Yaz0ChunkedHeader {
+    /* 0x00 */ char magic[4]; // YAZC
+    /* 0x04 */ u32 decSize;
+    /* 0x08 */ u32 blockSize;
+    /* 0x0C */ u32 numBlocks;
+} Yaz0ChunkedHeader; // size = 0x10, followed by the block offsets
+
+#define YAZ0_CHUNKED_MAX_BLOCK_SIZE 0x2000
+
+// Blocks only partially covered by a request are decompressed here first, then copied to the destination.
+u64 sYaz0BlockBuffer[YAZ0_CHUNKED_MAX_BLOCK_SIZE / sizeof(u64)];
+// The header, then the offsets of each block, are DMAed here. Declared as u64 so that it is 8-byte aligned, as PI DMA
+// requires, with IDO too.
+u64 sYaz0ChunkedInfo[sizeof(Yaz0ChunkedHeader) / sizeof(u64)];
+
+/**
+ * Decompresses `size` bytes starting `offset` bytes into the uncompressed data of the chunked Yaz0 container at
+ * `romStart`.
+ */
+void Yaz0_DecompressChunked(uintptr_t romStart, u8* dst, size_t offset, size_t size) {
+    Yaz0ChunkedHeader* header = (Yaz0ChunkedHeader*)sYaz0ChunkedInfo;
+    u32* blockOffsets = (u32*)sYaz0ChunkedInfo;
+    size_t end = offset + size;
+    size_t decSize;
+    size_t blockSize;
+    u32 block;
+    u32 lastBlock;
+
+    DmaMgr_DmaRomToRam(romStart, header, sizeof(Yaz0ChunkedHeader));
+    decSize = header->decSize;
+    blockSize = header->blockSize;
+
+    if (blockSize > YAZ0_CHUNKED_MAX_BLOCK_SIZE) {
+        Fault_AddHungupAndCrash("../yaz0.c", __LINE__);
+    }
+
+    lastBlock = (end - 1) / blockSize;
+    for (block = offset / blockSize; block <= lastBlock; block++) {
+        size_t blockStart = block * blockSize;
+        size_t blockEnd = MIN(blockStart + blockSize, decSize);
+        size_t copyStart = MAX(offset, blockStart);
+        size_t copyEnd = MIN(end, blockEnd);
+
+#if DMA_PRIORITY_CLASSES
+        DmaMgr_RunPreemptingRequests();
+#endif
+
+        // Fetch the offsets of the start and end of this block
+        DmaMgr_DmaRomToRam(romStart + sizeof(Yaz0ChunkedHeader) + block * sizeof(u32), blockOffsets,
+                           2 * sizeof(u32));
+
+        if (copyStart == blockStart && copyEnd == blockEnd) {
+            // The whole block is requested, decompress it in place
+            Yaz0_Decompress(romStart + blockOffsets[0], dst + (blockStart - offset), blockOffsets[1] - blockOffsets[0]);
+        } else {
+            Yaz0_Decompress(romStart + blockOffsets[0], (u8*)sYaz0BlockBuffer, blockOffsets[1] - blockOffsets[0]);
+            bcopy((u8*)sYaz0BlockBuffer + (copyStart - blockStart), dst + (copyStart - offset), copyEnd - copyStart);
+        }
+    }
 }
+#endif
@@ -30,6 +30,9 @@
 #include "inflate.h"
 #endif
 #include "line_numbers.h"
+#if LZ4_COMPRESSION
+#include "lz4.h"
+#endif
 #if PLATFORM_N64
 #include "n64dd.h"
 #endif
@@ -57,7 +60,36 @@ size_t gDmaMgrDmaBuffSize = DMAMGR_DEFAULT_BUFSIZE;
 u32 sDmaMgrIsRomCompressed = false;
 
 OSThread sDmaMgrThread;
+#if DMA_PRIORITY_CLASSES
+// DmaMgr_RunPreemptingRequests processes requests for uncompressed files from the middle of a decompression, so a
+// second DmaMgr_ProcessRequest is nested in the first. Either one alone fits in the original 0x500 bytes, the extra
+// 0x100 is for the decompressor calling DmaMgr_RunPreemptingRequests. StackCheck_Check prints how much is used.
+STACK(sDmaMgrStack, 0x500 + 0x500 + 0x100);
+#else
 STACK(sDmaMgrStack, 0x500);
+#endif
+
+#if DMA_PRIORITY_CLASSES
+// Requests are queued here by class. Messages on sDmaMgrMsgQueue then only wake up the DMA manager thread.
+OSMesgQueue sDmaMgrPriorityQueues[DMA_PRIORITY_MAX];
+OSMesg sDmaMgrPriorityMsgBufs[DMA_PRIORITY_MAX][32];
+
+// Set while a file is being decompressed, when DmaMgr_RunPreemptingRequests may process other requests
+u32 sDmaMgrPreemptible = false;
+// A high priority request taken by DmaMgr_RunPreemptingRequests that needs decompressing, to process next
+DmaRequest* sDmaMgrDeferredRequest = NULL;
+
+#if DEBUG_FEATURES
+typedef struct DmaMgrQueueStats {
+    /* 0x00 */ u32 count;
+    /* 0x04 */ u32 preempted; // requests processed while another file was being decompressed
+    /* 0x08 */ u32 totalWait; // total time between queueing and processing, in osGetCount cycles
+    /* 0x0C */ u32 maxWait;
+} DmaMgrQueueStats; // size = 0x10
+
+DmaMgrQueueStats gDmaMgrQueueStats[DMA_PRIORITY_MAX];
+#endif
+#endif
 
 #if DEBUG_FEATURES
 
@@ -75,6 +107,151 @@ const char* sDmaMgrFileNames[] = {
 
 #endif
 
+#if DMA_TABLE_INDEX
+// Indices of the entries in gDmaDataTable
+#define DEFINE_DMA_ENTRY(name, _1) DMA_ENTRY_ID_##name,
+
+typedef enum DmaEntryId {
+#include "tables/dmadata_table.h"
+    DMA_ENTRY_ID_MAX
+} DmaEntryId;
+
+#undef DEFINE_DMA_ENTRY
+
+// The dmadata entries in VROM order, generated by mkdmadata from the spec. gDmaDataTable isn't always in VROM order,
+// so the index keeps the VROM start of each entry for the binary search and where the entry is in gDmaDataTable.
+#define DEFINE_DMA_INDEX_ENTRY(name) extern u8 _##name##SegmentRomStart[];
+
+#include "dmadata_index_spec.h"
+
+#undef DEFINE_DMA_INDEX_ENTRY
+
+#define DEFINE_DMA_INDEX_ENTRY(name) (uintptr_t)_##name##SegmentRomStart,
+
+uintptr_t sDmaMgrIndexVromStarts[] = {
+#include "dmadata_index_spec.h"
+};
+
+#undef DEFINE_DMA_INDEX_ENTRY
+
+#define DEFINE_DMA_INDEX_ENTRY(name) DMA_ENTRY_ID_##name,
+
+u16 sDmaMgrIndexEntries[] = {
+#include "dmadata_index_spec.h"
+};
+
+#undef DEFINE_DMA_INDEX_ENTRY
+
+// Position in the index of the entry found by the previous lookup
+s32 sDmaMgrLastIndexPos = 0;
+
+#if DEBUG_FEATURES
+typedef struct DmaMgrLookupStats {
+    /* 0x00 */ u32 lookups;
+    /* 0x04 */ u32 cacheHits;     // lookups for the same entry as the previous one
+    /* 0x08 */ u32 visited;       // entries compared against the address by DmaMgr_FindEntry
+    /* 0x0C */ u32 linearVisited; // entries the walk through gDmaDataTable would have compared for the same lookups
+} DmaMgrLookupStats;                // size = 0x10
+
+DmaMgrLookupStats gDmaMgrLookupStats;
+
+#define DMA_LOOKUP_STATS(stmt) stmt
+#else
+#define DMA_LOOKUP_STATS(stmt) (void)0
+#endif
+
+/**
+ * Finds the entry of the DMA data table containing the address `vrom`, by binary search over the index. The entry found
+ * by the previous lookup is checked first, as requests often come in series for the same file.
+ *
+ * @return the entry, or the end of gDmaDataTable if there is none
+ */
+DmaEntry* DmaMgr_FindEntry(uintptr_t vrom) {
+    DmaEntry* entry = &gDmaDataTable[sDmaMgrIndexEntries[sDmaMgrLastIndexPos]];
+    s32 lo;
+    s32 hi;
+    s32 mid;
+
+    DMA_LOOKUP_STATS(gDmaMgrLookupStats.lookups++);
+    DMA_LOOKUP_STATS(gDmaMgrLookupStats.visited++);
+
+    if (vrom >= entry->file.vromStart && vrom < entry->file.vromEnd) {
+        DMA_LOOKUP_STATS(gDmaMgrLookupStats.cacheHits++);
+        DMA_LOOKUP_STATS(gDmaMgrLookupStats.linearVisited += entry - gDmaDataTable + 1);
+        return entry;
+    }
+
+    // Count the entries starting at or before `vrom`. Empty entries come before the entry starting at the same address,
+    // so only the last of these can contain `vrom`.
+    lo = 0;
+    hi = ARRAY_COUNT(sDmaMgrIndexVromStarts);
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        DMA_LOOKUP_STATS(gDmaMgrLookupStats.visited++);
+
+        if (sDmaMgrIndexVromStarts[mid] <= vrom) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo != 0) {
+        entry = &gDmaDataTable[sDmaMgrIndexEntries[lo - 1]];
+
+        if (vrom < entry->file.vromEnd) {
+            sDmaMgrLastIndexPos = lo - 1;
+            DMA_LOOKUP_STATS(gDmaMgrLookupStats.linearVisited += entry - gDmaDataTable + 1);
+            return entry;
+        }
+    }
+
+    DMA_LOOKUP_STATS(gDmaMgrLookupStats.linearVisited += DMA_ENTRY_ID_MAX);
+    return &gDmaDataTable[DMA_ENTRY_ID_MAX];
+}
+#endif
+
+// Decompression time statistics, kept with LZ4 to compare the codecs, or on request to compare decoder versions
+#define DMAMGR_DECOMPRESS_STATS (DEBUG_FEATURES && (LZ4_COMPRESSION || DECOMPRESS_STATS))
+
+#if DMAMGR_DECOMPRESS_STATS
+typedef enum DmaMgrCodec {
+    DMAMGR_CODEC_DEFAULT, // Yaz0, or gzip on iQue
+    DMAMGR_CODEC_LZ4,
+    DMAMGR_CODEC_MAX
+} DmaMgrCodec;
+
+typedef struct DmaMgrDecompressStats {
+    /* 0x00 */ u32 count;
+    /* 0x04 */ u32 size;   // total uncompressed size
+    /* 0x08 */ OSTime time; // total decompression time, in osGetTime ticks
+} DmaMgrDecompressStats;
+
+// Decompression time per codec, to compare the codecs on the same files by building the ROM with either
+DmaMgrDecompressStats gDmaMgrDecompressStats[DMAMGR_CODEC_MAX];
+
+#if LZ4_COMPRESSION
+#define DMAMGR_ENTRY_CODEC(entry) (((entry)->romEnd & DMA_ENTRY_LZ4) ? DMAMGR_CODEC_LZ4 : DMAMGR_CODEC_DEFAULT)
+#else
+#define DMAMGR_ENTRY_CODEC(entry) DMAMGR_CODEC_DEFAULT
+#endif
+
+void DmaMgr_AddDecompressStats(DmaMgrCodec codec, const char* filename, size_t size, OSTime time) {
+    static const char* sCodecNames[] = { "default", "lz4" };
+    DmaMgrDecompressStats* stats = &gDmaMgrDecompressStats[codec];
+
+    stats->count++;
+    stats->size += size;
+    stats->time += time;
+
+    if (gDmaMgrVerbose != 0) {
+        PRINTF("decompress %s %s: %d bytes, %d ticks/KB (total %d files, %d ticks/KB, %d us)\n", sCodecNames[codec],
+               filename != NULL ? filename : "???", size, (u32)(time * 1024 / size), stats->count,
+               (u32)(stats->time * 1024 / stats->size), (u32)OS_CYCLES_TO_USEC(stats->time));
+    }
+}
+#endif
+
 #define SET_IOMSG(ioMsg, queue, rom, ram, buffSize) \
     do {                                            \
         (ioMsg).hdr.pri = OS_MESG_PRI_NORMAL;       \
@@ -240,6 +417,31 @@ s32 DmaMgr_AudioDmaHandler(OSPiHandle* pihandle, OSIoMesg* mb, s32 direction) {
     return ret;
 }
 
+#if YAZ0_ASYNC_DMA
+/**
+ * Starts a DMA read from ROM without waiting for it to complete. Unlike DmaMgr_DmaRomToRam the transfer isn't split,
+ * so it should be small.
+ *
+ * @param ioMsg IO message for the transfer, must stay valid until the transfer completes.
+ * @param queue Message queue receiving a message when the transfer completes.
+ * @param rom ROM address to read from.
+ * @param ram RAM address to write data to.
+ * @param size Size of transfer.
+ * @return the result of osEPiStartDma
+ */
+s32 DmaMgr_DmaRomToRamAsync(OSIoMesg* ioMsg, OSMesgQueue* queue, uintptr_t rom, void* ram, size_t size) {
+    osInvalDCache(ram, size);
+    SET_IOMSG(*ioMsg, queue, rom, ram, size);
+
+    if (gDmaMgrVerbose == 10) {
+        PRINTF("%10lld Async DMA %08x %08x %08x (%d)\n", OS_CYCLES_TO_USEC(osGetTime()), ioMsg->dramAddr,
+               ioMsg->devAddr, ioMsg->size, MQ_GET_COUNT(&gPiMgrCmdQueue));
+    }
+
+    return osEPiStartDma(gCartHandle, ioMsg, OS_READ);
+}
+#endif
+
 /**
  * DMA read from disk drive. Blocks the current thread until DMA completes.
  *
@@ -325,7 +527,14 @@ NORETURN void DmaMgr_Error(DmaRequest* req, const char* filename, const char* er
  * @return Pointer to associated filename
  */
 const char* DmaMgr_FindFileName(uintptr_t vrom) {
-#if DEBUG_FEATURES
+#if DEBUG_FEATURES && DMA_TABLE_INDEX
+    DmaEntry* entry = DmaMgr_FindEntry(vrom);
+
+    if (entry->file.vromEnd == 0) {
+        return NULL;
+    }
+    return sDmaMgrFileNames[entry - gDmaDataTable];
+#elif DEBUG_FEATURES
     DmaEntry* iter = gDmaDataTable;
     const char** name = sDmaMgrFileNames;
 
@@ -380,6 +589,9 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
     DmaEntry* iter;
     UNUSED_NDEBUG const char* filename;
     s32 i = 0;
+#if DMAMGR_DECOMPRESS_STATS
+    OSTime decompressStartTime;
+#endif
 
 #if DEBUG_FEATURES
     // Get the filename (for debugging)
@@ -390,7 +602,12 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
 #endif
 
     // Iterate through the DMA data table until the region containing the vrom address for this request is found
+#if DMA_TABLE_INDEX
+    // The index gives the region right away, or the end of the table if there is none
+    iter = DmaMgr_FindEntry(vrom);
+#else
     iter = gDmaDataTable;
+#endif
     while (iter->file.vromEnd != 0) {
         if (vrom >= iter->file.vromStart && vrom < iter->file.vromEnd) {
             // Found the region this request falls into
@@ -408,6 +625,32 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
                 }
             }
 
+#if CHUNKED_YAZ0 && !PLATFORM_IQUE
+            if (iter->romEnd & DMA_ENTRY_CHUNKED) {
+                // File is a chunked Yaz0 container. Its blocks are compressed independently, so like uncompressed
+                // files any part of it can be loaded.
+
+                if (iter->file.vromEnd < vrom + size) {
+                    DMA_ERROR(req, filename, "Segment Alignment Error",
+                              T("セグメント境界をまたがってＤＭＡ転送することはできません",
+                                "DMA transfers cannot cross segment boundaries"),
+                              "../z_std_dma.c", __LINE__);
+                }
+
+                osSetThreadPri(NULL, THREAD_PRI_DMAMGR_LOW);
+#if DMA_PRIORITY_CLASSES
+                sDmaMgrPreemptible = true;
+#endif
+                Yaz0_DecompressChunked(iter->romStart, ram, vrom - iter->file.vromStart, size);
+#if DMA_PRIORITY_CLASSES
+                sDmaMgrPreemptible = false;
+#endif
+                osSetThreadPri(NULL, THREAD_PRI_DMAMGR);
+                found = true;
+                break;
+            }
+#endif
+
             if (iter->romEnd == 0) {
                 // romEnd of 0 indicates that the file is uncompressed. Files that are stored uncompressed can have
                 // only part of their content loaded into RAM, so DMA only the requested region.
@@ -430,7 +673,11 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
             } else {
                 // File is compressed. Files that are stored compressed must be loaded into RAM all at once.
 
+#ifdef DMA_ENTRY_ROM_END_FLAGS
+                romSize = (iter->romEnd & ~DMA_ENTRY_ROM_END_FLAGS) - iter->romStart;
+#else
                 romSize = iter->romEnd - iter->romStart;
+#endif
                 romStart = iter->romStart;
 
                 if (iter->file.vromStart != vrom) {
@@ -454,13 +701,34 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
                 // Reduce the thread priority and decompress the file, the decompression routine handles the DMA
                 // in chunks. Restores the thread priority when done.
                 osSetThreadPri(NULL, THREAD_PRI_DMAMGR_LOW);
+#if DMA_PRIORITY_CLASSES
+                // More urgent requests for uncompressed data can be processed between the DMAs of the file
+                sDmaMgrPreemptible = true;
+#endif
 
+#if DMAMGR_DECOMPRESS_STATS
+                decompressStartTime = osGetTime();
+#endif
+#if LZ4_COMPRESSION
+                if (iter->romEnd & DMA_ENTRY_LZ4) {
+                    Lz4_Decompress(romStart, ram, romSize);
+                } else
+#endif
+                {
 #if !PLATFORM_IQUE
-                Yaz0_Decompress(romStart, ram, romSize);
+                    Yaz0_Decompress(romStart, ram, romSize);
 #else
-                gzip_decompress(romStart, ram, romSize);
+                    gzip_decompress(romStart, ram, romSize);
 #endif
+                }
 
+#if DMAMGR_DECOMPRESS_STATS
+                DmaMgr_AddDecompressStats(DMAMGR_ENTRY_CODEC(iter), filename, size, osGetTime() - decompressStartTime);
+#endif
+
+#if DMA_PRIORITY_CLASSES
+                sDmaMgrPreemptible = false;
+#endif
                 osSetThreadPri(NULL, THREAD_PRI_DMAMGR);
                 found = true;
 
@@ -504,6 +772,114 @@ void DmaMgr_ProcessRequest(DmaRequest* req) {
     }
 }
 
+#if DMA_PRIORITY_CLASSES
+#if DEBUG_FEATURES
+void DmaMgr_AddQueueStats(DmaRequest* req, s32 preempted) {
+    DmaMgrQueueStats* stats = &gDmaMgrQueueStats[req->priority];
+    u32 wait = osGetCount() - req->queuedTime;
+
+    stats->count++;
+    stats->preempted += preempted;
+    stats->totalWait += wait;
+    if (wait > stats->maxWait) {
+        stats->maxWait = wait;
+    }
+
+    if (gDmaMgrVerbose != 0) {
+        PRINTF("dma priority %d: waited %d us (total %d requests, %d preempting, average %d us, max %d us)\n",
+               req->priority, (u32)OS_CYCLES_TO_USEC(wait), stats->count, stats->preempted,
+               (u32)OS_CYCLES_TO_USEC(stats->totalWait / stats->count), (u32)OS_CYCLES_TO_USEC(stats->maxWait));
+    }
+}
+#endif
+
+/**
+ * Whether a request can be processed without decompressing anything, which is required to process it while another
+ * file is being decompressed.
+ */
+s32 DmaMgr_IsRequestUncompressed(DmaRequest* req) {
+#if DMA_TABLE_INDEX
+    DmaEntry* iter = DmaMgr_FindEntry(req->vromAddr);
+#else
+    DmaEntry* iter = gDmaDataTable;
+
+    while (iter->file.vromEnd != 0 && !(req->vromAddr >= iter->file.vromStart && req->vromAddr < iter->file.vromEnd)) {
+        iter++;
+    }
+#endif
+
+    // Requests outside of any file are either plain DMAs or errors
+    return iter->romEnd == 0;
+}
+
+/**
+ * Takes the next request to process, from the most urgent class with requests queued.
+ *
+ * @return the request, or NULL if all the queued requests have already been processed
+ */
+DmaRequest* DmaMgr_NextRequest(void) {
+    OSMesg msg;
+    s32 priority;
+
+    if (sDmaMgrDeferredRequest != NULL) {
+        DmaRequest* req = sDmaMgrDeferredRequest;
+
+        sDmaMgrDeferredRequest = NULL;
+        return req;
+    }
+
+    for (priority = 0; priority < DMA_PRIORITY_MAX; priority++) {
+        if (osRecvMesg(&sDmaMgrPriorityQueues[priority], &msg, OS_MESG_NOBLOCK) == 0) {
+#if DEBUG_FEATURES
+            DmaMgr_AddQueueStats((DmaRequest*)msg, false);
+#endif
+            return (DmaRequest*)msg;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Called between the DMAs of a file being decompressed, processes the high priority requests that are queued as long
+ * as they don't need decompressing too. The first one that does is kept to be processed right after the current file.
+ */
+void DmaMgr_RunPreemptingRequests(void) {
+    OSMesg msg;
+    DmaRequest* req;
+
+    if (!sDmaMgrPreemptible) {
+        return;
+    }
+
+    // The decompression state can't be saved, so nothing else is decompressed until the current file is done
+    sDmaMgrPreemptible = false;
+
+    while (sDmaMgrDeferredRequest == NULL &&
+           osRecvMesg(&sDmaMgrPriorityQueues[DMA_PRIORITY_HIGH], &msg, OS_MESG_NOBLOCK) == 0) {
+        req = (DmaRequest*)msg;
+
+#if DEBUG_FEATURES
+        DmaMgr_AddQueueStats(req, true);
+#endif
+
+        if (!DmaMgr_IsRequestUncompressed(req)) {
+            sDmaMgrDeferredRequest = req;
+            break;
+        }
+
+        osSetThreadPri(NULL, THREAD_PRI_DMAMGR);
+        DmaMgr_ProcessRequest(req);
+        osSetThreadPri(NULL, THREAD_PRI_DMAMGR_LOW);
+
+        if (req->notifyQueue != NULL) {
+            osSendMesg(req->notifyQueue, req->notifyMsg, OS_MESG_NOBLOCK);
+        }
+    }
+
+    sDmaMgrPreemptible = true;
+}
+#endif
+
 void DmaMgr_ThreadEntry(void* arg) {
     OSMesg msg;
     DmaRequest* req;
@@ -513,10 +889,23 @@ void DmaMgr_ThreadEntry(void* arg) {
     while (true) {
         // Wait for DMA Requests to arrive from other threads
         osRecvMesg(&sDmaMgrMsgQueue, &msg, OS_MESG_BLOCK);
+#if DMA_PRIORITY_CLASSES
+        if (msg == NULL) {
+            break;
+        }
+
+        // Each request queued sends a message, but requests may have been processed early by
+        // DmaMgr_RunPreemptingRequests, or in a different order than their messages
+        req = DmaMgr_NextRequest();
+        if (req == NULL) {
+            continue;
+        }
+#else
         req = (DmaRequest*)msg;
         if (req == NULL) {
             break;
         }
+#endif
 
         if (0) {
             PRINTF(T("ＤＭＡ登録受付 dmap=%08x\n", "DMA registration acceptance dmap=%08x\n"), req);
@@ -548,10 +937,16 @@ void DmaMgr_ThreadEntry(void* arg) {
  * @param size Transfer size.
  * @param queue Message queue to notify with `msg` once the transfer is complete.
  * @param msg Message to send to `queue` once the transfer is complete.
+ * @param priority (DMA_PRIORITY_CLASSES only) Class of the request, see DmaPriority.
  * @return 0
  */
+#if DMA_PRIORITY_CLASSES
+s32 DmaMgr_RequestAsyncPriority(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk, OSMesgQueue* queue,
+                                OSMesg msg, DmaPriority priority) {
+#else
 s32 DmaMgr_RequestAsync(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk, OSMesgQueue* queue,
                         OSMesg msg) {
+#endif
     static s32 sDmaMgrQueueFullLogged = 0;
 
 #if PLATFORM_IQUE
@@ -581,6 +976,10 @@ s32 DmaMgr_RequestAsync(DmaRequest* req, void* ram, uintptr_t vrom, size_t size,
     req->unk_14 = 0;
     req->notifyQueue = queue;
     req->notifyMsg = msg;
+#if DMA_PRIORITY_CLASSES
+    req->priority = priority;
+    req->queuedTime = osGetCount();
+#endif
 
 #if DEBUG_FEATURES
     if (1 && (sDmaMgrQueueFullLogged == 0) && MQ_IS_FULL(&sDmaMgrMsgQueue)) {
@@ -595,10 +994,25 @@ s32 DmaMgr_RequestAsync(DmaRequest* req, void* ram, uintptr_t vrom, size_t size,
     }
 #endif
 
+#if DMA_PRIORITY_CLASSES
+    osSendMesg(&sDmaMgrPriorityQueues[priority], (OSMesg)req, OS_MESG_BLOCK);
+#endif
     osSendMesg(&sDmaMgrMsgQueue, (OSMesg)req, OS_MESG_BLOCK);
     return 0;
 }
 
+#if DMA_PRIORITY_CLASSES
+/**
+ * Submit an asynchronous DMA request with the normal priority.
+ *
+ * @see DmaMgr_RequestAsyncPriority
+ */
+s32 DmaMgr_RequestAsync(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, u32 unk, OSMesgQueue* queue,
+                        OSMesg msg) {
+    return DmaMgr_RequestAsyncPriority(req, ram, vrom, size, unk, queue, msg, DMA_PRIORITY_NORMAL);
+}
+#endif
+
 /**
  * Submit a synchronous DMA request. This will block the current thread until the requested transfer is complete. Data
  * is immediately available as soon as this function returns.
@@ -615,7 +1029,12 @@ s32 DmaMgr_RequestSync(void* ram, uintptr_t vrom, size_t size) {
     s32 ret;
 
     osCreateMesgQueue(&queue, &msg, 1);
+#if DMA_PRIORITY_CLASSES
+    // The calling thread is blocked until the request is done
+    ret = DmaMgr_RequestAsyncPriority(&req, ram, vrom, size, 0, &queue, NULL, DMA_PRIORITY_HIGH);
+#else
     ret = DmaMgr_RequestAsync(&req, ram, vrom, size, 0, &queue, NULL);
+#endif
     if (ret == -1) { // DmaMgr_RequestAsync only returns 0
         return ret;
     }
@@ -624,6 +1043,26 @@ s32 DmaMgr_RequestSync(void* ram, uintptr_t vrom, size_t size) {
     return 0;
 }
 
+#if ROOM_PREFETCH
+/**
+ * Submit an asynchronous DMA request for data that may be needed soon. With DMA_PRIORITY_CLASSES, it is processed
+ * after every other request.
+ *
+ * @see DmaMgr_RequestAsync
+ */
+s32 DmaMgr_RequestPrefetch(DmaRequest* req, void* ram, uintptr_t vrom, size_t size, OSMesgQueue* queue, OSMesg msg) {
+#if DEBUG_FEATURES
+    req->filename = "prefetch";
+    req->line = 0;
+#endif
+#if DMA_PRIORITY_CLASSES
+    return DmaMgr_RequestAsyncPriority(req, ram, vrom, size, 0, queue, msg, DMA_PRIORITY_LOW);
+#else
+    return DmaMgr_RequestAsync(req, ram, vrom, size, 0, queue, msg);
+#endif
+}
+#endif
+
 void DmaMgr_Init(void) {
     const char** name;
     s32 idx;
@@ -671,6 +1110,12 @@ void DmaMgr_Init(void) {
 
     // Start the DMA manager
     osCreateMesgQueue(&sDmaMgrMsgQueue, sDmaMgrMsgBuf, ARRAY_COUNT(sDmaMgrMsgBuf));
+#if DMA_PRIORITY_CLASSES
+    for (idx = 0; idx < DMA_PRIORITY_MAX; idx++) {
+        osCreateMesgQueue(&sDmaMgrPriorityQueues[idx], sDmaMgrPriorityMsgBufs[idx],
+                          ARRAY_COUNT(sDmaMgrPriorityMsgBufs[idx]));
+    }
+#endif
     StackCheck_Init(&sDmaMgrStackInfo, sDmaMgrStack, STACK_TOP(sDmaMgrStack), 0, 0x100, "dmamgr");
     osCreateThread(&sDmaMgrThread, THREAD_ID_DMAMGR, DmaMgr_ThreadEntry, NULL, STACK_TOP(sDmaMgrStack),
                    THREAD_PRI_DMAMGR);
@@ -705,7 +1150,12 @@ s32 DmaMgr_RequestSyncDebug(void* ram, uintptr_t vrom, size_t size, const char*
     req.filename = file;
     req.line = line;
     osCreateMesgQueue(&queue, &msg, 1);
+#if DMA_PRIORITY_CLASSES
+    // The calling thread is blocked until the request is done
+    ret = DmaMgr_RequestAsyncPriority(&req, ram, vrom, size, 0, &queue, NULL, DMA_PRIORITY_HIGH);
+#else
     ret = DmaMgr_RequestAsync(&req, ram, vrom, size, 0, &queue, NULL);
+#endif
     if (ret == -1) { // DmaMgr_RequestAsync only returns 0
         return ret;
     }
@@ -8,10 +8,22 @@
  * end, this implementation does not support any individual deallocations; the only provided way to deallocate anything
  * is to reset the entire arena, deallocating everything. This scheme is most applicable to allocating similar data
  * with identical lifetime.
+ *
+ * With THA_SCRATCH, either end can also be rewound to a position saved earlier with THA_MarkHead or THA_MarkTail,
+ * deallocating everything allocated at that end since. This allows temporary allocations within a frame that are
+ * released in the reverse order they were made.
  */
 #include "tha.h"
 #include "alignment.h"
 
+#if THA_SCRATCH && DEBUG_FEATURES
+#include "printf.h"
+#include "terminal.h"
+
+// Released regions are filled with this, so that uses after release stand out
+#define THA_RELEASED_MAGIC 0xEF
+#endif
+
 void* THA_GetHead(TwoHeadArena* tha) {
     return tha->head;
 }
@@ -134,3 +146,73 @@ void THA_Init(TwoHeadArena* tha, void* start, size_t size) {
 void THA_Destroy(TwoHeadArena* tha) {
     bzero(tha, sizeof(TwoHeadArena));
 }
+
+#if THA_SCRATCH
+/**
+ * @return the position to pass to THA_ReleaseHead to deallocate everything allocated to the head from now on
+ */
+void* THA_MarkHead(TwoHeadArena* tha) {
+    return tha->head;
+}
+
+/**
+ * @return the position to pass to THA_ReleaseTail to deallocate everything allocated to the tail from now on
+ */
+void* THA_MarkTail(TwoHeadArena* tha) {
+    return tha->tail;
+}
+
+/**
+ * Moves the head back to `mark`, deallocating everything allocated to the head since the mark was made. Marks made
+ * after `mark` are released with it.
+ *
+ * In debug builds, the released region is filled with THA_RELEASED_MAGIC, and the allocations since the mark are
+ * checked not to have run into the tail.
+ */
+void THA_ReleaseHead(TwoHeadArena* tha, void* mark) {
+#if DEBUG_FEATURES
+    if ((u8*)mark < (u8*)tha->start || (u8*)mark > (u8*)tha->head) {
+        PRINTF(VT_COL(RED, WHITE) "THA_ReleaseHead: mark %08x is not between %08x and the head %08x\n" VT_RST, mark,
+               tha->start, tha->head);
+        return;
+    }
+    if (THA_IsCrash(tha)) {
+        PRINTF(VT_COL(RED, WHITE) "THA_ReleaseHead: head %08x ran into the tail %08x\n" VT_RST, tha->head, tha->tail);
+        if ((u8*)tha->tail > (u8*)mark) {
+            memset(mark, THA_RELEASED_MAGIC, (u8*)tha->tail - (u8*)mark);
+        }
+    } else {
+        memset(mark, THA_RELEASED_MAGIC, (u8*)tha->head - (u8*)mark);
+    }
+#endif
+
+    tha->head = mark;
+}
+
+/**
+ * Moves the tail back to `mark`, deallocating everything allocated to the tail since the mark was made. Marks made
+ * after `mark` are released with it.
+ *
+ * In debug builds, the released region is filled with THA_RELEASED_MAGIC, and the allocations since the mark are
+ * checked not to have run into the head.
+ */
+void THA_ReleaseTail(TwoHeadArena* tha, void* mark) {
+#if DEBUG_FEATURES
+    if ((u8*)mark > (u8*)tha->start + tha->size || (u8*)mark < (u8*)tha->tail) {
+        PRINTF(VT_COL(RED, WHITE) "THA_ReleaseTail: mark %08x is not between the tail %08x and %08x\n" VT_RST, mark,
+               tha->tail, (u8*)tha->start + tha->size);
+        return;
+    }
+    if (THA_IsCrash(tha)) {
+        PRINTF(VT_COL(RED, WHITE) "THA_ReleaseTail: tail %08x ran into the head %08x\n" VT_RST, tha->tail, tha->head);
+        if ((u8*)mark > (u8*)tha->head) {
+            memset(tha->head, THA_RELEASED_MAGIC, (u8*)mark - (u8*)tha->head);
+        }
+    } else {
+        memset(tha->tail, THA_RELEASED_MAGIC, (u8*)mark - (u8*)tha->tail);
+    }
+#endif
+
+    tha->tail = mark;
+}
+#endif
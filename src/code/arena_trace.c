@@ -0,0 +1,81 @@
+/**
+ * @file arena_trace.c
+ *
+ * Records the allocations and frees of the system arena and the Zelda arena in a ring buffer, in debug builds with
+ * ARENA_TRACE. The buffer is printed with ArenaTrace_Dump, which goes to the IS-Viewer like other debug output, and the
+ * printed trace can be replayed on the host with tools/arena_replay to tell allocator behavior apart from the game's
+ * allocation pattern.
+ *
+ * Each record is printed on its own line:
+ *     ARENATRACE arena op frame size ptr oldPtr line file
+ * with the values of ArenaTraceRecord, `file` being the rest of the line. The records are preceded by the size of each
+ * arena at its last initialization, so that the replay knows how large an arena to simulate even if the ring buffer no
+ * longer holds the initialization record:
+ *     ARENATRACE_ARENA arena start size
+ */
+#include "arena_trace.h"
+
+#include "printf.h"
+
+#if ARENA_TRACE_ENABLED
+
+// Number of records kept, older ones are overwritten
+#define ARENA_TRACE_RECORD_COUNT 0x1000
+
+ArenaTraceRecord sArenaTraceRecords[ARENA_TRACE_RECORD_COUNT];
+u32 sArenaTraceCount; // Total number of records, the ring buffer holds the last ARENA_TRACE_RECORD_COUNT
+u32 sArenaTraceFrame;
+void* sArenaTraceArenaStarts[ARENA_TRACE_MAX];
+u32 sArenaTraceArenaSizes[ARENA_TRACE_MAX];
+
+void ArenaTrace_Record(s32 arena, s32 op, void* ptr, void* oldPtr, u32 size, const char* file, int line) {
+    // Allocations may happen on any thread
+    OSIntMask prevMask = osSetIntMask(OS_IM_NONE);
+    ArenaTraceRecord* record = &sArenaTraceRecords[sArenaTraceCount % ARENA_TRACE_RECORD_COUNT];
+
+    record->arena = arena;
+    record->op = op;
+    record->line = line;
+    record->frame = sArenaTraceFrame;
+    record->size = size;
+    record->ptr = ptr;
+    record->oldPtr = oldPtr;
+    record->file = file;
+    sArenaTraceCount++;
+
+    if (op == ARENA_TRACE_OP_INIT) {
+        sArenaTraceArenaStarts[arena] = ptr;
+        sArenaTraceArenaSizes[arena] = size;
+    }
+
+    osSetIntMask(prevMask);
+}
+
+/**
+ * Called once per frame by Graph_Update.
+ */
+void ArenaTrace_NextFrame(void) {
+    sArenaTraceFrame++;
+}
+
+void ArenaTrace_Dump(void) {
+    ArenaTraceRecord* record;
+    u32 first;
+    u32 i;
+
+    first = (sArenaTraceCount > ARENA_TRACE_RECORD_COUNT) ? (sArenaTraceCount - ARENA_TRACE_RECORD_COUNT) : 0;
+
+    PRINTF("ARENATRACE_BEGIN %u %u\n", sArenaTraceCount - first, first);
+    for (i = 0; i < ARENA_TRACE_MAX; i++) {
+        PRINTF("ARENATRACE_ARENA %u %08x %u\n", i, sArenaTraceArenaStarts[i], sArenaTraceArenaSizes[i]);
+    }
+
+    for (i = first; i < sArenaTraceCount; i++) {
+        record = &sArenaTraceRecords[i % ARENA_TRACE_RECORD_COUNT];
+        PRINTF("ARENATRACE %u %u %u %u %08x %08x %u %s\n", record->arena, record->op, record->frame, record->size,
+               record->ptr, record->oldPtr, record->line, (record->file != NULL) ? record->file : "-");
+    }
+    PRINTF("ARENATRACE_END\n");
+}
+
+#endif
@@ -1,6 +1,7 @@
 #include "libc64/malloc.h"
 #include "libc64/sprintf.h"
 #include "libu64/debug.h"
+#include "arena_trace.h"
 #include "array_count.h"
 #include "buffers.h"
 #include "console_logo_state.h"
@@ -126,11 +127,154 @@ void Graph_UCodeFaultClient(Gfx* workBuf) {
 }
 #endif
 
+#if GFX_POOL_ADAPTIVE
+// Number of frames in a window. The high-water mark of a buffer is the most it used in a frame in the current and the
+// previous window, so a buffer shrinks one to two windows after its usage drops.
+#define GFXPOOL_WINDOW_FRAMES 60
+
+// Smallest size given to a display buffer, in bytes
+#define GFXPOOL_MIN_SIZE 0x1000
+
+// Sizes of the display buffers without GFX_POOL_ADAPTIVE. The space left after giving each buffer its high-water mark
+// is split between them in these proportions.
+u32 sGfxPoolDefaultSizes[GFXPOOL_WORK] = {
+    0x17E0 * sizeof(Gfx),
+    0x800 * sizeof(Gfx),
+    0x400 * sizeof(Gfx),
+};
+
+GfxPoolStats gGfxPoolStats;
+
+/**
+ * Splits dispBuffer between the POLY_OPA, POLY_XLU and OVERLAY buffers for the frame about to be built. Each buffer
+ * gets its high-water mark plus a quarter, and what is left is split like the default sizes. If the high-water marks
+ * don't fit together, the space is split in proportion to them.
+ */
+void Graph_BalanceGfxPool(void) {
+    GfxPoolStats* stats = &gGfxPoolStats;
+    // Sizes are computed in units of 0x10 bytes, which keeps the buffers aligned and the products below from overflowing
+    u32 total = sizeof(gGfxPools[0].dispBuffer) / 0x10;
+    u32 want[GFXPOOL_WORK];
+    u32 wantTotal = 0;
+    u32 left = total;
+    s32 i;
+
+    for (i = 0; i < GFXPOOL_WORK; i++) {
+        want[i] = (stats->highWater[i] + stats->highWater[i] / 4 + 0xF) / 0x10;
+        if (want[i] < GFXPOOL_MIN_SIZE / 0x10) {
+            want[i] = GFXPOOL_MIN_SIZE / 0x10;
+        }
+        wantTotal += want[i];
+    }
+
+    for (i = 0; i < GFXPOOL_WORK; i++) {
+        u32 size;
+
+        if (i == GFXPOOL_WORK - 1) {
+            size = left;
+        } else if (wantTotal <= total) {
+            size = want[i] + (total - wantTotal) * (sGfxPoolDefaultSizes[i] / 0x10) / total;
+        } else {
+            size = total * want[i] / wantTotal;
+        }
+        left -= size;
+        stats->size[i] = size * 0x10;
+    }
+    stats->size[GFXPOOL_WORK] = sizeof(gGfxPools[0].workBuffer);
+}
+
+/**
+ * Records how much of each buffer the frame just built used. Called at the end of the frame, the buffers only grow
+ * within a frame so this is their peak usage.
+ */
+void Graph_RecordGfxPoolUsage(GraphicsContext* gfxCtx) {
+    GfxPoolStats* stats = &gGfxPoolStats;
+    TwoHeadGfxArena* thgas[GFXPOOL_MAX];
+    s32 i;
+
+    thgas[GFXPOOL_POLY_OPA] = &gfxCtx->polyOpa;
+    thgas[GFXPOOL_POLY_XLU] = &gfxCtx->polyXlu;
+    thgas[GFXPOOL_OVERLAY] = &gfxCtx->overlay;
+    thgas[GFXPOOL_WORK] = &gfxCtx->work;
+
+    for (i = 0; i < GFXPOOL_MAX; i++) {
+        // Larger than the buffer if it overflowed, which is how much it would have needed
+        u32 used = thgas[i]->size - THGA_GetRemaining(thgas[i]);
+
+        if (THGA_IsCrash(thgas[i])) {
+            stats->overflows[i]++;
+        }
+        if (used > stats->windowMax[i]) {
+            stats->windowMax[i] = used;
+        }
+        if (used > stats->highWater[i]) {
+            stats->highWater[i] = used;
+        }
+        if (used > stats->peak[i]) {
+            stats->peak[i] = used;
+        }
+    }
+
+    stats->frames++;
+    stats->windowFrames++;
+    if (stats->windowFrames >= GFXPOOL_WINDOW_FRAMES) {
+        stats->windowFrames = 0;
+        for (i = 0; i < GFXPOOL_MAX; i++) {
+            // From now on the high-water mark covers the window just finished and the new one
+            stats->highWater[i] = stats->windowMax[i];
+            stats->windowMax[i] = 0;
+        }
+    }
+}
+
+/**
+ * Resets the peak usage and overflow counts reported by Graph_PrintGfxPoolStats. The high-water marks the buffers are
+ * sized by are kept.
+ */
+void Graph_ResetGfxPoolStats(void) {
+    s32 i;
+
+    for (i = 0; i < GFXPOOL_MAX; i++) {
+        gGfxPoolStats.peak[i] = 0;
+        gGfxPoolStats.overflows[i] = 0;
+    }
+    gGfxPoolStats.frames = 0;
+}
+
+/**
+ * Prints the usage of each buffer since the last reset, one line per buffer starting with "GFXPOOL".
+ */
+void Graph_PrintGfxPoolStats(s32 sceneId) {
+    static const char* sBufferNames[GFXPOOL_MAX] = { "POLY_OPA", "POLY_XLU", "OVERLAY", "WORK" };
+    s32 i;
+
+    PRINTF("GFXPOOL scene %d frames %d\n", sceneId, gGfxPoolStats.frames);
+    for (i = 0; i < GFXPOOL_MAX; i++) {
+        PRINTF("GFXPOOL %-8s size %6d high water %6d peak %6d overflows %d\n", sBufferNames[i], gGfxPoolStats.size[i],
+               gGfxPoolStats.highWater[i], gGfxPoolStats.peak[i], gGfxPoolStats.overflows[i]);
+    }
+}
+#endif
+
 void Graph_InitTHGA(GraphicsContext* gfxCtx) {
     GfxPool* pool = &gGfxPools[gfxCtx->gfxPoolIdx & 1];
 
     pool->headMagic = GFXPOOL_HEAD_MAGIC;
     pool->tailMagic = GFXPOOL_TAIL_MAGIC;
+
+#if GFX_POOL_ADAPTIVE
+    Graph_BalanceGfxPool();
+
+    gfxCtx->polyOpaBuffer = pool->dispBuffer;
+    gfxCtx->polyXluBuffer = (Gfx*)((u8*)gfxCtx->polyOpaBuffer + gGfxPoolStats.size[GFXPOOL_POLY_OPA]);
+    gfxCtx->overlayBuffer = (Gfx*)((u8*)gfxCtx->polyXluBuffer + gGfxPoolStats.size[GFXPOOL_POLY_XLU]);
+    gfxCtx->workBuffer = pool->workBuffer;
+
+    THGA_Init(&gfxCtx->polyOpa, gfxCtx->polyOpaBuffer, gGfxPoolStats.size[GFXPOOL_POLY_OPA]);
+    THGA_Init(&gfxCtx->polyXlu, gfxCtx->polyXluBuffer, gGfxPoolStats.size[GFXPOOL_POLY_XLU]);
+    THGA_Init(&gfxCtx->overlay, gfxCtx->overlayBuffer, gGfxPoolStats.size[GFXPOOL_OVERLAY]);
+    THGA_Init(&gfxCtx->work, gfxCtx->workBuffer, sizeof(pool->workBuffer));
+#else
     THGA_Init(&gfxCtx->polyOpa, pool->polyOpaBuffer, sizeof(pool->polyOpaBuffer));
     THGA_Init(&gfxCtx->polyXlu, pool->polyXluBuffer, sizeof(pool->polyXluBuffer));
     THGA_Init(&gfxCtx->overlay, pool->overlayBuffer, sizeof(pool->overlayBuffer));
@@ -140,6 +284,7 @@ void Graph_InitTHGA(GraphicsContext* gfxCtx) {
     gfxCtx->polyXluBuffer = pool->polyXluBuffer;
     gfxCtx->overlayBuffer = pool->overlayBuffer;
     gfxCtx->workBuffer = pool->workBuffer;
+#endif
 
     gfxCtx->curFrameBuffer = SysCfb_GetFbPtr(gfxCtx->fbIdx % 2);
     gfxCtx->unk_014 = 0;
@@ -417,6 +562,10 @@ void Graph_Update(GraphicsContext* gfxCtx, GameState* gameState) {
         }
     }
 
+#if GFX_POOL_ADAPTIVE
+    Graph_RecordGfxPoolUsage(gfxCtx);
+#endif
+
     if (THGA_IsCrash(&gfxCtx->polyOpa)) {
         problem = true;
         PRINTF("%c", BEL);
@@ -442,6 +591,10 @@ void Graph_Update(GraphicsContext* gfxCtx, GameState* gameState) {
         gfxCtx->fbIdx++;
     }
 
+#if ARENA_TRACE_ENABLED
+    ArenaTrace_NextFrame();
+#endif
+
     Audio_Update();
 
     {
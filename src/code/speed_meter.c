@@ -9,6 +9,7 @@
 #include "speed_meter.h"
 #include "terminal.h"
 #include "zelda_arena.h"
+#include "zelda_pool.h"
 #include "game.h"
 #include "view.h"
 
@@ -249,6 +250,26 @@ void SpeedMeter_DrawAllocEntries(SpeedMeter* meter, GraphicsContext* gfxCtx, Gam
             y++;
             y++;
         }
+
+#if ZELDA_POOLS
+        {
+            s32 i;
+
+            // One line per pool, showing how many of its blocks are in use
+            for (i = 0; i < ZeldaPool_GetCount(); i++) {
+                u32 blockSize;
+                u32 count;
+                u32 used;
+                u32 peak;
+
+                ZeldaPool_GetUsage(i, &blockSize, &count, &used, &peak);
+                SpeedMeter_InitAllocEntry(&entry, count, used, GPACK_RGBA5551(0, 0, 255, 1),
+                                          GPACK_RGBA5551(0, 255, 255, 1), ulx, lrx, y, y);
+                SpeedMeter_DrawAllocEntry(&entry, gfxCtx);
+                y++;
+            }
+        }
+#endif
     }
 
     if (R_ENABLE_ARENA_DBG > 1) {
@@ -282,4 +303,25 @@ void SpeedMeter_DrawAllocEntries(SpeedMeter* meter, GraphicsContext* gfxCtx, Gam
                               GPACK_RGBA5551(255, 0, 0, 1), ulx, lrx, y, y);
     SpeedMeter_DrawAllocEntry(&entry, gfxCtx);
     y++;
+
+#if GFX_POOL_ADAPTIVE
+    // The high-water marks the display buffers are sized by, out of the space they share
+    {
+        static u16 sGfxPoolColors[GFXPOOL_WORK] = {
+            GPACK_RGBA5551(255, 0, 255, 1),
+            GPACK_RGBA5551(255, 255, 0, 1),
+            GPACK_RGBA5551(255, 0, 0, 1),
+        };
+        u32 total = gGfxPoolStats.size[GFXPOOL_POLY_OPA] + gGfxPoolStats.size[GFXPOOL_POLY_XLU] +
+                    gGfxPoolStats.size[GFXPOOL_OVERLAY];
+        s32 i;
+
+        for (i = 0; i < GFXPOOL_WORK; i++) {
+            SpeedMeter_InitAllocEntry(&entry, total, gGfxPoolStats.highWater[i], GPACK_RGBA5551(0, 0, 255, 1),
+                                      sGfxPoolColors[i], ulx, lrx, y, y);
+            SpeedMeter_DrawAllocEntry(&entry, gfxCtx);
+            y++;
+        }
+    }
+#endif
 }
@@ -1,5 +1,6 @@
 #include "libc64/math64.h"
 #include "libu64/overlay.h"
+#include "alignment.h"
 #include "array_count.h"
 #include "fault.h"
 #include "gfx.h"
@@ -19,6 +20,7 @@
 #include "z_actor_dlftbls.h"
 #include "z_lib.h"
 #include "zelda_arena.h"
+#include "zelda_pool.h"
 #include "actor.h"
 #include "audio.h"
 #include "effect.h"
@@ -933,7 +935,15 @@ void Actor_SetObjectDependency(PlayState* play, Actor* actor) {
     gSegments[6] = OS_K0_TO_PHYSICAL(play->objectCtx.slots[actor->objectSlot].segment);
 }
 
+#if ACTOR_UPDATE_LOD
+// Spreads the updates of throttled actors over the frames, see `Actor_ThrottleUpdate`
+u8 sUpdateLodStagger;
+#endif
+
 void Actor_Init(Actor* actor, PlayState* play) {
+#if ACTOR_UPDATE_LOD
+    actor->updateLodTimer = sUpdateLodStagger++;
+#endif
     Actor_SetWorldToHome(actor);
     Actor_SetShapeRotToWorld(actor);
     Actor_SetFocus(actor, 0.0f);
@@ -2387,6 +2397,94 @@ u32 sCategoryFreezeMasks[ACTORCAT_MAX] = {
     PLAYER_STATE1_TALKING | PLAYER_STATE1_DEAD | PLAYER_STATE1_28,
 };
 
+#if ACTOR_UPDATE_LOD
+typedef struct ActorUpdateLod {
+    /* 0x0 */ f32 distance; // Throttled beyond this distance from Player
+    /* 0x4 */ u8 interval; // Throttled actors update once every `interval` frames, 1 to never throttle
+} ActorUpdateLod; // size = 0x8
+
+// Only for actors with ACTOR_FLAG_UPDATE_LOD
+ActorUpdateLod sCategoryUpdateLods[ACTORCAT_MAX] = {
+    { 0.0f, 1 },    // ACTORCAT_SWITCH
+    { 0.0f, 1 },    // ACTORCAT_BG
+    { 0.0f, 1 },    // ACTORCAT_PLAYER
+    { 0.0f, 1 },    // ACTORCAT_EXPLOSIVE
+    { 800.0f, 4 },  // ACTORCAT_NPC
+    { 1500.0f, 2 }, // ACTORCAT_ENEMY
+    { 800.0f, 4 },  // ACTORCAT_PROP
+    { 0.0f, 1 },    // ACTORCAT_ITEMACTION
+    { 800.0f, 4 },  // ACTORCAT_MISC
+    { 0.0f, 1 },    // ACTORCAT_BOSS
+    { 0.0f, 1 },    // ACTORCAT_DOOR
+    { 0.0f, 1 },    // ACTORCAT_CHEST
+};
+
+#if DEBUG_FEATURES
+typedef struct ActorUpdateLodStats {
+    /* 0x00 */ u32 frames;
+    /* 0x04 */ u32 skipped;
+    /* 0x08 */ u32 updates; // Updates of actors with ACTOR_FLAG_UPDATE_LOD that ran
+    /* 0x10 */ OSTime updateTime; // Time these updates took
+} ActorUpdateLodStats; // size = 0x18
+
+ActorUpdateLodStats sUpdateLodStats;
+
+void Actor_UpdateTimed(Actor* actor, PlayState* play) {
+    OSTime startTime = osGetTime();
+
+    actor->update(actor, play);
+    sUpdateLodStats.updateTime += osGetTime() - startTime;
+    sUpdateLodStats.updates++;
+}
+
+/**
+ * Prints how many updates were skipped per frame, and an estimate of the time that saved from how long the updates of
+ * the same actors took, since the last call.
+ */
+void Actor_DisplayUpdateLodStats(void) {
+    ActorUpdateLodStats* stats = &sUpdateLodStats;
+    u32 updateUs;
+
+    if ((stats->frames != 0) && (stats->updates != 0)) {
+        updateUs = OS_CYCLES_TO_USEC(stats->updateTime) / stats->updates;
+        PRINTF("actor update lod: %d.%02d updates skipped per frame, %d us per update, %d us saved per frame\n",
+               stats->skipped / stats->frames, stats->skipped * 100 / stats->frames % 100, updateUs,
+               stats->skipped * updateUs / stats->frames);
+    }
+    bzero(stats, sizeof(ActorUpdateLodStats));
+}
+#endif
+
+/**
+ * Returns true if the update of an actor with ACTOR_FLAG_UPDATE_LOD is skipped this frame, as it is outside its culling
+ * volume and further from Player than its category's threshold in `sCategoryUpdateLods`.
+ */
+s32 Actor_ThrottleUpdate(Actor* actor, Player* player) {
+    ActorUpdateLod* lod = &sCategoryUpdateLods[actor->category];
+
+    if (!(actor->flags & ACTOR_FLAG_UPDATE_LOD) || (actor->flags & ACTOR_FLAG_INSIDE_CULLING_VOLUME) ||
+        (lod->interval <= 1) || (actor->xyzDistToPlayerSq <= SQ(lod->distance)) || (actor == player->focusActor)) {
+        return false;
+    }
+
+    // Staggered when spawned, or left from another category
+    if (actor->updateLodTimer >= lod->interval) {
+        actor->updateLodTimer %= lod->interval;
+    }
+
+    if (actor->updateLodTimer != 0) {
+        actor->updateLodTimer--;
+#if DEBUG_FEATURES
+        sUpdateLodStats.skipped++;
+#endif
+        return true;
+    }
+
+    actor->updateLodTimer = lod->interval - 1;
+    return false;
+}
+#endif
+
 void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
     s32 i;
     Actor* actor;
@@ -2429,6 +2527,12 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
         Actor_Spawn(&play->actorCtx, play, ACTOR_EN_CLEAR_TAG, player->world.pos.x, player->world.pos.y + 100.0f,
                     player->world.pos.z, 0, 0, 0, 1);
     }
+#if ACTOR_GRID
+    if (KREG(0) == -101) {
+        KREG(0) = 0;
+        ActorGrid_SpawnBenchmark(play);
+    }
+#endif
 #endif
 
     categoryFreezeMaskP = &sCategoryFreezeMasks[0];
@@ -2441,6 +2545,13 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
         sp74 = player->talkActor;
     }
 
+#if ACTOR_GRID
+    ActorGrid_BeginFrame(&actorCtx->grid);
+#endif
+#if ACTOR_UPDATE_LOD && DEBUG_FEATURES
+    sUpdateLodStats.frames++;
+#endif
+
     for (i = 0; i < ARRAY_COUNT(actorCtx->actorLists); i++, categoryFreezeMaskP++) {
         canFreezeCategory = (player->stateFlags1 & *categoryFreezeMaskP);
 
@@ -2467,6 +2578,10 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
                         !((sp74 == actor) || (player->naviActor == actor) || (player->heldActor == actor) ||
                           (actor->parent == &player->actor)))) {
                 CollisionCheck_ResetDamage(&actor->colChkInfo);
+#if ACTOR_GRID
+                // Its distance to Player is from an earlier frame
+                actorCtx->grid.distancesCurrent = false;
+#endif
                 actor = actor->next;
             } else if (actor->update == NULL) {
                 if (!actor->isDrawn) {
@@ -2483,9 +2598,16 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
 
                 actor->yawTowardsPlayer = Actor_WorldYawTowardActor(actor, &player->actor);
                 actor->flags &= ~ACTOR_FLAG_SFX_FOR_PLAYER_BODY_HIT;
+#if ACTOR_GRID
+                ActorGrid_BeginActor(&actorCtx->grid, actor, &player->actor);
+#endif
 
                 if ((DECR(actor->freezeTimer) == 0) &&
-                    (actor->flags & (ACTOR_FLAG_UPDATE_CULLING_DISABLED | ACTOR_FLAG_INSIDE_CULLING_VOLUME))) {
+                    (actor->flags & (ACTOR_FLAG_UPDATE_CULLING_DISABLED | ACTOR_FLAG_INSIDE_CULLING_VOLUME))
+#if ACTOR_UPDATE_LOD
+                    && !Actor_ThrottleUpdate(actor, player)
+#endif
+                ) {
                     if (actor == player->focusActor) {
                         actor->isLockedOn = true;
                     } else {
@@ -2500,7 +2622,15 @@ void Actor_UpdateAll(PlayState* play, ActorContext* actorCtx) {
                     if (actor->colorFilterTimer != 0) {
                         actor->colorFilterTimer--;
                     }
+#if ACTOR_UPDATE_LOD && DEBUG_FEATURES
+                    if (actor->flags & ACTOR_FLAG_UPDATE_LOD) {
+                        Actor_UpdateTimed(actor, play);
+                    } else {
+                        actor->update(actor, play);
+                    }
+#else
                     actor->update(actor, play);
+#endif
                     DynaPoly_UnsetAllInteractFlags(play, &play->colCtx.dyna, actor);
                 }
 
@@ -2858,6 +2988,165 @@ s32 Actor_CullingVolumeTest(PlayState* play, Actor* actor, Vec3f* projPos, f32 p
     return false;
 }
 
+// The arrays are allocated from the scratch space of the play state arena
+#define ACTOR_CULL_BATCH_ENABLED (ACTOR_CULL_BATCH && THA_SCRATCH)
+
+#if ACTOR_CULL_BATCH_ENABLED
+typedef struct ActorCullBatch {
+    /* 0x00 */ s32 count; // 0 if there was no room for the arrays
+    /* 0x04 */ void* mark; // Head of the play state arena before the arrays were allocated
+    /* 0x08 */ Actor** actors; // In the order Actor_DrawAll goes through them
+    /* 0x0C */ f32* posX;
+    /* 0x10 */ f32* posY;
+    /* 0x14 */ f32* posZ;
+    /* 0x18 */ f32* cullingVolumeScale;
+    /* 0x1C */ f32* cullingVolumeDistance;
+    /* 0x20 */ f32* cullingVolumeDownward;
+    /* 0x24 */ f32* projX;
+    /* 0x28 */ f32* projY;
+    /* 0x2C */ f32* projZ;
+    /* 0x30 */ f32* projW;
+    /* 0x34 */ u32* inside; // Bit set if inside the culling volume
+} ActorCullBatch; // size = 0x38
+
+#define ACTOR_CULL_BATCH_PROJECT(i)                                                   \
+    projX[i] = mf->xw + ((posX[i] * mf->xx) + (posY[i] * mf->xy) + (posZ[i] * mf->xz)); \
+    projY[i] = mf->yw + ((posX[i] * mf->yx) + (posY[i] * mf->yy) + (posZ[i] * mf->yz)); \
+    projZ[i] = mf->zw + ((posX[i] * mf->zx) + (posY[i] * mf->zy) + (posZ[i] * mf->zz)); \
+    projW[i] = mf->ww + ((posX[i] * mf->wx) + (posY[i] * mf->wy) + (posZ[i] * mf->wz))
+
+/**
+ * Projects every actor and tests it against its culling volume ahead of Actor_DrawAll, one stage at a time over arrays
+ * of all the actors, rather than one actor at a time. The arrays are allocated from the scratch space at the head of
+ * the play state arena (see THA_SCRATCH) and released by Actor_CullBatchEnd.
+ *
+ * The results are not written to the actors here, as actors drawn before may still read the previous frame's
+ * `projectedPos`. Actor_DrawAll takes them as it reaches each actor, see `Actor_ProjectBatched`.
+ */
+void Actor_CullBatchBegin(PlayState* play, ActorContext* actorCtx, ActorCullBatch* batch) {
+    TwoHeadArena* tha = &play->state.tha;
+    MtxF* mf = &play->viewProjectionMtxF;
+    s32 paddedCount = (actorCtx->total + 3) & ~3; // For the loop unrolled by 4
+    u32 size = paddedCount * (sizeof(Actor*) + 10 * sizeof(f32)) + (paddedCount / 32 + 1) * sizeof(u32);
+    f32* posX;
+    f32* posY;
+    f32* posZ;
+    f32* projX;
+    f32* projY;
+    f32* projZ;
+    f32* projW;
+    f32 invW;
+    Actor* actor;
+    u8* buf;
+    s32 count;
+    s32 i;
+
+    batch->count = 0;
+    batch->mark = THA_MarkHead(tha);
+
+    if ((actorCtx->total == 0) || (THA_GetRemaining(tha) < (s32)(size + 0xF))) {
+        return;
+    }
+
+    buf = (u8*)ALIGN16((uintptr_t)THA_AllocHead(tha, size + 0xF));
+    batch->projX = projX = (f32*)buf;
+    batch->projY = projY = projX + paddedCount;
+    batch->projZ = projZ = projY + paddedCount;
+    batch->projW = projW = projZ + paddedCount;
+    batch->posX = posX = projW + paddedCount;
+    batch->posY = posY = posX + paddedCount;
+    batch->posZ = posZ = posY + paddedCount;
+    batch->cullingVolumeScale = posZ + paddedCount;
+    batch->cullingVolumeDistance = batch->cullingVolumeScale + paddedCount;
+    batch->cullingVolumeDownward = batch->cullingVolumeDistance + paddedCount;
+    batch->actors = (Actor**)(batch->cullingVolumeDownward + paddedCount);
+    batch->inside = (u32*)(batch->actors + paddedCount);
+
+    // Gather
+    count = 0;
+    for (i = 0; i < ARRAY_COUNT(actorCtx->actorLists); i++) {
+        for (actor = actorCtx->actorLists[i].head; (actor != NULL) && (count < paddedCount); actor = actor->next) {
+            batch->actors[count] = actor;
+            posX[count] = actor->world.pos.x;
+            posY[count] = actor->world.pos.y;
+            posZ[count] = actor->world.pos.z;
+            batch->cullingVolumeScale[count] = actor->cullingVolumeScale;
+            batch->cullingVolumeDistance[count] = actor->cullingVolumeDistance;
+            batch->cullingVolumeDownward[count] = actor->cullingVolumeDownward;
+            count++;
+        }
+    }
+    for (i = count; i < paddedCount; i++) {
+        batch->actors[i] = NULL;
+        posX[i] = posY[i] = posZ[i] = 0.0f;
+        batch->cullingVolumeScale[i] = batch->cullingVolumeDistance[i] = batch->cullingVolumeDownward[i] = 0.0f;
+    }
+
+    // Project, same arithmetic as SkinMatrix_Vec3fMtxFMultXYZW
+    for (i = 0; i < paddedCount; i += 4) {
+        ACTOR_CULL_BATCH_PROJECT(i);
+        ACTOR_CULL_BATCH_PROJECT(i + 1);
+        ACTOR_CULL_BATCH_PROJECT(i + 2);
+        ACTOR_CULL_BATCH_PROJECT(i + 3);
+    }
+
+    // Test, same as Actor_CullingVolumeTest
+    bzero(batch->inside, (paddedCount / 32 + 1) * sizeof(u32));
+    for (i = 0; i < paddedCount; i++) {
+        if ((projZ[i] > -batch->cullingVolumeScale[i]) &&
+            (projZ[i] < (batch->cullingVolumeDistance[i] + batch->cullingVolumeScale[i]))) {
+            invW = (projW[i] < 1.0f) ? 1.0f : 1.0f / projW[i];
+
+            if ((((fabsf(projX[i]) - batch->cullingVolumeScale[i]) * invW) < 1.0f) &&
+                (((projY[i] + batch->cullingVolumeDownward[i]) * invW) > -1.0f) &&
+                (((projY[i] - batch->cullingVolumeScale[i]) * invW) < 1.0f)) {
+                batch->inside[i >> 5] |= 1 << (i & 0x1F);
+            }
+        }
+    }
+
+    batch->count = count;
+}
+
+void Actor_CullBatchEnd(PlayState* play, ActorCullBatch* batch) {
+    THA_ReleaseHead(&play->state.tha, batch->mark);
+}
+
+/**
+ * Sets the projected position of the actor at `index` in Actor_DrawAll's order, from the batch if the actor is the one
+ * gathered there and has not moved since.
+ */
+void Actor_ProjectBatched(PlayState* play, Actor* actor, ActorCullBatch* batch, s32 index) {
+    if ((index < batch->count) && (batch->actors[index] == actor) && (batch->posX[index] == actor->world.pos.x) &&
+        (batch->posY[index] == actor->world.pos.y) && (batch->posZ[index] == actor->world.pos.z)) {
+        actor->projectedPos.x = batch->projX[index];
+        actor->projectedPos.y = batch->projY[index];
+        actor->projectedPos.z = batch->projZ[index];
+        actor->projectedW = batch->projW[index];
+    } else {
+        SkinMatrix_Vec3fMtxFMultXYZW(&play->viewProjectionMtxF, &actor->world.pos, &actor->projectedPos,
+                                     &actor->projectedW);
+    }
+}
+
+/**
+ * Actor_CullingCheck for the actor at `index` in Actor_DrawAll's order, from the batch if its projected position and
+ * culling volume are those tested there.
+ */
+s32 Actor_CullingCheckBatched(PlayState* play, Actor* actor, ActorCullBatch* batch, s32 index) {
+    if ((index < batch->count) && (batch->actors[index] == actor) &&
+        (batch->projX[index] == actor->projectedPos.x) && (batch->projY[index] == actor->projectedPos.y) &&
+        (batch->projZ[index] == actor->projectedPos.z) && (batch->projW[index] == actor->projectedW) &&
+        (batch->cullingVolumeScale[index] == actor->cullingVolumeScale) &&
+        (batch->cullingVolumeDistance[index] == actor->cullingVolumeDistance) &&
+        (batch->cullingVolumeDownward[index] == actor->cullingVolumeDownward)) {
+        return (batch->inside[index >> 5] >> (index & 0x1F)) & 1;
+    }
+
+    return Actor_CullingCheck(play, actor);
+}
+#endif
+
 /**
  * Iterates through all category lists to draw every actor.
  *
@@ -2877,11 +3166,19 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
     ActorListEntry* actorListEntry;
     Actor* actor;
     s32 i;
+#if ACTOR_CULL_BATCH_ENABLED
+    ActorCullBatch cullBatch;
+    s32 cullIndex = 0;
+#endif
 
     invisibleActorCounter = 0;
 
     OPEN_DISPS(play->state.gfxCtx, "../z_actor.c", 6336);
 
+#if ACTOR_CULL_BATCH_ENABLED
+    Actor_CullBatchBegin(play, actorCtx, &cullBatch);
+#endif
+
     actorListEntry = &actorCtx->actorLists[0];
 
     for (i = 0; i < ARRAY_COUNT(actorCtx->actorLists); i++, actorListEntry++) {
@@ -2905,8 +3202,12 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
             }
 
             if (!DEBUG_FEATURES || (HREG(64) != 1) || ((HREG(65) != -1) && (HREG(65) != HREG(66))) || (HREG(68) == 0)) {
+#if ACTOR_CULL_BATCH_ENABLED
+                Actor_ProjectBatched(play, actor, &cullBatch, cullIndex);
+#else
                 SkinMatrix_Vec3fMtxFMultXYZW(&play->viewProjectionMtxF, &actor->world.pos, &actor->projectedPos,
                                              &actor->projectedW);
+#endif
             }
 
             if (!DEBUG_FEATURES || (HREG(64) != 1) || ((HREG(65) != -1) && (HREG(65) != HREG(66))) || (HREG(69) == 0)) {
@@ -2916,7 +3217,11 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
             }
 
             if (!DEBUG_FEATURES || (HREG(64) != 1) || ((HREG(65) != -1) && (HREG(65) != HREG(66))) || (HREG(70) == 0)) {
+#if ACTOR_CULL_BATCH_ENABLED
+                if (Actor_CullingCheckBatched(play, actor, &cullBatch, cullIndex)) {
+#else
                 if (Actor_CullingCheck(play, actor)) {
+#endif
                     actor->flags |= ACTOR_FLAG_INSIDE_CULLING_VOLUME;
                 } else {
                     actor->flags &= ~ACTOR_FLAG_INSIDE_CULLING_VOLUME;
@@ -2945,10 +3250,17 @@ void Actor_DrawAll(PlayState* play, ActorContext* actorCtx) {
                 }
             }
 
+#if ACTOR_CULL_BATCH_ENABLED
+            cullIndex++;
+#endif
             actor = actor->next;
         }
     }
 
+#if ACTOR_CULL_BATCH_ENABLED
+    Actor_CullBatchEnd(play, &cullBatch);
+#endif
+
     if (!DEBUG_FEATURES || (HREG(64) != 1) || (HREG(73) != 0)) {
         Effect_DrawAll(play->state.gfxCtx);
     }
@@ -3093,6 +3405,23 @@ void Actor_AddToCategory(ActorContext* actorCtx, Actor* actorToAdd, u8 actorCate
 
     actorCtx->actorLists[actorCategory].head = actorToAdd;
     actorToAdd->next = prevHead;
+
+#if ACTOR_ID_INDEX
+    // Also added at the front, so that actors of the same ID and category are in the same order in both lists
+    prevHead = actorCtx->idLists[actorToAdd->id];
+
+    if (prevHead != NULL) {
+        prevHead->idPrev = actorToAdd;
+    }
+
+    actorCtx->idLists[actorToAdd->id] = actorToAdd;
+    actorToAdd->idPrev = NULL;
+    actorToAdd->idNext = prevHead;
+#endif
+
+#if ACTOR_GRID
+    ActorGrid_Insert(&actorCtx->grid, actorToAdd);
+#endif
 }
 
 /**
@@ -3120,6 +3449,25 @@ Actor* Actor_RemoveFromCategory(PlayState* play, ActorContext* actorCtx, Actor*
     actorToRemove->next = NULL;
     actorToRemove->prev = NULL;
 
+#if ACTOR_ID_INDEX
+    if (actorToRemove->idPrev != NULL) {
+        actorToRemove->idPrev->idNext = actorToRemove->idNext;
+    } else {
+        actorCtx->idLists[actorToRemove->id] = actorToRemove->idNext;
+    }
+
+    if (actorToRemove->idNext != NULL) {
+        actorToRemove->idNext->idPrev = actorToRemove->idPrev;
+    }
+
+    actorToRemove->idNext = NULL;
+    actorToRemove->idPrev = NULL;
+#endif
+
+#if ACTOR_GRID
+    ActorGrid_Remove(&actorCtx->grid, actorToRemove);
+#endif
+
     if ((actorToRemove->room == play->roomCtx.curRoom.num) && (actorToRemove->category == ACTORCAT_ENEMY) &&
         (actorCtx->actorLists[ACTORCAT_ENEMY].length == 0)) {
         Flags_SetTempClear(play, play->roomCtx.curRoom.num);
@@ -3141,6 +3489,10 @@ void Actor_FreeOverlay(ActorOverlay* actorOverlay) {
                 ACTOR_DEBUG_PRINTF(T("絶対魔法領域確保なので解放しません\n",
                                      "Absolute magic field reserved, so deallocation will not occur\n"));
                 actorOverlay->loadedRamAddr = NULL;
+#if ACTOR_OVERLAY_CACHE
+            } else if (ActorOverlayTable_CacheKeep(actorOverlay)) {
+                ACTOR_DEBUG_PRINTF("Overlay kept in the overlay cache\n");
+#endif
             } else {
                 ACTOR_DEBUG_PRINTF(T("オーバーレイ解放します\n", "Overlay deallocated\n"));
                 ZELDA_ARENA_FREE(actorOverlay->loadedRamAddr, "../z_actor.c", 6834);
@@ -3189,6 +3541,11 @@ Actor* Actor_Spawn(ActorContext* actorCtx, PlayState* play, s16 actorId, f32 pos
     } else {
         if (overlayEntry->loadedRamAddr != NULL) {
             ACTOR_DEBUG_PRINTF(T("既にロードされています\n", "Already loaded\n"));
+#if ACTOR_OVERLAY_CACHE
+            if (overlayEntry->numLoaded == 0) {
+                ActorOverlayTable_CacheTake(overlayEntry);
+            }
+#endif
         } else {
             if (overlayEntry->allocType & ACTOROVL_ALLOC_ABSOLUTE) {
                 ASSERT(overlaySize <= ACTOROVL_ABSOLUTE_SPACE_SIZE, "actor_segsize <= AM_FIELD_SIZE", "../z_actor.c",
@@ -3206,7 +3563,17 @@ Actor* Actor_Spawn(ActorContext* actorCtx, PlayState* play, s16 actorId, f32 pos
             } else if (overlayEntry->allocType & ACTOROVL_ALLOC_PERSISTENT) {
                 overlayEntry->loadedRamAddr = ZELDA_ARENA_MALLOC_R(overlaySize, name, 0);
             } else {
+#if ACTOR_OVERLAY_CACHE
+                // Also allocate room for the copy of .data used when the overlay is taken out of the cache
+                overlayEntry->loadedRamAddr =
+                    ZELDA_ARENA_MALLOC(overlaySize + ActorOverlayTable_GetDataSize(overlayEntry), name, 0);
+                while ((overlayEntry->loadedRamAddr == NULL) && ActorOverlayTable_CacheEvict()) {
+                    overlayEntry->loadedRamAddr =
+                        ZELDA_ARENA_MALLOC(overlaySize + ActorOverlayTable_GetDataSize(overlayEntry), name, 0);
+                }
+#else
                 overlayEntry->loadedRamAddr = ZELDA_ARENA_MALLOC(overlaySize, name, 0);
+#endif
             }
 
             if (overlayEntry->loadedRamAddr == NULL) {
@@ -3218,6 +3585,12 @@ Actor* Actor_Spawn(ActorContext* actorCtx, PlayState* play, s16 actorId, f32 pos
             Overlay_Load(overlayEntry->file.vromStart, overlayEntry->file.vromEnd, overlayEntry->vramStart,
                          overlayEntry->vramEnd, overlayEntry->loadedRamAddr);
 
+#if ACTOR_OVERLAY_CACHE
+            if (!(overlayEntry->allocType & (ACTOROVL_ALLOC_ABSOLUTE | ACTOROVL_ALLOC_PERSISTENT))) {
+                ActorOverlayTable_SaveData(overlayEntry);
+            }
+#endif
+
             PRINTF_COLOR_GREEN();
             PRINTF("OVL(a):Seg:%08x-%08x Ram:%08x-%08x Off:%08x %s\n", overlayEntry->vramStart, overlayEntry->vramEnd,
                    overlayEntry->loadedRamAddr,
@@ -3247,7 +3620,13 @@ Actor* Actor_Spawn(ActorContext* actorCtx, PlayState* play, s16 actorId, f32 pos
         return NULL;
     }
 
-    actor = ZELDA_ARENA_MALLOC(profile->instanceSize, name, 1);
+    actor = ZELDA_POOL_MALLOC(profile->instanceSize, name, 1);
+
+#if ACTOR_OVERLAY_CACHE
+    while ((actor == NULL) && ActorOverlayTable_CacheEvict()) {
+        actor = ZELDA_POOL_MALLOC(profile->instanceSize, name, 1);
+    }
+#endif
 
     if (actor == NULL) {
         PRINTF(ACTOR_COLOR_ERROR T("Ａｃｔｏｒクラス確保できません！ %s <サイズ＝%dバイト>\n",
@@ -3395,7 +3774,7 @@ Actor* Actor_Delete(ActorContext* actorCtx, Actor* actor, PlayState* play) {
 
     newHead = Actor_RemoveFromCategory(play2, actorCtx, actor);
 
-    ZELDA_ARENA_FREE(actor, "../z_actor.c", 7242);
+    ZELDA_POOL_FREE(actor, "../z_actor.c", 7242);
 
     if (overlayEntry->vramStart == NULL) {
         ACTOR_DEBUG_PRINTF(T("オーバーレイではありません\n", "Not an overlay\n"));
@@ -3434,6 +3813,51 @@ f32 sBgmEnemyDistSq;
 s32 sHighestAttentionPriority;
 s16 sAttentionPlayerRotY;
 
+#if ACTOR_GRID
+/**
+ * Checks one actor for `Attention_FindActorInCategory`, for both the category lists and the grid. The actors have to be
+ * checked in the same order either way, as whether an actor with an attention priority is kept depends on the nearest
+ * actor found before it.
+ */
+void Attention_CheckActor(PlayState* play, ActorContext* actorCtx, Player* player, Actor* actor) {
+    f32 distSq;
+    CollisionPoly* poly;
+    s32 bgId;
+    Vec3f lineTestResultPos;
+
+    if ((actor->update != NULL) && ((Player*)actor != player) &&
+        ACTOR_FLAGS_CHECK_ALL(actor, ACTOR_FLAG_ATTENTION_ENABLED)) {
+        if ((actor->category == ACTORCAT_ENEMY) &&
+            ACTOR_FLAGS_CHECK_ALL(actor, ACTOR_FLAG_ATTENTION_ENABLED | ACTOR_FLAG_HOSTILE) &&
+            (actor->xyzDistToPlayerSq < SQ(500.0f)) && (actor->xyzDistToPlayerSq < sBgmEnemyDistSq)) {
+            actorCtx->attention.bgmEnemy = actor;
+            sBgmEnemyDistSq = actor->xyzDistToPlayerSq;
+        }
+
+        if (actor != player->focusActor) {
+            distSq = Attention_WeightedDistToPlayerSq(actor, player, sAttentionPlayerRotY);
+
+            if ((distSq < sNearestAttentionActorDistSq) && Attention_ActorIsInRange(actor, distSq) &&
+                Attention_ActorOnScreen(play, actor) &&
+                (!BgCheck_CameraLineTest1(&play->colCtx, &player->actor.focus.pos, &actor->focus.pos,
+                                          &lineTestResultPos, &poly, true, true, true, true, &bgId) ||
+                 SurfaceType_IsIgnoredByProjectiles(&play->colCtx, poly, bgId))) {
+                if (actor->attentionPriority != 0) {
+                    // Lower values are considered higher priority
+                    if (actor->attentionPriority < sHighestAttentionPriority) {
+                        sPrioritizedAttentionActor = actor;
+                        sHighestAttentionPriority = actor->attentionPriority;
+                    }
+                } else {
+                    sNearestAttentionActor = actor;
+                    sNearestAttentionActorDistSq = distSq;
+                }
+            }
+        }
+    }
+}
+#endif
+
 /**
  * Search for attention actors within the specified category.
  *
@@ -3454,6 +3878,14 @@ s16 sAttentionPlayerRotY;
  * variables must be reset by the caller, otherwise the information of the previous cycle will be retained.
  */
 void Attention_FindActorInCategory(PlayState* play, ActorContext* actorCtx, Player* player, u32 actorCategory) {
+#if ACTOR_GRID
+    Actor* actor;
+
+    for (actor = actorCtx->actorLists[actorCategory].head; actor != NULL; actor = actor->next) {
+        Attention_CheckActor(play, actorCtx, player, actor);
+    }
+#else
+    // The loop body is Attention_CheckActor, written out so that the build matches
     f32 distSq;
     Actor* actor;
     Actor* playerFocusActor;
@@ -3498,6 +3930,7 @@ void Attention_FindActorInCategory(PlayState* play, ActorContext* actorCtx, Play
 
         actor = actor->next;
     }
+#endif
 }
 
 u8 sAttentionCategorySearchOrder[] = {
@@ -3505,6 +3938,120 @@ u8 sAttentionCategorySearchOrder[] = {
     ACTORCAT_CHEST, ACTORCAT_SWITCH, ACTORCAT_PROP, ACTORCAT_MISC,      ACTORCAT_DOOR, ACTORCAT_SWITCH,
 };
 
+#if ACTOR_GRID
+// Whether `actorA` comes before `actorB` when going through the categories in `sAttentionCategorySearchOrder`
+#define ATTENTION_GRID_PRECEDES(categoryRanks, actorA, actorB)                     \
+    ((categoryRanks[(actorA)->category] < categoryRanks[(actorB)->category]) ||   \
+     ((categoryRanks[(actorA)->category] == categoryRanks[(actorB)->category]) && \
+      ((actorA)->gridOrder > (actorB)->gridOrder)))
+
+/**
+ * Sorts the actors found in the grid in the order `Attention_FindActorInCategory` goes through them: by category in
+ * `sAttentionCategorySearchOrder`, then from the front of the category list.
+ */
+void Attention_SortGridActors(Actor** actors, s32 count, u8* categoryRanks) {
+    Actor* actor;
+    s32 i;
+    s32 j;
+
+    for (i = 1; i < count; i++) {
+        actor = actors[i];
+        for (j = i; (j > 0) && ATTENTION_GRID_PRECEDES(categoryRanks, actor, actors[j - 1]); j--) {
+            actors[j] = actors[j - 1];
+        }
+        actors[j] = actor;
+    }
+}
+
+/**
+ * Finds the same actors as searching the categories of `sAttentionCategorySearchOrder` with
+ * `Attention_FindActorInCategory`, going only through the actors in the grid cells around Player that can be in range.
+ * They are checked in the same order as the category search, see `Attention_SortGridActors`.
+ *
+ * The distances compared are those computed in Actor_UpdateAll, and the actors are in the cells of the positions they
+ * were computed from, see `ActorGrid_BeginActor`. The cells searched are widened by how far Player moved while they were
+ * computed.
+ *
+ * @return false if the categories have to be searched instead, as some actors' distances to Player are from an earlier
+ * frame
+ */
+s32 Attention_FindActorInGrid(PlayState* play, ActorContext* actorCtx, Player* player) {
+    ActorGrid* grid = &actorCtx->grid;
+    u8 categoryRanks[ACTORCAT_MAX];
+    u32 categoryMask = 0;
+    Actor** candidates;
+    s32 candidateCount;
+    f32 maxRangeSq = 0.0f;
+    f32 playerDriftX;
+    f32 playerDriftZ;
+    f32 radius;
+    s32 i;
+
+    if (!grid->distancesCurrent || (grid->playerMinX > grid->playerMaxX)) {
+        return false;
+    }
+
+    for (i = ARRAY_COUNT(sAttentionCategorySearchOrder) - 1; i >= 0; i--) {
+        categoryRanks[sAttentionCategorySearchOrder[i]] = i;
+        categoryMask |= 1 << sAttentionCategorySearchOrder[i];
+    }
+
+    for (i = 0; i < ATTENTION_RANGE_MAX; i++) {
+        if (sAttentionRanges[i].attentionRangeSq > maxRangeSq) {
+            maxRangeSq = sAttentionRanges[i].attentionRangeSq;
+        }
+    }
+
+    playerDriftX = MAX(fabsf(player->actor.world.pos.x - grid->playerMinX),
+                       fabsf(player->actor.world.pos.x - grid->playerMaxX));
+    playerDriftZ = MAX(fabsf(player->actor.world.pos.z - grid->playerMinZ),
+                       fabsf(player->actor.world.pos.z - grid->playerMaxZ));
+
+    // Attention_WeightedDistToPlayerSq weighs distances down to 60% while Player is locked on. The extra unit covers
+    // rounding.
+    radius = sqrtf(maxRangeSq / 0.6f) + sqrtf(SQ(playerDriftX) + SQ(playerDriftZ)) + 1.0f;
+
+    candidates = ActorGrid_Gather(actorCtx, player->actor.world.pos.x, player->actor.world.pos.z, radius, categoryMask,
+                                  &candidateCount);
+    Attention_SortGridActors(candidates, candidateCount, categoryRanks);
+
+    // Boss, Enemy and Bg first, then the other categories if no actor was found
+    for (i = 0; i < candidateCount; i++) {
+        if (categoryRanks[candidates[i]->category] < 3) {
+            Attention_CheckActor(play, actorCtx, player, candidates[i]);
+        }
+    }
+
+    if (sNearestAttentionActor == NULL) {
+        for (i = 0; i < candidateCount; i++) {
+            if (categoryRanks[candidates[i]->category] >= 3) {
+                Attention_CheckActor(play, actorCtx, player, candidates[i]);
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * The category search of `Attention_FindActor`, for when `Attention_FindActorInGrid` cannot be used.
+ */
+void Attention_FindActorInCategories(PlayState* play, ActorContext* actorCtx, Player* player) {
+    s32 i;
+    u8* category = &sAttentionCategorySearchOrder[0];
+
+    for (i = 0; i < 3; i++, category++) {
+        Attention_FindActorInCategory(play, actorCtx, player, *category);
+    }
+
+    if (sNearestAttentionActor == NULL) {
+        for (; i < ARRAY_COUNT(sAttentionCategorySearchOrder); i++, category++) {
+            Attention_FindActorInCategory(play, actorCtx, player, *category);
+        }
+    }
+}
+#endif
+
 /**
  * Search for the nearest attention actor by iterating through most actor categories.
  * See `Attention_FindActorInCategory` for more details on search criteria.
@@ -3513,18 +4060,27 @@ u8 sAttentionCategorySearchOrder[] = {
  * It may be NULL if no actor that fulfills the criteria is found.
  */
 Actor* Attention_FindActor(PlayState* play, ActorContext* actorCtx, Actor** attentionActorP, Player* player) {
+#if !ACTOR_GRID
     s32 i;
     u8* category;
+#endif
 
     sNearestAttentionActor = sPrioritizedAttentionActor = NULL;
     sNearestAttentionActorDistSq = sBgmEnemyDistSq = MAXFLOAT;
     sHighestAttentionPriority = INT32_MAX;
 
     if (!Player_InCsMode(play)) {
+#if !ACTOR_GRID
         category = &sAttentionCategorySearchOrder[0];
+#endif
         actorCtx->attention.bgmEnemy = NULL;
         sAttentionPlayerRotY = player->actor.shape.rot.y;
 
+#if ACTOR_GRID
+        if (!Attention_FindActorInGrid(play, actorCtx, player)) {
+            Attention_FindActorInCategories(play, actorCtx, player);
+        }
+#else
         // Search the first 3 actor categories first for an attention actor
         // These are Boss, Enemy, and Bg, in order.
         for (i = 0; i < 3; i++, category++) {
@@ -3537,6 +4093,7 @@ Actor* Attention_FindActor(PlayState* play, ActorContext* actorCtx, Actor** atte
                 Attention_FindActorInCategory(play, actorCtx, player, *category);
             }
         }
+#endif
     }
 
     if (sNearestAttentionActor == NULL) {
@@ -3548,10 +4105,70 @@ Actor* Attention_FindActor(PlayState* play, ActorContext* actorCtx, Actor** atte
     return *attentionActorP;
 }
 
+#if ACTOR_ID_INDEX && DEBUG_FEATURES
+typedef struct ActorIdIndexStats {
+    /* 0x00 */ u32 lookups;
+    /* 0x04 */ u32 indexNodes; // Actors visited in the ID lists
+    /* 0x08 */ u32 listNodes;  // Actors the same lookups visit in the category lists
+} ActorIdIndexStats; // size = 0xC
+
+ActorIdIndexStats sActorIdIndexStats;
+
+/**
+ * Counts the actors Actor_Find, or Actor_FindNearby if `refActor` is not NULL, visit in the category list, to compare
+ * with the ID list.
+ */
+void Actor_CountCategoryListNodes(ActorContext* actorCtx, s32 actorId, s32 actorCategory, Actor* refActor, f32 range) {
+    Actor* actor = actorCtx->actorLists[actorCategory].head;
+
+    sActorIdIndexStats.lookups++;
+    while (actor != NULL) {
+        sActorIdIndexStats.listNodes++;
+        if ((actor != refActor) && (actor->id == actorId) &&
+            ((refActor == NULL) || (Actor_WorldDistXYZToActor(refActor, actor) <= range))) {
+            break;
+        }
+        actor = actor->next;
+    }
+}
+
+void Actor_DisplayIdIndexStats(void) {
+    ActorIdIndexStats* stats = &sActorIdIndexStats;
+
+    PRINTF("actor id index: lookups %d, nodes visited %d (category lists %d)\n", stats->lookups, stats->indexNodes,
+           stats->listNodes);
+    if (stats->lookups != 0) {
+        PRINTF("actor id index: %d.%02d nodes per lookup (category lists %d.%02d)\n", stats->indexNodes / stats->lookups,
+               stats->indexNodes * 100 / stats->lookups % 100, stats->listNodes / stats->lookups,
+               stats->listNodes * 100 / stats->lookups % 100);
+    }
+}
+
+#define ACTOR_ID_INDEX_COUNT_LIST(actorCtx, actorId, actorCategory, refActor, range) \
+    Actor_CountCategoryListNodes(actorCtx, actorId, actorCategory, refActor, range)
+#define ACTOR_ID_INDEX_COUNT_NODE() sActorIdIndexStats.indexNodes++
+#else
+#define ACTOR_ID_INDEX_COUNT_LIST(actorCtx, actorId, actorCategory, refActor, range) (void)0
+#define ACTOR_ID_INDEX_COUNT_NODE() (void)0
+#endif
+
 /**
  * Finds the first actor instance of a specified ID and category if there is one.
  */
 Actor* Actor_Find(ActorContext* actorCtx, s32 actorId, s32 actorCategory) {
+#if ACTOR_ID_INDEX
+    Actor* actor = actorCtx->idLists[actorId];
+
+    ACTOR_ID_INDEX_COUNT_LIST(actorCtx, actorId, actorCategory, NULL, 0.0f);
+
+    while (actor != NULL) {
+        ACTOR_ID_INDEX_COUNT_NODE();
+        if (actor->category == actorCategory) {
+            return actor;
+        }
+        actor = actor->idNext;
+    }
+#else
     Actor* actor = actorCtx->actorLists[actorCategory].head;
 
     while (actor != NULL) {
@@ -3560,10 +4177,25 @@ Actor* Actor_Find(ActorContext* actorCtx, s32 actorId, s32 actorCategory) {
         }
         actor = actor->next;
     }
+#endif
 
     return NULL;
 }
 
+#if ACTOR_ID_INDEX
+/**
+ * Returns the most recently spawned actor instance of a specified ID, of any category, if there is one. The other
+ * instances follow through `Actor.idNext`:
+ *
+ *     for (actor = Actor_FindFirstOfId(&play->actorCtx, ACTOR_EN_XX); actor != NULL; actor = actor->idNext)
+ *
+ * The list must not be walked across a call that may spawn or delete an actor of that ID.
+ */
+Actor* Actor_FindFirstOfId(ActorContext* actorCtx, s32 actorId) {
+    return actorCtx->idLists[actorId];
+}
+#endif
+
 /**
  * Play the death sound effect and flash the screen white for 4 frames.
  * While the screen flashes, the game freezes.
@@ -3830,6 +4462,10 @@ void Actor_ChangeCategory(PlayState* play, ActorContext* actorCtx, Actor* actor,
     //! once.
     Actor_RemoveFromCategory(play, actorCtx, actor);
     Actor_AddToCategory(actorCtx, actor, actorCategory);
+#if ACTOR_GRID
+    // Actor_UpdateAll may skip the actors after it in its old category this frame, see above
+    actorCtx->grid.distancesCurrent = false;
+#endif
 }
 
 /**
@@ -4652,7 +5288,24 @@ u8 func_800353E8(PlayState* play) {
  * specified category rather than a specific ID.
  */
 Actor* Actor_FindNearby(PlayState* play, Actor* refActor, s16 actorId, u8 actorCategory, f32 range) {
-    Actor* actor = play->actorCtx.actorLists[actorCategory].head;
+    Actor* actor;
+
+#if ACTOR_ID_INDEX
+    if (actorId != -1) {
+        ACTOR_ID_INDEX_COUNT_LIST(&play->actorCtx, actorId, actorCategory, refActor, range);
+
+        for (actor = play->actorCtx.idLists[actorId]; actor != NULL; actor = actor->idNext) {
+            ACTOR_ID_INDEX_COUNT_NODE();
+            if ((actor != refActor) && (actor->category == actorCategory) &&
+                (Actor_WorldDistXYZToActor(refActor, actor) <= range)) {
+                return actor;
+            }
+        }
+        return NULL;
+    }
+#endif
+
+    actor = play->actorCtx.actorLists[actorCategory].head;
 
     while (actor != NULL) {
         if (actor == refActor || ((actorId != -1) && (actor->id != actorId))) {
@@ -2,6 +2,9 @@
 #include "printf.h"
 #include "segment_symbols.h"
 #include "z_actor_dlftbls.h"
+#if ACTOR_OVERLAY_CACHE
+#include "zelda_arena.h"
+#endif
 
 // Linker symbol declarations (used in the table below)
 #define DEFINE_ACTOR(name, _1, _2, _3) DECLARE_OVERLAY_SEGMENT(name)
@@ -81,6 +84,225 @@ s32 gMaxActorId = 0;
 
 static FaultClient sFaultClient;
 
+#if ACTOR_OVERLAY_CACHE
+/**
+ * Actor overlay cache.
+ *
+ * When the last instance of a normally-allocated actor is deleted, its overlay is kept loaded (and relocated) instead
+ * of being freed, as long as the overlays kept this way fit in ACTOR_OVERLAY_CACHE bytes. The least recently used ones
+ * are freed to make room. The next spawn of that actor then skips loading and relocating the overlay.
+ *
+ * An overlay loaded again from ROM starts with its static variables in their initial state, which some actors rely
+ * on. To preserve that, a copy of the relocated .data section is allocated after the overlay when it is loaded, and
+ * taking an overlay out of the cache restores .data from it and clears .bss.
+ */
+
+// Linker symbol declarations for the .data sections of actor overlays
+#define DEFINE_ACTOR(name, _1, _2, _3)              \
+    extern u8 _ovl_##name##SegmentDataStart[]; \
+    extern u8 _ovl_##name##SegmentDataEnd[];
+#define DEFINE_ACTOR_INTERNAL(_0, _1, _2, _3)
+#define DEFINE_ACTOR_UNSET(_0)
+
+#include "tables/actor_table.h"
+
+#undef DEFINE_ACTOR
+#undef DEFINE_ACTOR_INTERNAL
+#undef DEFINE_ACTOR_UNSET
+
+typedef struct ActorOverlayData {
+    /* 0x00 */ void* dataStart;
+    /* 0x04 */ void* dataEnd;
+} ActorOverlayData; // size = 0x8
+
+#define DEFINE_ACTOR(name, _1, _2, _3) { _ovl_##name##SegmentDataStart, _ovl_##name##SegmentDataEnd },
+#define DEFINE_ACTOR_INTERNAL(_0, _1, _2, _3) { NULL, NULL },
+#define DEFINE_ACTOR_UNSET(_0) { NULL, NULL },
+
+ActorOverlayData sActorOverlayDataTable[] = {
+#include "tables/actor_table.h"
+};
+
+#undef DEFINE_ACTOR
+#undef DEFINE_ACTOR_INTERNAL
+#undef DEFINE_ACTOR_UNSET
+
+#define ACTOR_OVERLAY_CACHE_ENTRIES 16
+
+typedef struct ActorOverlayCache {
+    /* 0x00 */ s16 actorIds[ACTOR_OVERLAY_CACHE_ENTRIES]; // From least to most recently used
+    /* 0x20 */ s32 count;
+    /* 0x24 */ u32 size; // Total size of the cached overlays, including their .data copies
+} ActorOverlayCache; // size = 0x28
+
+ActorOverlayCache sActorOverlayCache;
+
+#if DEBUG_FEATURES
+typedef struct ActorOverlayCacheStats {
+    /* 0x00 */ u32 hits;
+    /* 0x04 */ u32 evictions;
+    /* 0x08 */ u16 overlayHits[ACTOR_ID_MAX];
+} ActorOverlayCacheStats;
+
+ActorOverlayCacheStats gActorOverlayCacheStats;
+#endif
+
+/**
+ * Returns the size of the copy of .data allocated after the overlay.
+ */
+u32 ActorOverlayTable_GetDataSize(ActorOverlay* overlayEntry) {
+    ActorOverlayData* data = &sActorOverlayDataTable[overlayEntry - gActorOverlayTable];
+
+    return (uintptr_t)data->dataEnd - (uintptr_t)data->dataStart;
+}
+
+/**
+ * Returns the size of the arena block holding the overlay and its copy of .data.
+ */
+u32 ActorOverlayTable_GetCachedSize(ActorOverlay* overlayEntry) {
+    return (uintptr_t)overlayEntry->vramEnd - (uintptr_t)overlayEntry->vramStart +
+           ActorOverlayTable_GetDataSize(overlayEntry);
+}
+
+/**
+ * Saves the initial state of the .data section of a freshly loaded overlay. The overlay must have been allocated with
+ * room for the copy after it, see ActorOverlayTable_GetDataSize.
+ */
+void ActorOverlayTable_SaveData(ActorOverlay* overlayEntry) {
+    ActorOverlayData* data = &sActorOverlayDataTable[overlayEntry - gActorOverlayTable];
+    u8* ramStart = overlayEntry->loadedRamAddr;
+    u32 overlaySize = (uintptr_t)overlayEntry->vramEnd - (uintptr_t)overlayEntry->vramStart;
+
+    bcopy(ramStart + ((uintptr_t)data->dataStart - (uintptr_t)overlayEntry->vramStart), ramStart + overlaySize,
+          ActorOverlayTable_GetDataSize(overlayEntry));
+}
+
+/**
+ * Frees the least recently used cached overlay.
+ *
+ * @return false if the cache is empty
+ */
+s32 ActorOverlayTable_CacheEvict(void) {
+    ActorOverlay* overlayEntry;
+    s32 i;
+
+    if (sActorOverlayCache.count == 0) {
+        return false;
+    }
+
+    overlayEntry = &gActorOverlayTable[sActorOverlayCache.actorIds[0]];
+    sActorOverlayCache.count--;
+    sActorOverlayCache.size -= ActorOverlayTable_GetCachedSize(overlayEntry);
+    for (i = 0; i < sActorOverlayCache.count; i++) {
+        sActorOverlayCache.actorIds[i] = sActorOverlayCache.actorIds[i + 1];
+    }
+
+    ZELDA_ARENA_FREE(overlayEntry->loadedRamAddr, "../z_actor_dlftbls.c", __LINE__);
+    overlayEntry->loadedRamAddr = NULL;
+
+#if DEBUG_FEATURES
+    gActorOverlayCacheStats.evictions++;
+#endif
+    return true;
+}
+
+/**
+ * Called when the last instance of a normally-allocated actor is deleted.
+ *
+ * @return true if the overlay was kept in the cache, false if it should be freed
+ */
+s32 ActorOverlayTable_CacheKeep(ActorOverlay* overlayEntry) {
+    u32 size = ActorOverlayTable_GetCachedSize(overlayEntry);
+
+    if (size > ACTOR_OVERLAY_CACHE) {
+        return false;
+    }
+
+    while ((sActorOverlayCache.count == ACTOR_OVERLAY_CACHE_ENTRIES) ||
+           (sActorOverlayCache.size + size > ACTOR_OVERLAY_CACHE)) {
+        ActorOverlayTable_CacheEvict();
+    }
+
+    sActorOverlayCache.actorIds[sActorOverlayCache.count++] = overlayEntry - gActorOverlayTable;
+    sActorOverlayCache.size += size;
+    return true;
+}
+
+/**
+ * Called when spawning an actor whose overlay is loaded but has no instances. If the overlay is in the cache, takes it
+ * out and resets its static variables to their initial state.
+ */
+void ActorOverlayTable_CacheTake(ActorOverlay* overlayEntry) {
+    ActorOverlayData* data;
+    s32 actorId = overlayEntry - gActorOverlayTable;
+    u8* ramStart;
+    u32 fileSize;
+    u32 overlaySize;
+    s32 i;
+
+    for (i = 0; i < sActorOverlayCache.count; i++) {
+        if (sActorOverlayCache.actorIds[i] == actorId) {
+            break;
+        }
+    }
+    if (i == sActorOverlayCache.count) {
+        return;
+    }
+
+    sActorOverlayCache.count--;
+    sActorOverlayCache.size -= ActorOverlayTable_GetCachedSize(overlayEntry);
+    for (; i < sActorOverlayCache.count; i++) {
+        sActorOverlayCache.actorIds[i] = sActorOverlayCache.actorIds[i + 1];
+    }
+
+    data = &sActorOverlayDataTable[actorId];
+    ramStart = overlayEntry->loadedRamAddr;
+    fileSize = overlayEntry->file.vromEnd - overlayEntry->file.vromStart;
+    overlaySize = (uintptr_t)overlayEntry->vramEnd - (uintptr_t)overlayEntry->vramStart;
+
+    // Restore .data, and clear .bss which follows the overlay file like in Overlay_Load
+    bcopy(ramStart + overlaySize, ramStart + ((uintptr_t)data->dataStart - (uintptr_t)overlayEntry->vramStart),
+          ActorOverlayTable_GetDataSize(overlayEntry));
+    bzero(ramStart + fileSize, overlaySize - fileSize);
+
+#if DEBUG_FEATURES
+    gActorOverlayCacheStats.hits++;
+    gActorOverlayCacheStats.overlayHits[actorId]++;
+#endif
+}
+
+/**
+ * Frees all the cached overlays.
+ */
+void ActorOverlayTable_CacheClear(void) {
+    while (ActorOverlayTable_CacheEvict()) {}
+}
+
+#if DEBUG_FEATURES
+void ActorOverlayTable_CacheDisplay(void) {
+    ActorOverlay* overlayEntry;
+    s32 i;
+
+    PRINTF("actor overlay cache %d/%d bytes, %d overlays, %u hits, %u evictions\n", sActorOverlayCache.size,
+           ACTOR_OVERLAY_CACHE, sActorOverlayCache.count, gActorOverlayCacheStats.hits,
+           gActorOverlayCacheStats.evictions);
+
+    for (i = 0; i < sActorOverlayCache.count; i++) {
+        overlayEntry = &gActorOverlayTable[sActorOverlayCache.actorIds[i]];
+        PRINTF("  cached %3d %08x %6d bytes %s\n", sActorOverlayCache.actorIds[i], overlayEntry->loadedRamAddr,
+               ActorOverlayTable_GetCachedSize(overlayEntry), overlayEntry->name != NULL ? overlayEntry->name : "?");
+    }
+
+    for (i = 0, overlayEntry = &gActorOverlayTable[0]; i < ACTOR_ID_MAX; i++, overlayEntry++) {
+        if (gActorOverlayCacheStats.overlayHits[i] != 0) {
+            PRINTF("  hits %3d %5u %s\n", i, gActorOverlayCacheStats.overlayHits[i],
+                   overlayEntry->name != NULL ? overlayEntry->name : "?");
+        }
+    }
+}
+#endif
+#endif
+
 void ActorOverlayTable_LogPrint(void) {
 #if DEBUG_FEATURES
     ActorOverlay* overlayEntry;
@@ -149,10 +371,18 @@ void ActorOverlayTable_FaultPrint(void* arg0, void* arg1) {
 
 void ActorOverlayTable_Init(void) {
     gMaxActorId = ACTOR_ID_MAX;
+#if ACTOR_OVERLAY_CACHE
+    // The overlays cached by the previous game state were freed along with its arena
+    sActorOverlayCache.count = 0;
+    sActorOverlayCache.size = 0;
+#endif
     Fault_AddClient(&sFaultClient, ActorOverlayTable_FaultPrint, NULL, NULL);
 }
 
 void ActorOverlayTable_Cleanup(void) {
+#if ACTOR_OVERLAY_CACHE
+    ActorOverlayTable_CacheClear();
+#endif
     Fault_RemoveClient(&sFaultClient);
     gMaxActorId = 0;
 }
@@ -0,0 +1,232 @@
+/**
+ * @file z_actor_grid.c
+ *
+ * A uniform grid of the actors in XZ, for Attention_FindActor to go through only the actors around Player instead of
+ * every actor of the categories it searches. Actors are kept in intrusive lists, one per bucket of cells (see
+ * ACTOR_GRID_WRAP). They are added and removed with their category list.
+ *
+ * An actor is moved to the cell of its position when Actor_UpdateAll computes its distance to Player, see
+ * `ActorGrid_BeginActor`, and stays there for the rest of the frame. Lock-on compares those distances rather than
+ * positions, so this is the position it needs: the actor's own update, or another actor moving it later in the frame,
+ * doesn't change the distance that lock-on will use. Only how far Player moved while the distances were computed has to
+ * be allowed for. Actors spawned this frame have no distance yet (Actor_Init sets it to MAXFLOAT), so they can't be
+ * found by lock-on either.
+ *
+ * Actor positions are written directly all over the actors' code, so the cells can't be kept current for queries about
+ * positions, such as Actor_FindNearby's. The grid is only used by lock-on.
+ */
+#include "array_count.h"
+#include "printf.h"
+#include "regs.h"
+#include "translation.h"
+#include "z_en_item00.h"
+#include "actor.h"
+#include "play_state.h"
+#include "player.h"
+
+#define ACTOR_GRID_BUCKET(cellX, cellZ) \
+    ((((cellZ) % ACTOR_GRID_WRAP) * ACTOR_GRID_WRAP) + ((cellX) % ACTOR_GRID_WRAP))
+
+#define ACTOR_GRID_CATEGORY_BIT(category) (1 << (category))
+
+// Every actor can be in the results, ActorContext.total is a u8
+Actor* sActorGridCandidates[0x100];
+
+#if DEBUG_FEATURES
+typedef struct ActorGridStats {
+    /* 0x00 */ u32 queries;
+    /* 0x04 */ u32 candidates; // Actors of the cells searched
+    /* 0x08 */ u32 listActors; // Actors of the categories searched, that searching the category lists visits
+} ActorGridStats; // size = 0xC
+
+ActorGridStats sActorGridStats;
+#endif
+
+s32 ActorGrid_GetCell(f32 coord) {
+    s32 cell = (s32)(coord + (ACTOR_GRID_CELLS * ACTOR_GRID_CELL_SIZE / 2)) / ACTOR_GRID_CELL_SIZE;
+
+    if (cell < 0) {
+        return 0;
+    }
+    if (cell >= ACTOR_GRID_CELLS) {
+        return ACTOR_GRID_CELLS - 1;
+    }
+    return cell;
+}
+
+void ActorGrid_Link(ActorGrid* grid, Actor* actor, s32 cellX, s32 cellZ) {
+    Actor** bucket = &grid->buckets[ACTOR_GRID_BUCKET(cellX, cellZ)];
+
+    actor->gridCellX = cellX;
+    actor->gridCellZ = cellZ;
+    actor->gridPrev = NULL;
+    actor->gridNext = *bucket;
+
+    if (*bucket != NULL) {
+        (*bucket)->gridPrev = actor;
+    }
+    *bucket = actor;
+}
+
+/**
+ * Adds an actor to the grid, called when it is added to a category. It is put in the cell of its current position until
+ * its distance to Player is computed.
+ */
+void ActorGrid_Insert(ActorGrid* grid, Actor* actor) {
+    // Same order as the category lists, which add actors at the front
+    actor->gridOrder = grid->nextOrder++;
+    ActorGrid_Link(grid, actor, ActorGrid_GetCell(actor->world.pos.x), ActorGrid_GetCell(actor->world.pos.z));
+}
+
+/**
+ * Removes an actor from the grid, called when it is removed from its category.
+ */
+void ActorGrid_Remove(ActorGrid* grid, Actor* actor) {
+    if (actor->gridPrev != NULL) {
+        actor->gridPrev->gridNext = actor->gridNext;
+    } else {
+        grid->buckets[ACTOR_GRID_BUCKET(actor->gridCellX, actor->gridCellZ)] = actor->gridNext;
+    }
+
+    if (actor->gridNext != NULL) {
+        actor->gridNext->gridPrev = actor->gridPrev;
+    }
+
+    actor->gridNext = NULL;
+    actor->gridPrev = NULL;
+}
+
+/**
+ * Moves an actor to the cell of its current position.
+ */
+void ActorGrid_Update(ActorGrid* grid, Actor* actor) {
+    s32 cellX = ActorGrid_GetCell(actor->world.pos.x);
+    s32 cellZ = ActorGrid_GetCell(actor->world.pos.z);
+
+    if ((cellX != actor->gridCellX) || (cellZ != actor->gridCellZ)) {
+        ActorGrid_Remove(grid, actor);
+        ActorGrid_Link(grid, actor, cellX, cellZ);
+    }
+}
+
+/**
+ * Called by Actor_UpdateAll before updating the actors.
+ */
+void ActorGrid_BeginFrame(ActorGrid* grid) {
+    grid->playerMinX = grid->playerMinZ = MAXFLOAT;
+    grid->playerMaxX = grid->playerMaxZ = -MAXFLOAT;
+    grid->distancesCurrent = true;
+}
+
+/**
+ * Called by Actor_UpdateAll when it has computed the distance from an actor to Player, before updating the actor. Moves
+ * the actor to the cell of the position the distance was computed from.
+ */
+void ActorGrid_BeginActor(ActorGrid* grid, Actor* actor, Actor* player) {
+    ActorGrid_Update(grid, actor);
+
+    if (player->world.pos.x < grid->playerMinX) {
+        grid->playerMinX = player->world.pos.x;
+    }
+    if (player->world.pos.x > grid->playerMaxX) {
+        grid->playerMaxX = player->world.pos.x;
+    }
+    if (player->world.pos.z < grid->playerMinZ) {
+        grid->playerMinZ = player->world.pos.z;
+    }
+    if (player->world.pos.z > grid->playerMaxZ) {
+        grid->playerMaxZ = player->world.pos.z;
+    }
+}
+
+/**
+ * Collects the actors of the given categories in the cells within `radius` of (`x`, `z`). Some of them may be further
+ * than `radius`, the caller has to check the distance.
+ *
+ * @return the actors, in a buffer reused by the next call
+ */
+Actor** ActorGrid_Gather(ActorContext* actorCtx, f32 x, f32 z, f32 radius, u32 categoryMask, s32* outCount) {
+    ActorGrid* grid = &actorCtx->grid;
+    s32 minCellX = ActorGrid_GetCell(x - radius);
+    s32 maxCellX = ActorGrid_GetCell(x + radius);
+    s32 minCellZ = ActorGrid_GetCell(z - radius);
+    s32 maxCellZ = ActorGrid_GetCell(z + radius);
+    s32 count = 0;
+    s32 cellX;
+    s32 cellZ;
+    s32 i;
+    Actor* actor;
+
+    if (radius < 0.0f) {
+        *outCount = 0;
+        return sActorGridCandidates;
+    }
+
+    if ((maxCellX - minCellX >= ACTOR_GRID_WRAP) || (maxCellZ - minCellZ >= ACTOR_GRID_WRAP)) {
+        // More cells than buckets, go through every bucket once
+        for (i = 0; i < ACTOR_GRID_BUCKETS; i++) {
+            for (actor = grid->buckets[i]; actor != NULL; actor = actor->gridNext) {
+                if ((actor->gridCellX >= minCellX) && (actor->gridCellX <= maxCellX) &&
+                    (actor->gridCellZ >= minCellZ) && (actor->gridCellZ <= maxCellZ) &&
+                    (categoryMask & ACTOR_GRID_CATEGORY_BIT(actor->category))) {
+                    sActorGridCandidates[count++] = actor;
+                }
+            }
+        }
+    } else {
+        // Each cell is in a different bucket, skip the actors of the other cells of that bucket
+        for (cellZ = minCellZ; cellZ <= maxCellZ; cellZ++) {
+            for (cellX = minCellX; cellX <= maxCellX; cellX++) {
+                for (actor = grid->buckets[ACTOR_GRID_BUCKET(cellX, cellZ)]; actor != NULL; actor = actor->gridNext) {
+                    if ((actor->gridCellX == cellX) && (actor->gridCellZ == cellZ) &&
+                        (categoryMask & ACTOR_GRID_CATEGORY_BIT(actor->category))) {
+                        sActorGridCandidates[count++] = actor;
+                    }
+                }
+            }
+        }
+    }
+
+#if DEBUG_FEATURES
+    sActorGridStats.queries++;
+    sActorGridStats.candidates += count;
+    for (i = 0; i < ARRAY_COUNT(actorCtx->actorLists); i++) {
+        if (categoryMask & ACTOR_GRID_CATEGORY_BIT(i)) {
+            sActorGridStats.listActors += actorCtx->actorLists[i].length;
+        }
+    }
+#endif
+
+    *outCount = count;
+    return sActorGridCandidates;
+}
+
+#if DEBUG_FEATURES
+/**
+ * Spawns green rupees in a square around Player, up to the actor limit, to measure the grid with many actors.
+ * Set KREG(0) to -101 to use it.
+ */
+void ActorGrid_SpawnBenchmark(PlayState* play) {
+    Player* player = GET_PLAYER(play);
+    s32 count = ACTOR_NUMBER_MAX - play->actorCtx.total;
+    s32 side;
+    s32 i;
+
+    for (side = 1; SQ(side) < count; side++) {}
+
+    PRINTF(T("アクターグリッド ベンチマーク: %d 個\n", "Actor grid benchmark: %d actors\n"), count);
+
+    for (i = 0; i < count; i++) {
+        Actor_Spawn(&play->actorCtx, play, ACTOR_EN_ITEM00,
+                    player->actor.world.pos.x + ((i % side) - side / 2) * 200.0f, player->actor.world.pos.y + 50.0f,
+                    player->actor.world.pos.z + ((i / side) - side / 2) * 200.0f, 0, 0, 0, ITEM00_RUPEE_GREEN);
+    }
+}
+
+void ActorGrid_Display(void) {
+    ActorGridStats* stats = &sActorGridStats;
+
+    PRINTF("actor grid: queries %d, actors visited %d (category lists %d)\n", stats->queries, stats->candidates,
+           stats->listActors);
+}
+#endif
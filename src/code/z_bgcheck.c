@@ -38,6 +38,13 @@ s32 BgCheck_CheckLineAgainstDyna(CollisionContext* colCtx, u16 xpFlags, Vec3f* p
 s32 BgCheck_SphVsFirstDynaPoly(CollisionContext* colCtx, u16 xpFlags, CollisionPoly** outPoly, s32* outBgId,
                                Vec3f* center, f32 radius, Actor* actor, u16 bciFlags);
 void BgCheck_ResetPolyCheckTbl(SSNodeList* nodeList, s32 numPolys);
+#if COLLISION_BVH
+void BgCheck_LoadStaticLookup(CollisionContext* colCtx, StaticLookup* lookup);
+void BgCheck_BuildStaticLookupFromBvh(CollisionContext* colCtx, StaticLookup* lookup);
+#endif
+#if COLLISION_BAKED_LOOKUP
+void SSNodeList_SetBakedNodes(PlayState* play, SSNodeList* this, CollisionBakedLookup* bakedLookup, s32 numPolys);
+#endif
 
 #define SS_NULL 0xFFFF
 
@@ -66,6 +73,36 @@ void BgCheck_ResetPolyCheckTbl(SSNodeList* nodeList, s32 numPolys);
 // raycast down groundChk flag. When enabled, search range is limited to floors and walls with a normal.y >= 0
 #define BGCHECK_GROUND_CHECK_ON (1 << 0)
 
+#if COLLISION_BVH
+// Depth of the CollisionBvh traversal stack, the asset extraction keeps the trees shallower
+#define BGCHECK_BVH_STACK_MAX 48
+
+// Time BgCheck_BuildPendingStaticLookups may spend each frame
+#define BGCHECK_BVH_FRAME_BUILD_TIME OS_USEC_TO_CYCLES(500)
+
+// One byte per StaticLookup, set once its lists were built from the scene's CollisionBvh. NULL without a CollisionBvh,
+// or once they are all built.
+static u8* sStaticLookupBuilt = NULL;
+// The polys found for the StaticLookup being built, in ascending order
+static u16* sStaticLookupPolyIds;
+// Index of the next StaticLookup for BgCheck_BuildPendingStaticLookups to build
+static s32 sStaticLookupNextBuild;
+
+#if DEBUG_FEATURES
+// Since the scene was loaded
+typedef struct BgCheckBvhStats {
+    /* 0x00 */ OSTime loadTime; // Time BgCheck_Allocate took to set up the StaticLookup table
+    /* 0x08 */ OSTime lookupBuildTime; // Time spent building subdivisions when first looked up
+    /* 0x10 */ OSTime lookupBuildMaxTime; // Longest of these, the worst hitch in a frame
+    /* 0x18 */ OSTime frameBuildTime; // Time spent in BgCheck_BuildPendingStaticLookups
+    /* 0x20 */ u32 lookupBuilds;
+    /* 0x24 */ u32 frameBuilds;
+} BgCheckBvhStats; // size = 0x28
+
+static BgCheckBvhStats sBgCheckBvhStats;
+#endif
+#endif
+
 s32 D_80119D90[WALL_TYPE_MAX] = {
     0,                         // WALL_TYPE_0
     WALL_FLAG_0,               // WALL_TYPE_1
@@ -1033,6 +1070,10 @@ s32 BgCheck_CheckLineInSubdivision(StaticLookup* lookup, CollisionContext* colCt
                                    f32* outDistSq, u32 bccFlags) {
     s32 result = false;
 
+#if COLLISION_BVH
+    BgCheck_LoadStaticLookup(colCtx, lookup);
+#endif
+
     if ((bccFlags & BGCHECK_CHECK_FLOOR) && lookup->floor.head != SS_NULL) {
         if (BgCheck_CheckLineAgainstSSList(&lookup->floor, colCtx, xpFlags1, xpFlags2, posA, posB, outPos, outPoly,
                                            outDistSq, chkDist, bccFlags)) {
@@ -1126,6 +1167,33 @@ s32 BgCheck_SphVsFirstStaticPoly(StaticLookup* lookup, u16 xpFlags, CollisionCon
     return false;
 }
 
+#if COLLISION_BVH
+/**
+ * Build the lists of `lookup` from the scene's CollisionBvh if they were not built yet
+ */
+void BgCheck_LoadStaticLookup(CollisionContext* colCtx, StaticLookup* lookup) {
+#if DEBUG_FEATURES
+    OSTime startTime;
+    OSTime time;
+#endif
+
+    if ((sStaticLookupBuilt != NULL) && !sStaticLookupBuilt[lookup - colCtx->lookupTbl]) {
+#if DEBUG_FEATURES
+        startTime = osGetTime();
+#endif
+        BgCheck_BuildStaticLookupFromBvh(colCtx, lookup);
+#if DEBUG_FEATURES
+        time = osGetTime() - startTime;
+        sBgCheckBvhStats.lookupBuilds++;
+        sBgCheckBvhStats.lookupBuildTime += time;
+        if (time > sBgCheckBvhStats.lookupBuildMaxTime) {
+            sBgCheckBvhStats.lookupBuildMaxTime = time;
+        }
+#endif
+    }
+}
+#endif
+
 /**
  * Get StaticLookup from `pos`
  * Does not return NULL
@@ -1133,10 +1201,19 @@ s32 BgCheck_SphVsFirstStaticPoly(StaticLookup* lookup, u16 xpFlags, CollisionCon
 StaticLookup* BgCheck_GetNearestStaticLookup(CollisionContext* colCtx, StaticLookup* lookupTbl, Vec3f* pos) {
     Vec3i sector;
     s32 subdivAmountX;
+#if COLLISION_BVH
+    StaticLookup* lookup;
+#endif
 
     BgCheck_GetStaticLookupIndicesFromPos(colCtx, pos, &sector);
     subdivAmountX = colCtx->subdivAmount.x;
+#if COLLISION_BVH
+    lookup = (sector.z * subdivAmountX) * colCtx->subdivAmount.y + lookupTbl + sector.x + sector.y * subdivAmountX;
+    BgCheck_LoadStaticLookup(colCtx, lookup);
+    return lookup;
+#else
     return (sector.z * subdivAmountX) * colCtx->subdivAmount.y + lookupTbl + sector.x + sector.y * subdivAmountX;
+#endif
 }
 
 /**
@@ -1146,13 +1223,22 @@ StaticLookup* BgCheck_GetNearestStaticLookup(CollisionContext* colCtx, StaticLoo
 StaticLookup* BgCheck_GetStaticLookup(CollisionContext* colCtx, StaticLookup* lookupTbl, Vec3f* pos) {
     Vec3i sector;
     s32 subdivAmountX;
+#if COLLISION_BVH
+    StaticLookup* lookup;
+#endif
 
     if (!BgCheck_PosInStaticBoundingBox(colCtx, pos)) {
         return NULL;
     }
     BgCheck_GetStaticLookupIndicesFromPos(colCtx, pos, &sector);
     subdivAmountX = colCtx->subdivAmount.x;
+#if COLLISION_BVH
+    lookup = (sector.z * subdivAmountX) * colCtx->subdivAmount.y + lookupTbl + sector.x + sector.y * subdivAmountX;
+    BgCheck_LoadStaticLookup(colCtx, lookup);
+    return lookup;
+#else
     return (sector.z * subdivAmountX) * colCtx->subdivAmount.y + lookupTbl + sector.x + sector.y * subdivAmountX;
+#endif
 }
 
 /**
@@ -1478,6 +1564,285 @@ u32 BgCheck_InitializeStaticLookup(CollisionContext* colCtx, PlayState* play, St
     return colCtx->polyNodes.count * sizeof(SSNode);
 }
 
+#if COLLISION_BVH
+/**
+ * Initialize StaticLookup Table for a scene with a CollisionBvh
+ * Each StaticLookup is left empty until its first lookup, see BgCheck_BuildStaticLookupFromBvh
+ */
+void BgCheck_InitializeBvhLookup(CollisionContext* colCtx, PlayState* play, StaticLookup* lookupTbl) {
+    s32 lookupMax = colCtx->subdivAmount.x * colCtx->subdivAmount.y * colCtx->subdivAmount.z;
+    s32 i;
+
+    sStaticLookupBuilt = GAME_STATE_ALLOC(&play->state, lookupMax, "../z_bgcheck.c", __LINE__);
+    sStaticLookupPolyIds =
+        GAME_STATE_ALLOC(&play->state, colCtx->colHeader->numPolygons * sizeof(u16), "../z_bgcheck.c", __LINE__);
+
+    ASSERT((sStaticLookupBuilt != NULL) && (sStaticLookupPolyIds != NULL),
+           "sStaticLookupBuilt != NULL && sStaticLookupPolyIds != NULL", "../z_bgcheck.c", __LINE__);
+
+    for (i = 0; i < lookupMax; i++) {
+        lookupTbl[i].floor.head = SS_NULL;
+        lookupTbl[i].wall.head = SS_NULL;
+        lookupTbl[i].ceiling.head = SS_NULL;
+        sStaticLookupBuilt[i] = false;
+    }
+    sStaticLookupNextBuild = 0;
+    PRINTF("BgCheck_InitializeBvhLookup(): %d nodes, %d polys\n", colCtx->colHeader->bvh->numNodes,
+           colCtx->colHeader->numPolygons);
+}
+
+/**
+ * Build the StaticLookup subdivisions that were not looked up yet, for up to BGCHECK_BVH_FRAME_BUILD_TIME each frame,
+ * so that fewer of them are left to build in the middle of a lookup. Once they are all built, lookups stop checking.
+ */
+void BgCheck_BuildPendingStaticLookups(CollisionContext* colCtx) {
+    s32 lookupMax;
+    OSTime startTime;
+
+    if (sStaticLookupBuilt == NULL) {
+        return;
+    }
+
+    lookupMax = colCtx->subdivAmount.x * colCtx->subdivAmount.y * colCtx->subdivAmount.z;
+    startTime = osGetTime();
+
+    while (sStaticLookupNextBuild < lookupMax) {
+        if (!sStaticLookupBuilt[sStaticLookupNextBuild]) {
+            BgCheck_BuildStaticLookupFromBvh(colCtx, &colCtx->lookupTbl[sStaticLookupNextBuild]);
+#if DEBUG_FEATURES
+            sBgCheckBvhStats.frameBuilds++;
+#endif
+        }
+        sStaticLookupNextBuild++;
+
+        if (osGetTime() - startTime >= BGCHECK_BVH_FRAME_BUILD_TIME) {
+            break;
+        }
+    }
+
+#if DEBUG_FEATURES
+    sBgCheckBvhStats.frameBuildTime += osGetTime() - startTime;
+#endif
+
+    if (sStaticLookupNextBuild >= lookupMax) {
+        PRINTF("BgCheck_BuildPendingStaticLookups(): all %d subdivisions built\n", lookupMax);
+        sStaticLookupBuilt = NULL;
+    }
+}
+
+#if DEBUG_FEATURES
+void BgCheck_DisplayBvhStats(void) {
+    BgCheckBvhStats* stats = &sBgCheckBvhStats;
+
+    PRINTF("bgcheck bvh: load %d us, %d built on lookup in %d us (longest %d us), %d built between frames in %d us%s\n",
+           (u32)OS_CYCLES_TO_USEC(stats->loadTime), stats->lookupBuilds,
+           (u32)OS_CYCLES_TO_USEC(stats->lookupBuildTime), (u32)OS_CYCLES_TO_USEC(stats->lookupBuildMaxTime),
+           stats->frameBuilds, (u32)OS_CYCLES_TO_USEC(stats->frameBuildTime),
+           (sStaticLookupBuilt == NULL) ? "" : ", building");
+}
+#endif
+
+/**
+ * Build the lists of `lookup` from the scene's CollisionBvh
+ * Only the polys of the leaves near the subdivision are tested, and they are added in ascending poly id order so the
+ * lists are the same as the ones BgCheck_InitializeStaticLookup builds.
+ */
+void BgCheck_BuildStaticLookupFromBvh(CollisionContext* colCtx, StaticLookup* lookup) {
+    CollisionHeader* colHeader = colCtx->colHeader;
+    CollisionBvh* bvh = colHeader->bvh;
+    CollisionPoly* polyList = colHeader->polyList;
+    Vec3s* vtxList = colHeader->vtxList;
+    CollisionBvhNode* node;
+    u16 stack[BGCHECK_BVH_STACK_MAX];
+    s32 stackCount;
+    s32 lookupIdx = lookup - colCtx->lookupTbl;
+    s32 subdivAmountXY = colCtx->subdivAmount.x * colCtx->subdivAmount.y;
+    s32 sx;
+    s32 sy;
+    s32 sz;
+    s32 sxMin;
+    s32 syMin;
+    s32 szMin;
+    s32 sxMax;
+    s32 syMax;
+    s32 szMax;
+    Vec3f subdivMin;
+    Vec3f subdivMax;
+    Vec3f searchMin;
+    Vec3f searchMax;
+    s32 count;
+    s32 i;
+    s32 j;
+    s16 polyId;
+
+    sStaticLookupBuilt[lookupIdx] = true;
+
+    sz = lookupIdx / subdivAmountXY;
+    sy = (lookupIdx % subdivAmountXY) / colCtx->subdivAmount.x;
+    sx = lookupIdx % colCtx->subdivAmount.x;
+
+    // Same bounds as the subdivision in BgCheck_InitializeStaticLookup
+    subdivMin.x = (colCtx->subdivLength.x * sx + colCtx->minBounds.x) - BGCHECK_SUBDIV_OVERLAP;
+    subdivMin.y = (colCtx->subdivLength.y * sy + colCtx->minBounds.y) - BGCHECK_SUBDIV_OVERLAP;
+    subdivMin.z = (colCtx->subdivLength.z * sz + colCtx->minBounds.z) - BGCHECK_SUBDIV_OVERLAP;
+    subdivMax.x = subdivMin.x + (colCtx->subdivLength.x + (2 * BGCHECK_SUBDIV_OVERLAP));
+    subdivMax.y = subdivMin.y + (colCtx->subdivLength.y + (2 * BGCHECK_SUBDIV_OVERLAP));
+    subdivMax.z = subdivMin.z + (colCtx->subdivLength.z + (2 * BGCHECK_SUBDIV_OVERLAP));
+
+    // BgCheck_GetPolySubdivisionBounds can round a poly's bounds one subdivision further out, so search one
+    // subdivision further out as well
+    searchMin.x = subdivMin.x - colCtx->subdivLength.x;
+    searchMin.y = subdivMin.y - colCtx->subdivLength.y;
+    searchMin.z = subdivMin.z - colCtx->subdivLength.z;
+    searchMax.x = subdivMax.x + colCtx->subdivLength.x;
+    searchMax.y = subdivMax.y + colCtx->subdivLength.y;
+    searchMax.z = subdivMax.z + colCtx->subdivLength.z;
+
+    count = 0;
+    stackCount = 0;
+    if (bvh->numNodes != 0) {
+        stack[stackCount++] = 0;
+    }
+
+    while (stackCount > 0) {
+        node = &bvh->nodes[stack[--stackCount]];
+
+        if ((node->min.x > searchMax.x) || (node->max.x < searchMin.x) || (node->min.y > searchMax.y) ||
+            (node->max.y < searchMin.y) || (node->min.z > searchMax.z) || (node->max.z < searchMin.z)) {
+            continue;
+        }
+
+        if (node->count == 0) {
+            ASSERT(stackCount + 2 <= BGCHECK_BVH_STACK_MAX, "stackCount + 2 <= BGCHECK_BVH_STACK_MAX",
+                   "../z_bgcheck.c", __LINE__);
+            stack[stackCount++] = node->start + 1;
+            stack[stackCount++] = node->start;
+            continue;
+        }
+
+        for (i = node->start; i < node->start + node->count; i++) {
+            polyId = bvh->polyIds[i];
+
+            // BgCheck_InitializeStaticLookup only tests the subdivisions in the poly's subdivision bounds
+            BgCheck_GetPolySubdivisionBounds(colCtx, vtxList, polyList, &sxMin, &syMin, &szMin, &sxMax, &syMax,
+                                             &szMax, polyId);
+            if ((sx < sxMin) || (sx > sxMax) || (sy < syMin) || (sy > syMax) || (sz < szMin) || (sz > szMax) ||
+                !BgCheck_PolyIntersectsSubdivision(&subdivMin, &subdivMax, polyList, vtxList, polyId)) {
+                continue;
+            }
+
+            for (j = count; (j > 0) && (sStaticLookupPolyIds[j - 1] > polyId); j--) {
+                sStaticLookupPolyIds[j] = sStaticLookupPolyIds[j - 1];
+            }
+            sStaticLookupPolyIds[j] = polyId;
+            count++;
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        StaticLookup_AddPoly(lookup, colCtx, polyList, vtxList, sStaticLookupPolyIds[i]);
+    }
+}
+#endif
+
+#if COLLISION_BAKED_LOOKUP
+/**
+ * Get the scene's CollisionBakedLookup
+ * returns NULL if there is none, or if it was baked for other subdivisions than the ones of `colCtx`
+ */
+CollisionBakedLookup* BgCheck_GetBakedLookup(CollisionContext* colCtx) {
+    CollisionBakedLookup* bakedLookup = colCtx->colHeader->bakedLookup;
+
+    if (bakedLookup == NULL) {
+        return NULL;
+    }
+    if ((bakedLookup->subdivAmount.x != colCtx->subdivAmount.x) ||
+        (bakedLookup->subdivAmount.y != colCtx->subdivAmount.y) ||
+        (bakedLookup->subdivAmount.z != colCtx->subdivAmount.z)) {
+        PRINTF("BgCheck_GetBakedLookup(): baked for %d %d %d subdivisions, not %d %d %d\n",
+               bakedLookup->subdivAmount.x, bakedLookup->subdivAmount.y, bakedLookup->subdivAmount.z,
+               colCtx->subdivAmount.x, colCtx->subdivAmount.y, colCtx->subdivAmount.z);
+        return NULL;
+    }
+    return bakedLookup;
+}
+
+#if COLLISION_BAKED_LOOKUP_CHECK
+/**
+ * Test if the StaticLookup tables `lookupTbl` and `colCtx->polyNodes` are the same as `bakedLookup`
+ */
+s32 BgCheck_IsBakedLookupSame(CollisionContext* colCtx, StaticLookup* lookupTbl, CollisionBakedLookup* bakedLookup) {
+    s32 lookupMax = colCtx->subdivAmount.x * colCtx->subdivAmount.y * colCtx->subdivAmount.z;
+    SSNode* node;
+    SSNode* bakedNode;
+    s32 i;
+
+    if (colCtx->polyNodes.count != bakedLookup->numNodes) {
+        PRINTF("BgCheck_IsBakedLookupSame(): %d nodes, %d baked nodes\n", colCtx->polyNodes.count,
+               bakedLookup->numNodes);
+        return false;
+    }
+
+    for (i = 0; i < lookupMax; i++) {
+        if ((lookupTbl[i].floor.head != bakedLookup->lookupTbl[i].floor.head) ||
+            (lookupTbl[i].wall.head != bakedLookup->lookupTbl[i].wall.head) ||
+            (lookupTbl[i].ceiling.head != bakedLookup->lookupTbl[i].ceiling.head)) {
+            PRINTF("BgCheck_IsBakedLookupSame(): lookup %d differs\n", i);
+            return false;
+        }
+    }
+
+    for (i = 0; i < bakedLookup->numNodes; i++) {
+        node = &colCtx->polyNodes.tbl[i];
+        bakedNode = &bakedLookup->nodes[i];
+        if ((node->polyId != bakedNode->polyId) || (node->next != bakedNode->next)) {
+            PRINTF("BgCheck_IsBakedLookupSame(): node %d differs\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Check the scene's CollisionBakedLookup against the tables BgCheck_InitializeStaticLookup builds
+ * If they differ, the built tables are used instead of the baked ones
+ */
+void BgCheck_CheckBakedLookup(CollisionContext* colCtx, PlayState* play, CollisionBakedLookup* bakedLookup,
+                              s32 tblMax) {
+    StaticLookup* lookupTbl;
+    SSNode* nodeTbl;
+
+    lookupTbl = THA_AllocTailAlign(&play->state.tha,
+                                   colCtx->subdivAmount.x * sizeof(StaticLookup) * colCtx->subdivAmount.y *
+                                       colCtx->subdivAmount.z,
+                                   ALIGNOF_MASK(StaticLookup));
+    nodeTbl = THA_AllocTailAlign(&play->state.tha, tblMax * sizeof(SSNode), ALIGNOF_MASK(SSNode));
+
+    ASSERT((lookupTbl != NULL) && (nodeTbl != NULL), "lookupTbl != NULL && nodeTbl != NULL", "../z_bgcheck.c",
+           __LINE__);
+
+    colCtx->polyNodes.max = tblMax;
+    colCtx->polyNodes.count = 0;
+    colCtx->polyNodes.tbl = nodeTbl;
+    BgCheck_InitializeStaticLookup(colCtx, play, lookupTbl);
+
+    if (!BgCheck_IsBakedLookupSame(colCtx, lookupTbl, bakedLookup)) {
+        PRINTF_COLOR_ERROR();
+        PRINTF("BgCheck_CheckBakedLookup(): the baked lookup differs, using the built one\n");
+        PRINTF_RST();
+        colCtx->lookupTbl = lookupTbl;
+        return;
+    }
+
+    PRINTF("BgCheck_CheckBakedLookup(): the baked lookup is the same, %d nodes\n", bakedLookup->numNodes);
+    colCtx->lookupTbl = bakedLookup->lookupTbl;
+    colCtx->polyNodes.max = bakedLookup->numNodes;
+    colCtx->polyNodes.count = bakedLookup->numNodes;
+    colCtx->polyNodes.tbl = bakedLookup->nodes;
+}
+#endif
+#endif
+
 /**
  * Is current scene a SPOT scene
  */
@@ -1560,6 +1925,9 @@ void BgCheck_Allocate(CollisionContext* colCtx, PlayState* play, CollisionHeader
     u32 customMemSize;
     s32 useCustomSubdivisions;
     s32 i;
+#if COLLISION_BAKED_LOOKUP
+    CollisionBakedLookup* bakedLookup;
+#endif
 
     colCtx->colHeader = colHeader;
     customNodeListMax = -1;
@@ -1619,10 +1987,23 @@ void BgCheck_Allocate(CollisionContext* colCtx, PlayState* play, CollisionHeader
             colCtx->subdivAmount.z = 16;
         }
     }
+#if COLLISION_BAKED_LOOKUP
+    bakedLookup = BgCheck_GetBakedLookup(colCtx);
+    if (bakedLookup != NULL) {
+        // The StaticLookup tables were built by the asset extraction, so they are used as they are
+        colCtx->lookupTbl = bakedLookup->lookupTbl;
+    } else {
+        colCtx->lookupTbl = THA_AllocTailAlign(&play->state.tha,
+                                               colCtx->subdivAmount.x * sizeof(StaticLookup) *
+                                                   colCtx->subdivAmount.y * colCtx->subdivAmount.z,
+                                               ALIGNOF_MASK(StaticLookup));
+    }
+#else
     colCtx->lookupTbl = THA_AllocTailAlign(&play->state.tha,
                                            colCtx->subdivAmount.x * sizeof(StaticLookup) * colCtx->subdivAmount.y *
                                                colCtx->subdivAmount.z,
                                            ALIGNOF_MASK(StaticLookup));
+#endif
 
     if (colCtx->lookupTbl == NULL) {
         LogUtils_HungupThread("../z_bgcheck.c", LN1(4173, 4176));
@@ -1657,9 +2038,43 @@ void BgCheck_Allocate(CollisionContext* colCtx, PlayState* play, CollisionHeader
     }
 
     SSNodeList_Initialize(&colCtx->polyNodes);
+#if COLLISION_BAKED_LOOKUP
+    if (bakedLookup != NULL) {
+        SSNodeList_SetBakedNodes(play, &colCtx->polyNodes, bakedLookup, colCtx->colHeader->numPolygons);
+#if COLLISION_BVH
+        sStaticLookupBuilt = NULL;
+#endif
+#if COLLISION_BAKED_LOOKUP_CHECK
+        BgCheck_CheckBakedLookup(colCtx, play, bakedLookup, tblMax);
+#endif
+        PRINTF("BgCheck_Allocate(): baked lookup, %d nodes\n", colCtx->polyNodes.count);
+
+        DynaPoly_Init(play, &colCtx->dyna);
+        DynaPoly_Alloc(play, &colCtx->dyna);
+        return;
+    }
+#endif
     SSNodeList_Alloc(play, &colCtx->polyNodes, tblMax, colCtx->colHeader->numPolygons);
 
+#if COLLISION_BVH
+#if DEBUG_FEATURES
+    bzero(&sBgCheckBvhStats, sizeof(BgCheckBvhStats));
+    sBgCheckBvhStats.loadTime = osGetTime();
+#endif
+    sStaticLookupBuilt = NULL;
+    if (colCtx->colHeader->bvh != NULL) {
+        // The subdivisions are built when first looked up, or between frames, see BgCheck_BuildPendingStaticLookups
+        BgCheck_InitializeBvhLookup(colCtx, play, colCtx->lookupTbl);
+        lookupTblMemSize = 0;
+    } else {
+        lookupTblMemSize = BgCheck_InitializeStaticLookup(colCtx, play, colCtx->lookupTbl);
+    }
+#if DEBUG_FEATURES
+    sBgCheckBvhStats.loadTime = osGetTime() - sBgCheckBvhStats.loadTime;
+#endif
+#else
     lookupTblMemSize = BgCheck_InitializeStaticLookup(colCtx, play, colCtx->lookupTbl);
+#endif
     PRINTF_COLOR_GREEN();
     PRINTF(T("/*---結局 BG使用サイズ %dbyte---*/\n", "/*---BG size used in the end %dbyte---*/\n"),
            memSize + lookupTblMemSize);
@@ -2541,6 +2956,21 @@ void SSNodeList_Alloc(PlayState* play, SSNodeList* this, s32 tblMax, s32 numPoly
     ASSERT(this->polyCheckTbl != NULL, "this->polygon_check != NULL", "../z_bgcheck.c", 5981);
 }
 
+#if COLLISION_BAKED_LOOKUP
+/**
+ * Set SSNodeList to the nodes of `bakedLookup`, which are used as they are
+ * numPolys is the number of polygons defined within the CollisionHeader
+ */
+void SSNodeList_SetBakedNodes(PlayState* play, SSNodeList* this, CollisionBakedLookup* bakedLookup, s32 numPolys) {
+    this->max = bakedLookup->numNodes;
+    this->count = bakedLookup->numNodes;
+    this->tbl = bakedLookup->nodes;
+    this->polyCheckTbl = GAME_STATE_ALLOC(&play->state, numPolys, "../z_bgcheck.c", __LINE__);
+
+    ASSERT(this->polyCheckTbl != NULL, "this->polygon_check != NULL", "../z_bgcheck.c", __LINE__);
+}
+#endif
+
 /**
  * Get next SSNodeList SSNode
  */
@@ -11,6 +11,7 @@
 #include "effect.h"
 #include "frame_advance.h"
 #include "zelda_arena.h"
+#include "zelda_pool.h"
 #include "play_state.h"
 
 #include "overlays/effects/ovl_Effect_Ss_HitMark/z_eff_ss_hitmark.h"
@@ -26,6 +27,45 @@ typedef s32 (*ColChkLineFunc)(PlayState*, CollisionCheckContext*, Collider*, Vec
 
 #define SAC_ENABLE (1 << 0)
 
+#if COLLISION_BROADPHASE || COLLISION_OC_SWEEP
+typedef struct ColChkBounds {
+    /* 0x00 */ Vec3f min;
+    /* 0x0C */ Vec3f max;
+} ColChkBounds; // size = 0x18
+
+typedef struct ColChkSweepEntry {
+    /* 0x00 */ ColChkBounds bounds; // bounds of the collider at this index of its list
+    /* 0x18 */ s16 sorted;          // index in its list of the collider at this position along x
+    /* 0x1A */ s16 rank;            // position along x of the collider at this index of its list, -1 if inactive
+    /* 0x1C */ u8 overlaps;         // set while the collider is a candidate pair of the one being tested
+} ColChkSweepEntry; // size = 0x20
+#endif
+
+#if COLLISION_BROADPHASE
+#if COLLISION_LIST_GROWTH
+ColChkSweepEntry sACSweepDefault[COLLISION_CHECK_AC_MAX];
+ColChkSweepEntry* sACSweep = sACSweepDefault;
+s32 sACSweepCapacity = COLLISION_CHECK_AC_MAX;
+#else
+ColChkSweepEntry sACSweep[COLLISION_CHECK_AC_MAX];
+#endif
+s32 sACSortedCount;
+#endif
+
+#if COLLISION_OC_SWEEP
+#if COLLISION_LIST_GROWTH
+ColChkSweepEntry sOCSweepDefault[COLLISION_CHECK_OC_MAX];
+ColChkSweepEntry* sOCSweep = sOCSweepDefault;
+s32 sOCSweepCapacity = COLLISION_CHECK_OC_MAX;
+#else
+ColChkSweepEntry sOCSweep[COLLISION_CHECK_OC_MAX];
+#endif
+// Kept from the previous frame, so that sorting again is cheap
+s32 sOCSortedCount;
+// Widest bounds along x this frame, to know how far back in the sorted list a collider can overlap
+f32 sOCMaxWidth;
+#endif
+
 #if DEBUG_FEATURES
 /**
  * Draws a red triangle with vertices vA, vB, and vC.
@@ -333,7 +373,7 @@ s32 Collider_FreeJntSph(PlayState* play, ColliderJntSph* jntSph) {
 
     jntSph->count = 0;
     if (jntSph->elements != NULL) {
-        ZELDA_ARENA_FREE(jntSph->elements, "../z_collision_check.c", 1393);
+        ZELDA_POOL_FREE(jntSph->elements, "../z_collision_check.c", 1393);
     }
     jntSph->elements = NULL;
     return true;
@@ -364,7 +404,7 @@ s32 Collider_SetJntSphToActor(PlayState* play, ColliderJntSph* dest, ColliderJnt
 
     Collider_SetBaseToActor(play, &dest->base, &src->base);
     dest->count = src->count;
-    dest->elements = ZELDA_ARENA_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1443);
+    dest->elements = ZELDA_POOL_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1443);
 
     if (dest->elements == NULL) {
         dest->count = 0;
@@ -392,7 +432,7 @@ s32 Collider_SetJntSphAllocType1(PlayState* play, ColliderJntSph* dest, Actor* a
 
     Collider_SetBaseType1(play, &dest->base, actor, &src->base);
     dest->count = src->count;
-    dest->elements = ZELDA_ARENA_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1490);
+    dest->elements = ZELDA_POOL_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1490);
 
     if (dest->elements == NULL) {
         dest->count = 0;
@@ -420,7 +460,7 @@ s32 Collider_SetJntSphAlloc(PlayState* play, ColliderJntSph* dest, Actor* actor,
 
     Collider_SetBase(play, &dest->base, actor, &src->base);
     dest->count = src->count;
-    dest->elements = ZELDA_ARENA_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1551);
+    dest->elements = ZELDA_POOL_MALLOC(src->count * sizeof(ColliderJntSphElement), "../z_collision_check.c", 1551);
 
     if (dest->elements == NULL) {
         dest->count = 0;
@@ -695,7 +735,7 @@ s32 Collider_FreeTris(PlayState* play, ColliderTris* tris) {
 
     tris->count = 0;
     if (tris->elements != NULL) {
-        ZELDA_ARENA_FREE(tris->elements, "../z_collision_check.c", 2099);
+        ZELDA_POOL_FREE(tris->elements, "../z_collision_check.c", 2099);
     }
     tris->elements = NULL;
     return true;
@@ -727,7 +767,7 @@ s32 Collider_SetTrisAllocType1(PlayState* play, ColliderTris* dest, Actor* actor
 
     Collider_SetBaseType1(play, &dest->base, actor, &src->base);
     dest->count = src->count;
-    dest->elements = ZELDA_ARENA_MALLOC(dest->count * sizeof(ColliderTrisElement), "../z_collision_check.c", 2156);
+    dest->elements = ZELDA_POOL_MALLOC(dest->count * sizeof(ColliderTrisElement), "../z_collision_check.c", 2156);
     if (dest->elements == NULL) {
         dest->count = 0;
         PRINTF_COLOR_RED();
@@ -753,7 +793,7 @@ s32 Collider_SetTrisAlloc(PlayState* play, ColliderTris* dest, Actor* actor, Col
 
     Collider_SetBase(play, &dest->base, actor, &src->base);
     dest->count = src->count;
-    dest->elements = ZELDA_ARENA_MALLOC(dest->count * sizeof(ColliderTrisElement), "../z_collision_check.c", 2207);
+    dest->elements = ZELDA_POOL_MALLOC(dest->count * sizeof(ColliderTrisElement), "../z_collision_check.c", 2207);
 
     if (dest->elements == NULL) {
         PRINTF_COLOR_RED();
@@ -1022,11 +1062,96 @@ s32 Collider_ResetLineOC(PlayState* play, OcLine* line) {
     return true;
 }
 
+#if COLLISION_LIST_GROWTH
+#if DEBUG_FEATURES
+typedef struct ColChkListStats {
+    /* 0x00 */ s32 atPeak; // most AT colliders registered in a frame
+    /* 0x04 */ s32 acPeak;
+    /* 0x08 */ s32 ocPeak;
+    /* 0x0C */ s32 grown;   // times a list had to grow
+    /* 0x10 */ s32 dropped; // colliders dropped because the Zelda arena was full
+} ColChkListStats; // size = 0x14
+
+ColChkListStats sColChkListStats;
+#endif
+
+/**
+ * Replaces `*buffer`, holding `*capacity` elements of `size` bytes, with a copy twice as large from the Zelda arena.
+ * `defaultBuffer` is the buffer it started as, which is not freed. Returns false if the arena is out of memory.
+ */
+s32 CollisionCheck_GrowBuffer(void** buffer, void* defaultBuffer, s32* capacity, u32 size) {
+    s32 newCapacity = *capacity * 2;
+    void* newBuffer = ZELDA_ARENA_MALLOC(newCapacity * size, "../z_collision_check.c", __LINE__);
+
+    if (newBuffer == NULL) {
+        return false;
+    }
+    bcopy(*buffer, newBuffer, *capacity * size);
+    if (*buffer != defaultBuffer) {
+        ZELDA_ARENA_FREE(*buffer, "../z_collision_check.c", __LINE__);
+    }
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+    return true;
+}
+
+void CollisionCheck_FreeBuffer(void** buffer, void* defaultBuffer, s32* capacity, s32 defaultCapacity) {
+    if (*buffer != defaultBuffer) {
+        ZELDA_ARENA_FREE(*buffer, "../z_collision_check.c", __LINE__);
+    }
+    *buffer = defaultBuffer;
+    *capacity = defaultCapacity;
+}
+
+/**
+ * Grows a full collider list. The lists start as the arrays in the context, sized for the original caps, and only move
+ * to the Zelda arena in the scenes that register more colliders in a frame. Returns false if the collider is dropped.
+ */
+s32 CollisionCheck_GrowList(Collider*** list, Collider** defaultList, s32* capacity, const char* name) {
+    if (!CollisionCheck_GrowBuffer((void**)list, defaultList, capacity, sizeof(Collider*))) {
+        PRINTF(VT_COL(RED, WHITE) "CollisionCheck: %s list full at %d colliders, out of memory\n" VT_RST, name,
+               *capacity);
+#if DEBUG_FEATURES
+        sColChkListStats.dropped++;
+#endif
+        return false;
+    }
+    PRINTF(VT_FGCOL(YELLOW) "CollisionCheck: %s list grown to %d colliders\n" VT_RST, name, *capacity);
+#if DEBUG_FEATURES
+    sColChkListStats.grown++;
+#endif
+    return true;
+}
+
+#if DEBUG_FEATURES
+/**
+ * Prints the most colliders registered in a frame and the capacity of each list, and how often the lists grew or had to
+ * drop a collider, since the last call.
+ */
+void CollisionCheck_DisplayListStats(CollisionCheckContext* colChkCtx) {
+    ColChkListStats* stats = &sColChkListStats;
+
+    PRINTF("collider lists: AT %d/%d AC %d/%d OC %d/%d, %d grown, %d dropped\n", stats->atPeak,
+           colChkCtx->colATCapacity, stats->acPeak, colChkCtx->colACCapacity, stats->ocPeak, colChkCtx->colOCCapacity,
+           stats->grown, stats->dropped);
+    bzero(stats, sizeof(ColChkListStats));
+}
+#endif
+#endif
+
 /**
  * Initializes CollisionCheckContext. Clears all collider arrays, disables SAC, and sets flags for drawing colliders.
  */
 void CollisionCheck_InitContext(PlayState* play, CollisionCheckContext* colChkCtx) {
     colChkCtx->sacFlags = 0;
+#if COLLISION_LIST_GROWTH
+    colChkCtx->colAT = colChkCtx->colATDefault;
+    colChkCtx->colATCapacity = COLLISION_CHECK_AT_MAX;
+    colChkCtx->colAC = colChkCtx->colACDefault;
+    colChkCtx->colACCapacity = COLLISION_CHECK_AC_MAX;
+    colChkCtx->colOC = colChkCtx->colOCDefault;
+    colChkCtx->colOCCapacity = COLLISION_CHECK_OC_MAX;
+#endif
     CollisionCheck_ClearContext(play, colChkCtx);
 
 #if DEBUG_FEATURES
@@ -1037,6 +1162,21 @@ void CollisionCheck_InitContext(PlayState* play, CollisionCheckContext* colChkCt
 }
 
 void CollisionCheck_DestroyContext(PlayState* play, CollisionCheckContext* colChkCtx) {
+#if COLLISION_LIST_GROWTH
+    CollisionCheck_FreeBuffer((void**)&colChkCtx->colAT, colChkCtx->colATDefault, &colChkCtx->colATCapacity,
+                              COLLISION_CHECK_AT_MAX);
+    CollisionCheck_FreeBuffer((void**)&colChkCtx->colAC, colChkCtx->colACDefault, &colChkCtx->colACCapacity,
+                              COLLISION_CHECK_AC_MAX);
+    CollisionCheck_FreeBuffer((void**)&colChkCtx->colOC, colChkCtx->colOCDefault, &colChkCtx->colOCCapacity,
+                              COLLISION_CHECK_OC_MAX);
+#if COLLISION_BROADPHASE
+    CollisionCheck_FreeBuffer((void**)&sACSweep, sACSweepDefault, &sACSweepCapacity, COLLISION_CHECK_AC_MAX);
+#endif
+#if COLLISION_OC_SWEEP
+    CollisionCheck_FreeBuffer((void**)&sOCSweep, sOCSweepDefault, &sOCSweepCapacity, COLLISION_CHECK_OC_MAX);
+    sOCSortedCount = 0;
+#endif
+#endif
 }
 
 /**
@@ -1047,10 +1187,28 @@ void CollisionCheck_ClearContext(PlayState* play, CollisionCheckContext* colChkC
     OcLine** lineP;
 
     if (!(colChkCtx->sacFlags & SAC_ENABLE)) {
+#if COLLISION_LIST_GROWTH && DEBUG_FEATURES
+        sColChkListStats.atPeak = MAX(sColChkListStats.atPeak, colChkCtx->colATCount);
+        sColChkListStats.acPeak = MAX(sColChkListStats.acPeak, colChkCtx->colACCount);
+        sColChkListStats.ocPeak = MAX(sColChkListStats.ocPeak, colChkCtx->colOCCount);
+#endif
         colChkCtx->colATCount = 0;
         colChkCtx->colACCount = 0;
         colChkCtx->colOCCount = 0;
         colChkCtx->colLineCount = 0;
+#if COLLISION_LIST_GROWTH
+        for (colP = colChkCtx->colAT; colP < colChkCtx->colAT + colChkCtx->colATCapacity; colP++) {
+            *colP = NULL;
+        }
+
+        for (colP = colChkCtx->colAC; colP < colChkCtx->colAC + colChkCtx->colACCapacity; colP++) {
+            *colP = NULL;
+        }
+
+        for (colP = colChkCtx->colOC; colP < colChkCtx->colOC + colChkCtx->colOCCapacity; colP++) {
+            *colP = NULL;
+        }
+#else
         for (colP = colChkCtx->colAT; colP < colChkCtx->colAT + COLLISION_CHECK_AT_MAX; colP++) {
             *colP = NULL;
         }
@@ -1062,6 +1220,7 @@ void CollisionCheck_ClearContext(PlayState* play, CollisionCheckContext* colChkC
         for (colP = colChkCtx->colOC; colP < colChkCtx->colOC + COLLISION_CHECK_OC_MAX; colP++) {
             *colP = NULL;
         }
+#endif
 
         for (lineP = colChkCtx->colLine; lineP < colChkCtx->colLine + COLLISION_CHECK_OC_LINE_MAX; lineP++) {
             *lineP = NULL;
@@ -1186,7 +1345,12 @@ s32 CollisionCheck_SetAT(PlayState* play, CollisionCheckContext* colChkCtx, Coll
     if (collider->actor != NULL && collider->actor->update == NULL) {
         return -1;
     }
+#if COLLISION_LIST_GROWTH
+    if ((colChkCtx->colATCount >= colChkCtx->colATCapacity) &&
+        !CollisionCheck_GrowList(&colChkCtx->colAT, colChkCtx->colATDefault, &colChkCtx->colATCapacity, "AT")) {
+#else
     if (colChkCtx->colATCount >= COLLISION_CHECK_AT_MAX) {
+#endif
         PRINTF(T("CollisionCheck_setAT():インデックスがオーバーして追加不能\n",
                  "CollisionCheck_setAT(): Index exceeded and cannot add more\n"));
         return -1;
@@ -1222,7 +1386,13 @@ s32 CollisionCheck_SetAT_SAC(PlayState* play, CollisionCheckContext* colChkCtx,
         }
         colChkCtx->colAT[index] = collider;
     } else {
+#if COLLISION_LIST_GROWTH
+        if ((colChkCtx->colATCount >= colChkCtx->colATCapacity) &&
+            !CollisionCheck_GrowList(&colChkCtx->colAT, colChkCtx->colATDefault, &colChkCtx->colATCapacity,
+                                     "AT")) {
+#else
         if (!(colChkCtx->colATCount < COLLISION_CHECK_AT_MAX)) {
+#endif
             PRINTF(T("CollisionCheck_setAT():インデックスがオーバーして追加不能\n",
                      "CollisionCheck_setAT(): Index exceeded and cannot add more\n"));
             return -1;
@@ -1255,7 +1425,12 @@ s32 CollisionCheck_SetAC(PlayState* play, CollisionCheckContext* colChkCtx, Coll
     if (collider->actor != NULL && collider->actor->update == NULL) {
         return -1;
     }
+#if COLLISION_LIST_GROWTH
+    if ((colChkCtx->colACCount >= colChkCtx->colACCapacity) &&
+        !CollisionCheck_GrowList(&colChkCtx->colAC, colChkCtx->colACDefault, &colChkCtx->colACCapacity, "AC")) {
+#else
     if (colChkCtx->colACCount >= COLLISION_CHECK_AC_MAX) {
+#endif
         PRINTF(T("CollisionCheck_setAC():インデックスがオーバして追加不能\n",
                  "CollisionCheck_setAC(): Index exceeded and cannot add more\n"));
         return -1;
@@ -1291,7 +1466,13 @@ s32 CollisionCheck_SetAC_SAC(PlayState* play, CollisionCheckContext* colChkCtx,
         }
         colChkCtx->colAC[index] = collider;
     } else {
+#if COLLISION_LIST_GROWTH
+        if ((colChkCtx->colACCount >= colChkCtx->colACCapacity) &&
+            !CollisionCheck_GrowList(&colChkCtx->colAC, colChkCtx->colACDefault, &colChkCtx->colACCapacity,
+                                     "AC")) {
+#else
         if (!(colChkCtx->colACCount < COLLISION_CHECK_AC_MAX)) {
+#endif
             PRINTF(T("CollisionCheck_setAC():インデックスがオーバして追加不能\n",
                      "CollisionCheck_setAC(): Index exceeded and cannot add more\n"));
             return -1;
@@ -1326,7 +1507,12 @@ s32 CollisionCheck_SetOC(PlayState* play, CollisionCheckContext* colChkCtx, Coll
     if (collider->actor != NULL && collider->actor->update == NULL) {
         return -1;
     }
+#if COLLISION_LIST_GROWTH
+    if ((colChkCtx->colOCCount >= colChkCtx->colOCCapacity) &&
+        !CollisionCheck_GrowList(&colChkCtx->colOC, colChkCtx->colOCDefault, &colChkCtx->colOCCapacity, "OC")) {
+#else
     if (colChkCtx->colOCCount >= COLLISION_CHECK_OC_MAX) {
+#endif
         PRINTF(T("CollisionCheck_setOC():インデックスがオーバして追加不能\n",
                  "CollisionCheck_setOC(): Index exceeded and cannot add more\n"));
         return -1;
@@ -1360,10 +1546,25 @@ s32 CollisionCheck_SetOC_SAC(PlayState* play, CollisionCheckContext* colChkCtx,
                      "number of data.\n"));
             return -1;
         }
+#if COLLISION_LIST_GROWTH
+        // The OC list can grow past the AT list, so the write below would no longer stay within colAT
+        if (!(index < colChkCtx->colATCapacity)) {
+            PRINTF(T("CollisionCheck_setOC_SAC():全データ数より大きいところに登録しようとしている。\n",
+                     "CollisionCheck_setOC_SAC(): You are trying to register a location that is larger than the total "
+                     "number of data.\n"));
+            return -1;
+        }
+#endif
         //! @bug Should be colOC
         colChkCtx->colAT[index] = collider;
     } else {
+#if COLLISION_LIST_GROWTH
+        if ((colChkCtx->colOCCount >= colChkCtx->colOCCapacity) &&
+            !CollisionCheck_GrowList(&colChkCtx->colOC, colChkCtx->colOCDefault, &colChkCtx->colOCCapacity,
+                                     "OC")) {
+#else
         if (!(colChkCtx->colOCCount < COLLISION_CHECK_OC_MAX)) {
+#endif
             PRINTF(T("CollisionCheck_setOC():インデックスがオーバして追加不能\n",
                      "CollisionCheck_setOC(): Index exceeded and cannot add more\n"));
             return -1;
@@ -2653,6 +2854,186 @@ static ColChkVsFunc sACVsFuncs[COLSHAPE_MAX][COLSHAPE_MAX] = {
     },
 };
 
+#if COLLISION_BROADPHASE || COLLISION_OC_SWEEP
+/**
+ * Bounding box padding, so that the float tolerances of the shape tests can never miss a pair the boxes rejected.
+ */
+#define COLCHK_BOUNDS_PAD 4.0f
+
+void CollisionCheck_BoundsAddPoint(ColChkBounds* bounds, f32 x, f32 y, f32 z, f32 radius) {
+    bounds->min.x = CLAMP_MAX(bounds->min.x, x - radius);
+    bounds->min.y = CLAMP_MAX(bounds->min.y, y - radius);
+    bounds->min.z = CLAMP_MAX(bounds->min.z, z - radius);
+    bounds->max.x = CLAMP_MIN(bounds->max.x, x + radius);
+    bounds->max.y = CLAMP_MIN(bounds->max.y, y + radius);
+    bounds->max.z = CLAMP_MIN(bounds->max.z, z + radius);
+}
+
+/**
+ * Computes the world space bounding box of all the elements of a collider. A collider without elements gets an empty
+ * box, which overlaps nothing.
+ */
+void CollisionCheck_GetBounds(Collider* col, ColChkBounds* bounds) {
+    s32 i;
+
+    bounds->min.x = bounds->min.y = bounds->min.z = MAXFLOAT;
+    bounds->max.x = bounds->max.y = bounds->max.z = -MAXFLOAT;
+
+    switch (col->shape) {
+        case COLSHAPE_JNTSPH: {
+            ColliderJntSph* jntSph = (ColliderJntSph*)col;
+            Sphere16* sphere;
+
+            if (jntSph->elements == NULL) {
+                return;
+            }
+            for (i = 0; i < jntSph->count; i++) {
+                sphere = &jntSph->elements[i].dim.worldSphere;
+                CollisionCheck_BoundsAddPoint(bounds, sphere->center.x, sphere->center.y, sphere->center.z,
+                                              ABS(sphere->radius) + COLCHK_BOUNDS_PAD);
+            }
+            break;
+        }
+
+        case COLSHAPE_CYLINDER: {
+            ColliderCylinder* cyl = (ColliderCylinder*)col;
+            f32 radius = ABS(cyl->dim.radius) + COLCHK_BOUNDS_PAD;
+            f32 bottom = cyl->dim.pos.y + cyl->dim.yShift;
+
+            CollisionCheck_BoundsAddPoint(bounds, cyl->dim.pos.x, bottom, cyl->dim.pos.z, radius);
+            CollisionCheck_BoundsAddPoint(bounds, cyl->dim.pos.x, bottom + cyl->dim.height, cyl->dim.pos.z, radius);
+            break;
+        }
+
+        case COLSHAPE_TRIS: {
+            ColliderTris* tris = (ColliderTris*)col;
+            Vec3f* vtx;
+            s32 j;
+
+            if (tris->elements == NULL) {
+                return;
+            }
+            for (i = 0; i < tris->count; i++) {
+                for (j = 0; j < 3; j++) {
+                    vtx = &tris->elements[i].dim.vtx[j];
+                    CollisionCheck_BoundsAddPoint(bounds, vtx->x, vtx->y, vtx->z, COLCHK_BOUNDS_PAD);
+                }
+            }
+            break;
+        }
+
+        case COLSHAPE_QUAD: {
+            ColliderQuad* quad = (ColliderQuad*)col;
+
+            for (i = 0; i < 4; i++) {
+                CollisionCheck_BoundsAddPoint(bounds, quad->dim.quad[i].x, quad->dim.quad[i].y, quad->dim.quad[i].z,
+                                              COLCHK_BOUNDS_PAD);
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+#endif
+
+#if COLLISION_BROADPHASE
+#if DEBUG_FEATURES
+typedef struct ColChkBroadphaseStats {
+    /* 0x00 */ u32 frames;
+    /* 0x04 */ u32 pairs;      // AT/AC pairs that would have been tested without the broadphase
+    /* 0x08 */ u32 dispatched; // AT/AC pairs whose bounds overlapped
+} ColChkBroadphaseStats; // size = 0x0C
+
+ColChkBroadphaseStats sBroadphaseStats;
+#endif
+
+/**
+ * Computes the bounds of every AC collider that can be hit this frame and sorts them along x. This is done here rather
+ * than when the colliders are registered, as actors may still move their colliders after CollisionCheck_SetAC, e.g.
+ * Player sets its sword quad when it draws. Returns false if there is no room to sort the list.
+ */
+s32 CollisionCheck_BroadphaseBegin(CollisionCheckContext* colChkCtx) {
+    Collider* acCol;
+    ColChkSweepEntry* entry;
+    s32 i;
+    s32 j;
+    f32 minX;
+
+#if COLLISION_LIST_GROWTH
+    while (sACSweepCapacity < colChkCtx->colACCount) {
+        if (!CollisionCheck_GrowBuffer((void**)&sACSweep, sACSweepDefault, &sACSweepCapacity,
+                                       sizeof(ColChkSweepEntry))) {
+            return false;
+        }
+    }
+#endif
+
+    sACSortedCount = 0;
+    for (i = 0; i < colChkCtx->colACCount; i++) {
+        acCol = colChkCtx->colAC[i];
+        entry = &sACSweep[i];
+        entry->overlaps = false;
+
+        if ((acCol == NULL) || !(acCol->acFlags & AC_ON) ||
+            ((acCol->actor != NULL) && (acCol->actor->update == NULL))) {
+            continue;
+        }
+        CollisionCheck_GetBounds(acCol, &entry->bounds);
+        minX = entry->bounds.min.x;
+
+        // Insertion sort, the list is only a few dozen colliders long
+        for (j = sACSortedCount; (j > 0) && (sACSweep[sACSweep[j - 1].sorted].bounds.min.x > minX); j--) {
+            sACSweep[j].sorted = sACSweep[j - 1].sorted;
+        }
+        sACSweep[j].sorted = i;
+        sACSortedCount++;
+    }
+    return true;
+}
+
+/**
+ * Flags the AC colliders whose bounds overlap those of the AT collider.
+ */
+void CollisionCheck_BroadphaseFindAC(ColChkBounds* atBounds) {
+    ColChkBounds* acBounds;
+    s32 i;
+    s32 index;
+
+    for (i = 0; i < sACSortedCount; i++) {
+        index = sACSweep[i].sorted;
+        acBounds = &sACSweep[index].bounds;
+
+        if (acBounds->min.x > atBounds->max.x) {
+            // Every remaining collider starts further along x
+            break;
+        }
+        if ((acBounds->max.x < atBounds->min.x) || (acBounds->min.y > atBounds->max.y) ||
+            (acBounds->max.y < atBounds->min.y) || (acBounds->min.z > atBounds->max.z) ||
+            (acBounds->max.z < atBounds->min.z)) {
+            continue;
+        }
+        sACSweep[index].overlaps = true;
+    }
+}
+
+#if DEBUG_FEATURES
+/**
+ * Prints how many AT/AC pairs were tested per frame with and without the broadphase since the last call.
+ */
+void CollisionCheck_DisplayBroadphaseStats(void) {
+    ColChkBroadphaseStats* stats = &sBroadphaseStats;
+
+    if (stats->frames != 0) {
+        PRINTF("collision broadphase: %d pairs tested of %d per frame\n", stats->dispatched / stats->frames,
+               stats->pairs / stats->frames);
+    }
+    bzero(stats, sizeof(ColChkBroadphaseStats));
+}
+#endif
+#endif
+
 /**
  * Iterates through all AC colliders, performing AC collisions with the AT collider.
  */
@@ -2677,6 +3058,43 @@ void CollisionCheck_AC(PlayState* play, CollisionCheckContext* colChkCtx, Collid
     }
 }
 
+#if COLLISION_BROADPHASE
+/**
+ * Same as CollisionCheck_AC, but only performs the AC collisions with the AC colliders whose bounds overlap the AT
+ * collider's. These are visited in the same order as CollisionCheck_AC would, so hits are resolved identically.
+ */
+void CollisionCheck_ACBroadphase(PlayState* play, CollisionCheckContext* colChkCtx, Collider* atCol) {
+    ColChkBounds atBounds;
+    Collider* acCol;
+    s32 i;
+
+    CollisionCheck_GetBounds(atCol, &atBounds);
+    CollisionCheck_BroadphaseFindAC(&atBounds);
+
+#if DEBUG_FEATURES
+    sBroadphaseStats.pairs += sACSortedCount;
+#endif
+
+    for (i = 0; i < colChkCtx->colACCount; i++) {
+        if (!sACSweep[i].overlaps) {
+            continue;
+        }
+        sACSweep[i].overlaps = false;
+        acCol = colChkCtx->colAC[i];
+
+        if ((acCol->acFlags & atCol->atFlags & AC_TYPE_ALL) && (atCol != acCol)) {
+            if (!(atCol->atFlags & AT_SELF) && atCol->actor != NULL && acCol->actor == atCol->actor) {
+                continue;
+            }
+#if DEBUG_FEATURES
+            sBroadphaseStats.dispatched++;
+#endif
+            sACVsFuncs[atCol->shape][acCol->shape](play, colChkCtx, atCol, acCol);
+        }
+    }
+}
+#endif
+
 /**
  * Iterates through all AT colliders, testing them for AC collisions with each AC collider, setting the info regarding
  * the collision for each AC and AT collider that collided. Then spawns hitmarks and plays sound effects for each
@@ -2686,10 +3104,19 @@ void CollisionCheck_AC(PlayState* play, CollisionCheckContext* colChkCtx, Collid
 void CollisionCheck_AT(PlayState* play, CollisionCheckContext* colChkCtx) {
     Collider** atColP;
     Collider* atCol;
+#if COLLISION_BROADPHASE
+    s32 broadphase;
+#endif
 
     if (colChkCtx->colATCount == 0 || colChkCtx->colACCount == 0) {
         return;
     }
+#if COLLISION_BROADPHASE
+    broadphase = CollisionCheck_BroadphaseBegin(colChkCtx);
+#if DEBUG_FEATURES
+    sBroadphaseStats.frames++;
+#endif
+#endif
     for (atColP = colChkCtx->colAT; atColP < colChkCtx->colAT + colChkCtx->colATCount; atColP++) {
         atCol = *atColP;
 
@@ -2697,6 +3124,12 @@ void CollisionCheck_AT(PlayState* play, CollisionCheckContext* colChkCtx) {
             if (atCol->actor != NULL && atCol->actor->update == NULL) {
                 continue;
             }
+#if COLLISION_BROADPHASE
+            if (broadphase) {
+                CollisionCheck_ACBroadphase(play, colChkCtx, atCol);
+                continue;
+            }
+#endif
             CollisionCheck_AC(play, colChkCtx, atCol);
         }
     }
@@ -2966,6 +3399,150 @@ static ColChkVsFunc sOCVsFuncs[COLSHAPE_MAX][COLSHAPE_MAX] = {
     },
 };
 
+#if COLLISION_OC_SWEEP
+#if DEBUG_FEATURES
+typedef struct ColChkOCSweepStats {
+    /* 0x00 */ u32 frames;
+    /* 0x04 */ u32 pairs;  // OC pairs that would have been tested without the sweep
+    /* 0x08 */ u32 tested; // OC pairs whose bounds overlapped
+} ColChkOCSweepStats; // size = 0x0C
+
+ColChkOCSweepStats sOCSweepStats;
+#endif
+
+/**
+ * Sorts the active OC colliders along x, starting from last frame's order as colliders mostly keep their index and
+ * barely move from one frame to the next. Returns false if there is no room to sort the list.
+ */
+s32 CollisionCheck_OCSweepBegin(CollisionCheckContext* colChkCtx) {
+    Collider* col;
+    ColChkSweepEntry* entry;
+    s32 count = colChkCtx->colOCCount;
+    s32 sortedCount = 0;
+    s32 index;
+    f32 minX;
+    s32 i;
+    s32 j;
+
+#if COLLISION_LIST_GROWTH
+    while (sOCSweepCapacity < count) {
+        if (!CollisionCheck_GrowBuffer((void**)&sOCSweep, sOCSweepDefault, &sOCSweepCapacity,
+                                       sizeof(ColChkSweepEntry))) {
+            sOCSortedCount = 0;
+            return false;
+        }
+    }
+#endif
+
+    for (i = 0; i < count; i++) {
+        sOCSweep[i].rank = -1;
+        sOCSweep[i].overlaps = false;
+    }
+
+    // Keep the previous order of the indices still in use, then append the others
+    for (i = 0; i < sOCSortedCount; i++) {
+        index = sOCSweep[i].sorted;
+        if (index < count) {
+            sOCSweep[sortedCount++].sorted = index;
+            sOCSweep[index].rank = 0;
+        }
+    }
+    for (i = 0; i < count; i++) {
+        if (sOCSweep[i].rank < 0) {
+            sOCSweep[sortedCount++].sorted = i;
+        }
+    }
+
+    // Inactive colliders are dropped from the order, and appended again once they are active
+    sOCSortedCount = 0;
+    sOCMaxWidth = 0.0f;
+    for (i = 0; i < sortedCount; i++) {
+        index = sOCSweep[i].sorted;
+        col = colChkCtx->colOC[index];
+        entry = &sOCSweep[index];
+        entry->rank = -1;
+        if ((col == NULL) || (CollisionCheck_SkipOC(col) == true)) {
+            continue;
+        }
+        CollisionCheck_GetBounds(col, &entry->bounds);
+        minX = entry->bounds.min.x;
+        if (entry->bounds.max.x - minX > sOCMaxWidth) {
+            sOCMaxWidth = entry->bounds.max.x - minX;
+        }
+
+        // Insertion sort, close to linear when the order has not changed
+        for (j = sOCSortedCount; (j > 0) && (sOCSweep[sOCSweep[j - 1].sorted].bounds.min.x > minX); j--) {
+            sOCSweep[j].sorted = sOCSweep[j - 1].sorted;
+        }
+        sOCSweep[j].sorted = index;
+        sOCSortedCount++;
+    }
+    for (i = 0; i < sOCSortedCount; i++) {
+        sOCSweep[sOCSweep[i].sorted].rank = i;
+    }
+
+#if DEBUG_FEATURES
+    sOCSweepStats.frames++;
+    sOCSweepStats.pairs += sOCSortedCount * (sOCSortedCount - 1) / 2;
+#endif
+    return true;
+}
+
+/**
+ * Flags the OC colliders after `left` in the list whose bounds overlap its own, sweeping both ways along x from it.
+ */
+void CollisionCheck_OCSweepFind(s32 left) {
+    ColChkBounds* bounds = &sOCSweep[left].bounds;
+    ColChkBounds* other;
+    s32 rank = sOCSweep[left].rank;
+    s32 index;
+    s32 i;
+
+    for (i = rank + 1; i < sOCSortedCount; i++) {
+        index = sOCSweep[i].sorted;
+        other = &sOCSweep[index].bounds;
+
+        if (other->min.x > bounds->max.x) {
+            // Every remaining collider starts further along x
+            break;
+        }
+        if ((index > left) && !((other->min.y > bounds->max.y) || (other->max.y < bounds->min.y) ||
+                                (other->min.z > bounds->max.z) || (other->max.z < bounds->min.z))) {
+            sOCSweep[index].overlaps = true;
+        }
+    }
+    for (i = rank - 1; i >= 0; i--) {
+        index = sOCSweep[i].sorted;
+        other = &sOCSweep[index].bounds;
+
+        if (other->min.x + sOCMaxWidth < bounds->min.x) {
+            // Every remaining collider ends before this one starts along x
+            break;
+        }
+        if ((index > left) && !((other->max.x < bounds->min.x) || (other->min.y > bounds->max.y) ||
+                                (other->max.y < bounds->min.y) || (other->min.z > bounds->max.z) ||
+                                (other->max.z < bounds->min.z))) {
+            sOCSweep[index].overlaps = true;
+        }
+    }
+}
+
+#if DEBUG_FEATURES
+/**
+ * Prints how many OC pairs were tested per frame, and how many the sweep culled, since the last call.
+ */
+void CollisionCheck_DisplayOCSweepStats(void) {
+    ColChkOCSweepStats* stats = &sOCSweepStats;
+
+    if (stats->frames != 0) {
+        PRINTF("collision oc sweep: %d pairs tested, %d culled per frame\n", stats->tested / stats->frames,
+               (stats->pairs - stats->tested) / stats->frames);
+    }
+    bzero(stats, sizeof(ColChkOCSweepStats));
+}
+#endif
+#endif
+
 /**
  * Iterates through all OC colliders and collides them with all subsequent OC colliders on the list. During an OC
  * collision, colliders with overlapping elements move away from each other so that their elements no longer overlap.
@@ -2977,12 +3554,30 @@ void CollisionCheck_OC(PlayState* play, CollisionCheckContext* colChkCtx) {
     Collider** leftColP;
     Collider** rightColP;
     ColChkVsFunc vsFunc;
+#if COLLISION_OC_SWEEP
+    s32 sweep = CollisionCheck_OCSweepBegin(colChkCtx);
+    ColChkSweepEntry* right;
+#endif
 
     for (leftColP = colChkCtx->colOC; leftColP < colChkCtx->colOC + colChkCtx->colOCCount; leftColP++) {
         if (*leftColP == NULL || CollisionCheck_SkipOC(*leftColP) == true) {
             continue;
         }
+#if COLLISION_OC_SWEEP
+        if (sweep) {
+            CollisionCheck_OCSweepFind(leftColP - colChkCtx->colOC);
+        }
+#endif
         for (rightColP = leftColP + 1; rightColP < colChkCtx->colOC + colChkCtx->colOCCount; rightColP++) {
+#if COLLISION_OC_SWEEP
+            if (sweep) {
+                right = &sOCSweep[rightColP - colChkCtx->colOC];
+                if (!right->overlaps) {
+                    continue;
+                }
+                right->overlaps = false;
+            }
+#endif
             if (*rightColP == NULL || CollisionCheck_SkipOC(*rightColP) == true ||
                 CollisionCheck_Incompatible(*leftColP, *rightColP) == true) {
                 continue;
@@ -2993,6 +3588,11 @@ void CollisionCheck_OC(PlayState* play, CollisionCheckContext* colChkCtx) {
                        (*leftColP)->shape, (*rightColP)->shape);
                 continue;
             }
+#if COLLISION_OC_SWEEP && DEBUG_FEATURES
+            if (sweep) {
+                sOCSweepStats.tested++;
+            }
+#endif
             vsFunc(play, colChkCtx, *leftColP, *rightColP);
         }
     }
@@ -1,4 +1,5 @@
 #include "libc64/os_malloc.h"
+#include "arena_trace.h"
 #include "printf.h"
 #include "translation.h"
 
@@ -32,6 +33,7 @@ void ZeldaArena_CheckPointer(void* ptr, u32 size, const char* name, const char*
 void* ZeldaArena_Malloc(u32 size) {
     void* ptr = __osMalloc(&sZeldaArena, size);
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_MALLOC, ptr, NULL, size, NULL, 0);
     // TODO re-evaluate "secure" as a translation (in this file and others using "確保")
     ZELDA_ARENA_CHECK_POINTER(ptr, size, "zelda_malloc", T("確保", "Secure"));
     return ptr;
@@ -41,6 +43,7 @@ void* ZeldaArena_Malloc(u32 size) {
 void* ZeldaArena_MallocDebug(u32 size, const char* file, int line) {
     void* ptr = __osMallocDebug(&sZeldaArena, size, file, line);
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_MALLOC, ptr, NULL, size, file, line);
     ZELDA_ARENA_CHECK_POINTER(ptr, size, "zelda_malloc_DEBUG", T("確保", "Secure"));
     return ptr;
 }
@@ -49,6 +52,7 @@ void* ZeldaArena_MallocDebug(u32 size, const char* file, int line) {
 void* ZeldaArena_MallocR(u32 size) {
     void* ptr = __osMallocR(&sZeldaArena, size);
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_MALLOC_R, ptr, NULL, size, NULL, 0);
     ZELDA_ARENA_CHECK_POINTER(ptr, size, "zelda_malloc_r", T("確保", "Secure"));
     return ptr;
 }
@@ -57,31 +61,44 @@ void* ZeldaArena_MallocR(u32 size) {
 void* ZeldaArena_MallocRDebug(u32 size, const char* file, int line) {
     void* ptr = __osMallocRDebug(&sZeldaArena, size, file, line);
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_MALLOC_R, ptr, NULL, size, file, line);
     ZELDA_ARENA_CHECK_POINTER(ptr, size, "zelda_malloc_r_DEBUG", T("確保", "Secure"));
     return ptr;
 }
 #endif
 
 void* ZeldaArena_Realloc(void* ptr, u32 newSize) {
+#if ARENA_TRACE_ENABLED
+    void* oldPtr = ptr;
+#endif
+
     ptr = __osRealloc(&sZeldaArena, ptr, newSize);
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_REALLOC, ptr, oldPtr, newSize, NULL, 0);
     ZELDA_ARENA_CHECK_POINTER(ptr, newSize, "zelda_realloc", T("再確保", "Re-securing"));
     return ptr;
 }
 
 #if DEBUG_FEATURES
 void* ZeldaArena_ReallocDebug(void* ptr, u32 newSize, const char* file, int line) {
+#if ARENA_TRACE_ENABLED
+    void* oldPtr = ptr;
+#endif
+
     ptr = __osReallocDebug(&sZeldaArena, ptr, newSize, file, line);
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_REALLOC, ptr, oldPtr, newSize, file, line);
     ZELDA_ARENA_CHECK_POINTER(ptr, newSize, "zelda_realloc_DEBUG", T("再確保", "Re-securing"));
     return ptr;
 }
 #endif
 
 void ZeldaArena_Free(void* ptr) {
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_FREE, ptr, NULL, 0, NULL, 0);
     __osFree(&sZeldaArena, ptr);
 }
 
 #if DEBUG_FEATURES
 void ZeldaArena_FreeDebug(void* ptr, const char* file, int line) {
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_FREE, ptr, NULL, 0, file, line);
     __osFreeDebug(&sZeldaArena, ptr, file, line);
 }
 #endif
@@ -91,6 +108,7 @@ void* ZeldaArena_Calloc(u32 num, u32 size) {
     u32 n = num * size;
 
     ret = __osMalloc(&sZeldaArena, n);
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_MALLOC, ret, NULL, n, NULL, 0);
     if (ret != NULL) {
         bzero(ret, n);
     }
@@ -119,12 +137,14 @@ void ZeldaArena_Init(void* start, u32 size) {
     gZeldaArenaLogSeverity = LOG_SEVERITY_NOLOG;
 #endif
     __osMallocInit(&sZeldaArena, start, size);
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_INIT, start, NULL, size, NULL, 0);
 }
 
 void ZeldaArena_Cleanup(void) {
 #if DEBUG_FEATURES
     gZeldaArenaLogSeverity = LOG_SEVERITY_NOLOG;
 #endif
+    ARENA_TRACE_RECORD(ARENA_TRACE_ZELDA, ARENA_TRACE_OP_CLEANUP, NULL, NULL, 0, NULL, 0);
     __osMallocCleanup(&sZeldaArena);
 }
 
@@ -1,6 +1,7 @@
 #include "libc64/malloc.h"
 #include "libc64/qrand.h"
 #include "libu64/debug.h"
+#include "arena_trace.h"
 #include "array_count.h"
 #include "buffers.h"
 #include "color.h"
@@ -36,6 +37,7 @@
 #include "versions.h"
 #include "z_actor_dlftbls.h"
 #include "zelda_arena.h"
+#include "zelda_pool.h"
 #include "audio.h"
 #include "cutscene_flags.h"
 #include "debug_display.h"
@@ -247,6 +249,10 @@ void Play_Destroy(GameState* thisx) {
     Effect_DeleteAll(this);
     EffectSs_ClearAll(this);
     CollisionCheck_DestroyContext(this, &this->colChkCtx);
+#if ROOM_PREFETCH
+    // The room buffer is about to be freed
+    Room_StopPrefetch();
+#endif
 
     if (gTransitionTileState == TRANS_TILE_READY) {
         TransitionTile_Destroy(&gTransitionTile);
@@ -272,6 +278,12 @@ void Play_Destroy(GameState* thisx) {
     Interface_Destroy(this);
     KaleidoScopeCall_Destroy(this);
     KaleidoManager_Destroy();
+#if ZELDA_POOLS
+    ZeldaPool_Cleanup();
+#endif
+#if GFX_POOL_ADAPTIVE
+    Graph_PrintGfxPoolStats(this->sceneId);
+#endif
     ZeldaArena_Cleanup();
 
 #if PLATFORM_N64
@@ -488,11 +500,21 @@ void Play_Init(GameState* thisx) {
 
     PRINTF("ZELDA ALLOC SIZE=%x\n", THA_GetRemaining(&this->state.tha));
     zAllocSize = THA_GetRemaining(&this->state.tha);
+#if THA_SCRATCH
+    // Leave room between the head and the tail for temporary allocations during frames, see THA_MarkHead
+    zAllocSize -= THA_SCRATCH;
+#endif
     zAlloc = (uintptr_t)GAME_STATE_ALLOC(&this->state, zAllocSize, "../z_play.c", 2918);
     zAllocAligned = (zAlloc + 8) & ~0xF;
     ZeldaArena_Init((void*)zAllocAligned, zAllocSize - (zAllocAligned - zAlloc));
     PRINTF(T("ゼルダヒープ %08x-%08x\n", "Zelda Heap %08x-%08x\n"), zAllocAligned,
            (u8*)zAllocAligned + zAllocSize - (s32)(zAllocAligned - zAlloc));
+#if ZELDA_POOLS
+    ZeldaPool_Init();
+#endif
+#if GFX_POOL_ADAPTIVE
+    Graph_ResetGfxPoolStats();
+#endif
 
 #if PLATFORM_GC && DEBUG_FEATURES
     Fault_AddClient(&D_801614B8, ZeldaArena_Display, NULL, NULL);
@@ -556,6 +578,39 @@ void Play_Update(PlayState* this) {
         SREG(1) = 0;
 #if PLATFORM_GC
         ZeldaArena_Display();
+#endif
+#if ACTOR_OVERLAY_CACHE
+        ActorOverlayTable_CacheDisplay();
+#endif
+#if ZELDA_POOLS
+        ZeldaPool_Display();
+#endif
+#if GFX_POOL_ADAPTIVE
+        Graph_PrintGfxPoolStats(this->sceneId);
+#endif
+#if ACTOR_ID_INDEX
+        Actor_DisplayIdIndexStats();
+#endif
+#if ACTOR_GRID
+        ActorGrid_Display();
+#endif
+#if ACTOR_UPDATE_LOD
+        Actor_DisplayUpdateLodStats();
+#endif
+#if COLLISION_BROADPHASE
+        CollisionCheck_DisplayBroadphaseStats();
+#endif
+#if COLLISION_OC_SWEEP
+        CollisionCheck_DisplayOCSweepStats();
+#endif
+#if COLLISION_LIST_GROWTH
+        CollisionCheck_DisplayListStats(&this->colChkCtx);
+#endif
+#if COLLISION_BVH
+        BgCheck_DisplayBvhStats();
+#endif
+#if ARENA_TRACE_ENABLED
+        ArenaTrace_Dump();
 #endif
     }
 
@@ -1016,6 +1071,10 @@ void Play_Update(PlayState* this) {
                     PLAY_LOG(3657);
                     EffectSs_UpdateAll(this);
 
+#if COLLISION_BVH
+                    BgCheck_BuildPendingStaticLookups(&this->colCtx);
+#endif
+
                     PLAY_LOG(3662);
                 }
             } else {
@@ -0,0 +1,234 @@
+/**
+ * @file z_pool.c
+ *
+ * Pools of fixed-size blocks carved from the Zelda arena when it is set up by Play_Init, for small objects that are
+ * allocated and freed all the time, like actor instances and collider element arrays. Taking a block from a pool or
+ * giving it back is a push or pop on the pool's free list, where the arena would search for a free block and split or
+ * merge blocks around it.
+ *
+ * Requests are served by the pool with the smallest blocks that fit them, and by the arena when that pool is full or
+ * the request is larger than any block. ZeldaPool_Free tells pool blocks from arena blocks by their address, so memory
+ * from ZELDA_POOL_MALLOC must be freed with ZELDA_POOL_FREE and nothing else.
+ *
+ * The number of blocks of each pool is in sZeldaPoolSizes. The most blocks each pool had in use at once is printed when
+ * the arena is cleaned up, to tune these numbers.
+ */
+#include "zelda_pool.h"
+
+#include "array_count.h"
+#include "printf.h"
+#include "terminal.h"
+#include "translation.h"
+
+typedef struct ZeldaPoolBlock {
+    /* 0x00 */ struct ZeldaPoolBlock* next;
+} ZeldaPoolBlock;
+
+typedef struct ZeldaPool {
+    /* 0x00 */ u8* start;
+    /* 0x04 */ u8* end;
+    /* 0x08 */ ZeldaPoolBlock* freeList;
+    /* 0x0C */ u16 blockSize;
+    /* 0x0E */ u16 count;
+    /* 0x10 */ u16 used;
+    /* 0x12 */ u16 peak;
+    /* 0x14 */ u32 overflows; // Requests for this pool that went to the arena as it was full
+} ZeldaPool; // size = 0x18
+
+typedef struct ZeldaPoolSize {
+    /* 0x00 */ u16 blockSize; // multiple of 0x10, to keep the arena's alignment
+    /* 0x02 */ u16 count;
+} ZeldaPoolSize; // size = 0x4
+
+// Smallest blocks first. Most actor instances are between 0x150 and 0x600 bytes.
+ZeldaPoolSize sZeldaPoolSizes[] = {
+    { 0x80, 16 }, { 0x180, 16 }, { 0x200, 32 }, { 0x300, 32 }, { 0x400, 16 }, { 0x600, 8 },
+};
+
+ZeldaPool sZeldaPools[ARRAY_COUNT(sZeldaPoolSizes)];
+s32 sZeldaPoolCount; // 0 if the pools could not be allocated or the arena is not set up
+u8* sZeldaPoolStart;
+u8* sZeldaPoolEnd;
+
+void ZeldaPool_Init(void) {
+    u32 totalSize = 0;
+    u8* block;
+    s32 i;
+    s32 j;
+
+    sZeldaPoolCount = 0;
+
+    for (i = 0; i < ARRAY_COUNT(sZeldaPoolSizes); i++) {
+        totalSize += sZeldaPoolSizes[i].blockSize * sZeldaPoolSizes[i].count;
+    }
+
+    // The pools live as long as the arena, keep them out of the way at its end
+    sZeldaPoolStart = ZELDA_ARENA_MALLOC_R(totalSize, "../z_pool.c", __LINE__);
+    if (sZeldaPoolStart == NULL) {
+        PRINTF(VT_COL(RED, WHITE) T("ゼルダプールを確保できません <サイズ＝%dバイト>\n",
+                                    "Cannot allocate the Zelda pools <size=%d bytes>\n") VT_RST,
+               totalSize);
+        sZeldaPoolEnd = NULL;
+        return;
+    }
+    sZeldaPoolEnd = sZeldaPoolStart + totalSize;
+
+    block = sZeldaPoolStart;
+    for (i = 0; i < ARRAY_COUNT(sZeldaPoolSizes); i++) {
+        ZeldaPool* pool = &sZeldaPools[i];
+
+        pool->blockSize = sZeldaPoolSizes[i].blockSize;
+        pool->count = sZeldaPoolSizes[i].count;
+        pool->used = 0;
+        pool->peak = 0;
+        pool->overflows = 0;
+        pool->start = block;
+        pool->end = block + pool->blockSize * pool->count;
+
+        // Link the blocks in address order
+        pool->freeList = NULL;
+        for (j = pool->count - 1; j >= 0; j--) {
+            ZeldaPoolBlock* poolBlock = (ZeldaPoolBlock*)(pool->start + pool->blockSize * j);
+
+            poolBlock->next = pool->freeList;
+            pool->freeList = poolBlock;
+        }
+        block = pool->end;
+    }
+    sZeldaPoolCount = ARRAY_COUNT(sZeldaPoolSizes);
+}
+
+void ZeldaPool_Cleanup(void) {
+    s32 i;
+
+    for (i = 0; i < sZeldaPoolCount; i++) {
+        ZeldaPool* pool = &sZeldaPools[i];
+
+        PRINTF(T("ゼルダプール %4d バイト: 最大 %3d / %3d 個 あふれ %d\n",
+                 "Zelda pool %4d bytes: peak %3d / %3d blocks overflows %d\n"),
+               pool->blockSize, pool->peak, pool->count, pool->overflows);
+    }
+
+    if (sZeldaPoolStart != NULL) {
+        ZELDA_ARENA_FREE(sZeldaPoolStart, "../z_pool.c", __LINE__);
+    }
+    sZeldaPoolStart = NULL;
+    sZeldaPoolEnd = NULL;
+    sZeldaPoolCount = 0;
+}
+
+/**
+ * Takes a block from the pool with the smallest blocks that fit `size`.
+ *
+ * @return the block, or NULL if that pool is full or no pool has blocks that large
+ */
+void* ZeldaPool_Take(u32 size) {
+    s32 i;
+
+    for (i = 0; i < sZeldaPoolCount; i++) {
+        ZeldaPool* pool = &sZeldaPools[i];
+
+        if (size <= pool->blockSize) {
+            ZeldaPoolBlock* block = pool->freeList;
+
+            if (block == NULL) {
+                pool->overflows++;
+                return NULL;
+            }
+            pool->freeList = block->next;
+            pool->used++;
+            if (pool->used > pool->peak) {
+                pool->peak = pool->used;
+            }
+            return block;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Gives `ptr` back to its pool.
+ *
+ * @return false if `ptr` is not a pool block
+ */
+s32 ZeldaPool_Give(void* ptr) {
+    ZeldaPool* pool;
+
+    if ((u8*)ptr < sZeldaPoolStart || (u8*)ptr >= sZeldaPoolEnd) {
+        return false;
+    }
+
+    for (pool = &sZeldaPools[0]; (u8*)ptr >= pool->end; pool++) {}
+
+    if (DEBUG_FEATURES && (((u8*)ptr - pool->start) % pool->blockSize != 0)) {
+        PRINTF(VT_COL(RED, WHITE) T("ゼルダプール: 不正なポインタ %08x\n", "Zelda pool: invalid pointer %08x\n") VT_RST,
+               ptr);
+        return true;
+    }
+
+    ((ZeldaPoolBlock*)ptr)->next = pool->freeList;
+    pool->freeList = ptr;
+    pool->used--;
+    return true;
+}
+
+void* ZeldaPool_Malloc(u32 size) {
+    void* ptr = ZeldaPool_Take(size);
+
+    if (ptr == NULL) {
+        ptr = ZeldaArena_Malloc(size);
+    }
+    return ptr;
+}
+
+#if DEBUG_FEATURES
+void* ZeldaPool_MallocDebug(u32 size, const char* file, int line) {
+    void* ptr = ZeldaPool_Take(size);
+
+    if (ptr == NULL) {
+        ptr = ZeldaArena_MallocDebug(size, file, line);
+    }
+    return ptr;
+}
+#endif
+
+void ZeldaPool_Free(void* ptr) {
+    if (!ZeldaPool_Give(ptr)) {
+        ZeldaArena_Free(ptr);
+    }
+}
+
+#if DEBUG_FEATURES
+void ZeldaPool_FreeDebug(void* ptr, const char* file, int line) {
+    if (!ZeldaPool_Give(ptr)) {
+        ZeldaArena_FreeDebug(ptr, file, line);
+    }
+}
+#endif
+
+s32 ZeldaPool_GetCount(void) {
+    return sZeldaPoolCount;
+}
+
+void ZeldaPool_GetUsage(s32 index, u32* outBlockSize, u32* outCount, u32* outUsed, u32* outPeak) {
+    ZeldaPool* pool = &sZeldaPools[index];
+
+    *outBlockSize = pool->blockSize;
+    *outCount = pool->count;
+    *outUsed = pool->used;
+    *outPeak = pool->peak;
+}
+
+#if DEBUG_FEATURES
+void ZeldaPool_Display(void) {
+    s32 i;
+
+    PRINTF(T("ゼルダプールの表示\n", "Zelda pool display\n"));
+    PRINTF("block size  used  peak count overflows\n");
+    for (i = 0; i < sZeldaPoolCount; i++) {
+        ZeldaPool* pool = &sZeldaPools[i];
+
+        PRINTF("%10d %5d %5d %5d %9d\n", pool->blockSize, pool->used, pool->peak, pool->count, pool->overflows);
+    }
+}
+#endif
@@ -577,6 +577,197 @@ void Room_Init(PlayState* play, Room* room) {
     room->segment = NULL;
 }
 
+#if ROOM_PREFETCH
+/**
+ * When the player gets close to a transition actor leading out of the current room, the room on the other side is
+ * loaded ahead of time into the part of the room buffer the next room request will use. If the next room requested is
+ * that room, the request completes with the data already loaded (or still being loaded) instead of loading it again.
+ *
+ * One room is prefetched at a time, and only once the room change that brought the player to the current room is
+ * finished, as until then the previous room occupies that part of the buffer. A prefetched room is evicted when the
+ * player gets closer to a transition actor leading to another room, or when another room is requested.
+ */
+
+// Distance to a transition actor at which the room behind it starts being prefetched
+#define ROOM_PREFETCH_DISTANCE 300.0f
+
+typedef enum RoomPrefetchStatus {
+    /* 0 */ ROOM_PREFETCH_NONE,
+    /* 1 */ ROOM_PREFETCH_LOADING,
+    /* 2 */ ROOM_PREFETCH_DONE,
+    /* 3 */ ROOM_PREFETCH_CLAIMED // Requested while loading, Room_ProcessRoomRequest waits for the prefetch instead
+} RoomPrefetchStatus;
+
+typedef struct RoomPrefetch {
+    s8 status;
+    s8 roomNum;
+    void* addr;
+    DmaRequest dmaRequest;
+    OSMesgQueue loadQueue;
+    OSMesg loadMsg;
+} RoomPrefetch;
+
+typedef struct RoomPrefetchStats {
+    /* 0x00 */ u32 hits;      // Rooms requested after being prefetched
+    /* 0x04 */ u32 lateHits;  // Rooms requested while being prefetched
+    /* 0x08 */ u32 misses;    // Rooms requested without being prefetched
+    /* 0x0C */ u32 evictions; // Prefetched rooms that weren't requested
+} RoomPrefetchStats; // size = 0x10
+
+RoomPrefetch sRoomPrefetch;
+RoomPrefetchStats gRoomPrefetchStats;
+
+/**
+ * Returns where the next room request would load room `roomNum`, see Room_RequestNewRoom.
+ */
+void* Room_GetRequestAddr(PlayState* play, RoomContext* roomCtx, s32 roomNum) {
+    u32 size = play->roomList.romFiles[roomNum].vromEnd - play->roomList.romFiles[roomNum].vromStart;
+
+    return (void*)ALIGN16((uintptr_t)roomCtx->bufPtrs[roomCtx->activeBufPage] -
+                          ((size + 8) * roomCtx->activeBufPage + 7));
+}
+
+/**
+ * Drops the prefetched room, waiting for it to finish loading if needed so that its memory can be reused.
+ */
+void Room_StopPrefetch(void) {
+    if (sRoomPrefetch.status == ROOM_PREFETCH_LOADING || sRoomPrefetch.status == ROOM_PREFETCH_CLAIMED) {
+        osRecvMesg(&sRoomPrefetch.loadQueue, NULL, OS_MESG_BLOCK);
+    }
+    if (sRoomPrefetch.status == ROOM_PREFETCH_LOADING || sRoomPrefetch.status == ROOM_PREFETCH_DONE) {
+        gRoomPrefetchStats.evictions++;
+    }
+    sRoomPrefetch.status = ROOM_PREFETCH_NONE;
+}
+
+/**
+ * Called by Room_RequestNewRoom before loading room `roomNum`.
+ *
+ * @return true if the room was prefetched, in which case the request is already complete or will complete along with
+ * the prefetch, and the room must not be loaded again.
+ */
+s32 Room_UsePrefetch(RoomContext* roomCtx, s32 roomNum) {
+    if ((sRoomPrefetch.status == ROOM_PREFETCH_LOADING || sRoomPrefetch.status == ROOM_PREFETCH_DONE) &&
+        (sRoomPrefetch.roomNum == roomNum) && (sRoomPrefetch.addr == roomCtx->roomRequestAddr)) {
+        if (sRoomPrefetch.status == ROOM_PREFETCH_DONE ||
+            osRecvMesg(&sRoomPrefetch.loadQueue, NULL, OS_MESG_NOBLOCK) == 0) {
+            gRoomPrefetchStats.hits++;
+            sRoomPrefetch.status = ROOM_PREFETCH_NONE;
+            osSendMesg(&roomCtx->loadQueue, NULL, OS_MESG_NOBLOCK);
+        } else {
+            gRoomPrefetchStats.lateHits++;
+            sRoomPrefetch.status = ROOM_PREFETCH_CLAIMED;
+        }
+        return true;
+    }
+
+    gRoomPrefetchStats.misses++;
+    Room_StopPrefetch();
+    return false;
+}
+
+/**
+ * Polls for the completion of the room request in progress.
+ *
+ * @return true if the room is loaded
+ */
+s32 Room_PollRequest(RoomContext* roomCtx) {
+    if (sRoomPrefetch.status == ROOM_PREFETCH_CLAIMED) {
+        if (osRecvMesg(&sRoomPrefetch.loadQueue, NULL, OS_MESG_NOBLOCK) != 0) {
+            return false;
+        }
+        sRoomPrefetch.status = ROOM_PREFETCH_NONE;
+        return true;
+    }
+
+    return osRecvMesg(&roomCtx->loadQueue, NULL, OS_MESG_NOBLOCK) == 0;
+}
+
+/**
+ * Starts prefetching the room behind the transition actor closest to the player, if it is close enough.
+ */
+void Room_UpdatePrefetch(PlayState* play, RoomContext* roomCtx) {
+    Player* player = GET_PLAYER(play);
+    TransitionActorEntry* transitionActor = &play->transitionActors.list[0];
+    RomFile* roomList = play->roomList.romFiles;
+    s32 curRoom = roomCtx->curRoom.num;
+    s32 nearestRoom = -1;
+    f32 nearestDistSq = SQ(ROOM_PREFETCH_DISTANCE);
+    u8* addr;
+    u32 size;
+    s32 i;
+
+    if (sRoomPrefetch.status == ROOM_PREFETCH_LOADING) {
+        if (osRecvMesg(&sRoomPrefetch.loadQueue, NULL, OS_MESG_NOBLOCK) != 0) {
+            return;
+        }
+        sRoomPrefetch.status = ROOM_PREFETCH_DONE;
+    }
+
+    if ((roomCtx->status != 0) || (roomCtx->prevRoom.segment != NULL) || (roomCtx->curRoom.segment == NULL) ||
+        (player == NULL)) {
+        return;
+    }
+
+#if PLATFORM_N64
+    if ((B_80121220 != NULL) && (B_80121220->unk_08 != NULL)) {
+        // Rooms are loaded from the disk drive
+        return;
+    }
+#endif
+
+    for (i = 0; i < play->transitionActors.count; i++, transitionActor++) {
+        s32 room;
+        f32 dx;
+        f32 dy;
+        f32 dz;
+        f32 distSq;
+
+        if (transitionActor->sides[0].room == curRoom) {
+            room = transitionActor->sides[1].room;
+        } else if (transitionActor->sides[1].room == curRoom) {
+            room = transitionActor->sides[0].room;
+        } else {
+            continue;
+        }
+        if ((room < 0) || (room == curRoom)) {
+            continue;
+        }
+
+        dx = transitionActor->pos.x - player->actor.world.pos.x;
+        dy = transitionActor->pos.y - player->actor.world.pos.y;
+        dz = transitionActor->pos.z - player->actor.world.pos.z;
+        distSq = SQ(dx) + SQ(dy) + SQ(dz);
+        if (distSq < nearestDistSq) {
+            nearestDistSq = distSq;
+            nearestRoom = room;
+        }
+    }
+
+    if ((nearestRoom < 0) || ((sRoomPrefetch.status == ROOM_PREFETCH_DONE) && (sRoomPrefetch.roomNum == nearestRoom))) {
+        return;
+    }
+
+    Room_StopPrefetch();
+
+    addr = Room_GetRequestAddr(play, roomCtx, nearestRoom);
+    size = roomList[nearestRoom].vromEnd - roomList[nearestRoom].vromStart;
+
+    // The room buffer is sized to hold the rooms on both sides of any transition actor, check anyway
+    if ((addr < (u8*)roomCtx->curRoom.segment + (roomList[curRoom].vromEnd - roomList[curRoom].vromStart)) &&
+        ((u8*)roomCtx->curRoom.segment < addr + size)) {
+        return;
+    }
+
+    sRoomPrefetch.status = ROOM_PREFETCH_LOADING;
+    sRoomPrefetch.roomNum = nearestRoom;
+    sRoomPrefetch.addr = addr;
+    osCreateMesgQueue(&sRoomPrefetch.loadQueue, &sRoomPrefetch.loadMsg, 1);
+    DmaMgr_RequestPrefetch(&sRoomPrefetch.dmaRequest, addr, roomList[nearestRoom].vromStart, size,
+                           &sRoomPrefetch.loadQueue, NULL);
+}
+#endif
+
 /**
  * Allocates memory for rooms and fetches the first room that the player will spawn into.
  *
@@ -640,6 +831,9 @@ u32 Room_SetupFirstRoom(PlayState* play, RoomContext* roomCtx) {
     PRINTF_RST();
     roomCtx->activeBufPage = 0;
     roomCtx->status = 0;
+#if ROOM_PREFETCH
+    sRoomPrefetch.status = ROOM_PREFETCH_NONE;
+#endif
 
     frontRoom = gSaveContext.respawnFlag > 0 ? ((void)0, gSaveContext.respawn[gSaveContext.respawnFlag - 1].roomIndex)
                                              : play->spawnList[play->spawn].room;
@@ -685,6 +879,13 @@ s32 Room_RequestNewRoom(PlayState* play, RoomContext* roomCtx, s32 roomNum) {
 
         osCreateMesgQueue(&roomCtx->loadQueue, &roomCtx->loadMsg, 1);
 
+#if ROOM_PREFETCH
+        if (Room_UsePrefetch(roomCtx, roomNum)) {
+            roomCtx->activeBufPage ^= 1;
+            return true;
+        }
+#endif
+
 #if PLATFORM_N64
         if ((B_80121220 != NULL) && (B_80121220->unk_08 != NULL)) {
             B_80121220->unk_08(play, roomCtx, roomNum);
@@ -713,7 +914,11 @@ s32 Room_RequestNewRoom(PlayState* play, RoomContext* roomCtx, s32 roomNum) {
  */
 s32 Room_ProcessRoomRequest(PlayState* play, RoomContext* roomCtx) {
     if (roomCtx->status == 1) {
+#if ROOM_PREFETCH
+        if (Room_PollRequest(roomCtx)) {
+#else
         if (osRecvMesg(&roomCtx->loadQueue, NULL, OS_MESG_NOBLOCK) == 0) {
+#endif
             roomCtx->status = 0;
             roomCtx->curRoom.segment = roomCtx->roomRequestAddr;
             gSegments[3] = OS_K0_TO_PHYSICAL(roomCtx->curRoom.segment);
@@ -726,6 +931,10 @@ s32 Room_ProcessRoomRequest(PlayState* play, RoomContext* roomCtx) {
         }
     }
 
+#if ROOM_PREFETCH
+    Room_UpdatePrefetch(play, roomCtx);
+#endif
+
     return true;
 }
 
@@ -19,6 +19,49 @@
 SceneCmdHandlerFunc sSceneCmdHandlers[SCENE_CMD_ID_MAX];
 RomFile sNaviQuestHintFiles[];
 
+#if OBJECT_SLOT_INDEX
+// The lowest slot holding each object, or -1, so that Object_GetSlot doesn't search the slots
+s8 sObjectSlotIndex[OBJECT_ID_MAX];
+
+/**
+ * Adds the object just placed in `slot` to the index.
+ */
+void Object_IndexSlot(ObjectContext* objectCtx, s32 slot) {
+    s32 objectId = ABS(objectCtx->slots[slot].id);
+
+    if ((sObjectSlotIndex[objectId] < 0) || (sObjectSlotIndex[objectId] > slot)) {
+        sObjectSlotIndex[objectId] = slot;
+    }
+}
+
+/**
+ * Removes the object in `slot` from the index, before the slot is cleared. Another slot holding the same object takes
+ * its place in the index.
+ */
+void Object_UnindexSlot(ObjectContext* objectCtx, s32 slot) {
+    s32 objectId = ABS(objectCtx->slots[slot].id);
+    s32 i;
+
+    if (sObjectSlotIndex[objectId] == slot) {
+        sObjectSlotIndex[objectId] = -1;
+        for (i = slot + 1; i < objectCtx->numEntries; i++) {
+            if (ABS(objectCtx->slots[i].id) == objectId) {
+                sObjectSlotIndex[objectId] = i;
+                break;
+            }
+        }
+    }
+}
+#endif
+
+#if OBJECT_BATCH_LOAD
+// The objects waiting to be loaded are requested together, and only the last request sends a message when done. The DMA
+// manager handles requests of the same priority in order, so that message means the whole batch is loaded.
+OSMesgQueue sObjectLoadQueue;
+OSMesg sObjectLoadMsg;
+u32 sObjectLoadingSlots; // Bit field of the slots in the batch being loaded, 0 if none
+#endif
+
 /**
  * Spawn an object file of a specified ID that will persist through room changes.
  *
@@ -35,6 +78,9 @@ s32 Object_SpawnPersistent(ObjectContext* objectCtx, s16 objectId) {
     u32 size;
 
     objectCtx->slots[objectCtx->numEntries].id = objectId;
+#if OBJECT_SLOT_INDEX
+    Object_IndexSlot(objectCtx, objectCtx->numEntries);
+#endif
     size = gObjectTable[objectId].vromEnd - gObjectTable[objectId].vromStart;
 
     PRINTF("OBJECT[%d] SIZE %fK SEG=%x\n", objectId, size / 1024.0f, objectCtx->slots[objectCtx->numEntries].segment);
@@ -101,6 +147,16 @@ void Object_InitContext(PlayState* play, ObjectContext* objectCtx) {
         objectCtx->slots[i].id = OBJECT_INVALID;
     }
 
+#if OBJECT_SLOT_INDEX
+    for (i = 0; i < ARRAY_COUNT(sObjectSlotIndex); i++) {
+        sObjectSlotIndex[i] = -1;
+    }
+#endif
+#if OBJECT_BATCH_LOAD
+    osCreateMesgQueue(&sObjectLoadQueue, &sObjectLoadMsg, 1);
+    sObjectLoadingSlots = 0;
+#endif
+
     PRINTF_COLOR_GREEN();
     PRINTF(T("オブジェクト入れ替えバンク情報 %8.3fKB\n", "Object exchange bank data %8.3fKB\n"), spaceSize / 1024.0f);
     PRINTF_RST();
@@ -113,6 +169,53 @@ void Object_InitContext(PlayState* play, ObjectContext* objectCtx) {
     gSegments[4] = OS_K0_TO_PHYSICAL(objectCtx->slots[objectCtx->mainKeepSlot].segment);
 }
 
+#if OBJECT_BATCH_LOAD
+void Object_UpdateEntries(ObjectContext* objectCtx) {
+    s32 i;
+    s32 lastSlot;
+    ObjectEntry* entry;
+    RomFile* objectFile;
+    u32 size;
+
+    if (sObjectLoadingSlots != 0) {
+        if (osRecvMesg(&sObjectLoadQueue, NULL, OS_MESG_NOBLOCK) != 0) {
+            return;
+        }
+
+        // Slots given another object while the batch was loading have been reset to be requested again
+        entry = &objectCtx->slots[0];
+        for (i = 0; i < objectCtx->numEntries; i++) {
+            if ((sObjectLoadingSlots & (1 << i)) && (entry->id < 0) && (entry->dmaRequest.vromAddr != 0)) {
+                entry->id = -entry->id;
+            }
+            entry++;
+        }
+        sObjectLoadingSlots = 0;
+    }
+
+    // Request every object waiting to be loaded, only the last request notifies sObjectLoadQueue
+    lastSlot = -1;
+    for (i = 0; i < objectCtx->numEntries; i++) {
+        if ((objectCtx->slots[i].id < 0) && (objectCtx->slots[i].dmaRequest.vromAddr == 0)) {
+            sObjectLoadingSlots |= 1 << i;
+            lastSlot = i;
+        }
+    }
+
+    for (i = 0; i <= lastSlot; i++) {
+        if (sObjectLoadingSlots & (1 << i)) {
+            entry = &objectCtx->slots[i];
+            objectFile = &gObjectTable[-entry->id];
+            size = objectFile->vromEnd - objectFile->vromStart;
+
+            PRINTF("OBJECT EXCHANGE BANK-%2d SIZE %8.3fK SEG=%08x\n", i, size / 1024.0f, entry->segment);
+
+            DMA_REQUEST_ASYNC(&entry->dmaRequest, entry->segment, objectFile->vromStart, size, 0,
+                              (i == lastSlot) ? &sObjectLoadQueue : NULL, NULL, "../z_scene.c", __LINE__);
+        }
+    }
+}
+#else
 void Object_UpdateEntries(ObjectContext* objectCtx) {
     s32 i;
     ObjectEntry* entry = &objectCtx->slots[0];
@@ -137,8 +240,15 @@ void Object_UpdateEntries(ObjectContext* objectCtx) {
         entry++;
     }
 }
+#endif
 
 s32 Object_GetSlot(ObjectContext* objectCtx, s16 objectId) {
+#if OBJECT_SLOT_INDEX
+    if ((objectId <= OBJECT_INVALID) || (objectId >= OBJECT_ID_MAX)) {
+        return -1;
+    }
+    return sObjectSlotIndex[objectId];
+#else
     s32 i;
 
     for (i = 0; i < objectCtx->numEntries; i++) {
@@ -148,6 +258,7 @@ s32 Object_GetSlot(ObjectContext* objectCtx, s16 objectId) {
     }
 
     return -1;
+#endif
 }
 
 s32 Object_IsLoaded(ObjectContext* objectCtx, s32 slot) {
@@ -181,6 +292,9 @@ void* func_800982FC(ObjectContext* objectCtx, s32 slot, s16 objectId) {
 
     entry->id = -objectId;
     entry->dmaRequest.vromAddr = 0;
+#if OBJECT_SLOT_INDEX
+    Object_IndexSlot(objectCtx, slot);
+#endif
 
     size = objectFile->vromEnd - objectFile->vromStart;
     PRINTF("OBJECT EXCHANGE NO=%2d BANK=%3d SIZE=%8.3fK\n", slot, objectId, size / 1024.0f);
@@ -250,6 +364,20 @@ BAD_RETURN(s32) Scene_CommandCollisionHeader(PlayState* play, SceneCmd* cmd) {
     colHeader->surfaceTypeList = SEGMENTED_TO_VIRTUAL(colHeader->surfaceTypeList);
     colHeader->bgCamList = SEGMENTED_TO_VIRTUAL(colHeader->bgCamList);
     colHeader->waterBoxes = SEGMENTED_TO_VIRTUAL(colHeader->waterBoxes);
+#if COLLISION_BVH
+    if (colHeader->bvh != NULL) {
+        colHeader->bvh = SEGMENTED_TO_VIRTUAL(colHeader->bvh);
+        colHeader->bvh->nodes = SEGMENTED_TO_VIRTUAL(colHeader->bvh->nodes);
+        colHeader->bvh->polyIds = SEGMENTED_TO_VIRTUAL(colHeader->bvh->polyIds);
+    }
+#endif
+#if COLLISION_BAKED_LOOKUP
+    if (colHeader->bakedLookup != NULL) {
+        colHeader->bakedLookup = SEGMENTED_TO_VIRTUAL(colHeader->bakedLookup);
+        colHeader->bakedLookup->lookupTbl = SEGMENTED_TO_VIRTUAL(colHeader->bakedLookup->lookupTbl);
+        colHeader->bakedLookup->nodes = SEGMENTED_TO_VIRTUAL(colHeader->bakedLookup->nodes);
+    }
+#endif
 
     BgCheck_Allocate(&play->colCtx, play, colHeader);
 }
@@ -305,6 +433,9 @@ BAD_RETURN(s32) Scene_CommandObjectList(PlayState* play, SceneCmd* cmd) {
 
             invalidatedEntry = &play->objectCtx.slots[i];
             for (j = i; j < play->objectCtx.numEntries; j++) {
+#if OBJECT_SLOT_INDEX
+                Object_UnindexSlot(&play->objectCtx, j);
+#endif
                 invalidatedEntry->id = OBJECT_INVALID;
                 invalidatedEntry++;
             }
@@ -159,6 +159,108 @@ ArenaNode* ArenaImpl_GetPrevBlock(ArenaNode* node) {
 }
 #endif
 
+#if ARENA_SIZE_CLASSES
+/**
+ * With ARENA_SIZE_CLASSES, free blocks are also linked in one of ARENA_SIZE_CLASS_MAX free lists according to their
+ * size, class n holding the blocks of size 2^n to 2^(n+1)-1. A bitmask of the non-empty lists lets __osMalloc find a
+ * large enough block without walking the arena: every block in a class above the one of the requested size fits, so
+ * the first block of the lowest such class is used. Only when there is none are the blocks of the requested size's own
+ * class checked one by one.
+ *
+ * Blocks stay linked in address order through `next` and `prev`, which act as boundary tags: freeing a block merges it
+ * with its neighbours by looking at them directly, as before.
+ */
+
+/**
+ * Returns the index of the highest set bit of `x`, or 0 if `x` is 0.
+ */
+s32 ArenaImpl_GetHighestBit(u32 x) {
+    s32 bit = 0;
+
+    if (x >= (1 << 16)) {
+        x >>= 16;
+        bit += 16;
+    }
+    if (x >= (1 << 8)) {
+        x >>= 8;
+        bit += 8;
+    }
+    if (x >= (1 << 4)) {
+        x >>= 4;
+        bit += 4;
+    }
+    if (x >= (1 << 2)) {
+        x >>= 2;
+        bit += 2;
+    }
+    if (x >= (1 << 1)) {
+        bit += 1;
+    }
+    return bit;
+}
+
+#define ARENA_SIZE_CLASS(size) ArenaImpl_GetHighestBit(size)
+
+void ArenaImpl_InsertFree(Arena* arena, ArenaNode* node) {
+    s32 sizeClass = ARENA_SIZE_CLASS(node->size);
+    ArenaNode* head = arena->freeLists[sizeClass];
+
+    node->nextFree = head;
+    node->prevFree = NULL;
+    if (head != NULL) {
+        head->prevFree = node;
+    }
+    arena->freeLists[sizeClass] = node;
+    arena->freeListMask |= 1 << sizeClass;
+}
+
+/**
+ * Unlinks a free block from its free list. Must be called before changing the size of the block.
+ */
+void ArenaImpl_RemoveFree(Arena* arena, ArenaNode* node) {
+    s32 sizeClass;
+
+    if (node->prevFree != NULL) {
+        node->prevFree->nextFree = node->nextFree;
+    } else {
+        sizeClass = ARENA_SIZE_CLASS(node->size);
+        arena->freeLists[sizeClass] = node->nextFree;
+        if (node->nextFree == NULL) {
+            arena->freeListMask &= ~(1 << sizeClass);
+        }
+    }
+    if (node->nextFree != NULL) {
+        node->nextFree->prevFree = node->prevFree;
+    }
+}
+
+/**
+ * Returns a free block of at least `size` bytes, or NULL if there is none.
+ */
+ArenaNode* ArenaImpl_FindFree(Arena* arena, u32 size) {
+    s32 sizeClass = ARENA_SIZE_CLASS(size);
+    u32 mask;
+    ArenaNode* iter;
+
+    // Classes above `sizeClass` only hold blocks larger than `size`, and so does `sizeClass` if `size` is a power of 2
+    if (size == (1u << sizeClass)) {
+        mask = arena->freeListMask & -(1u << sizeClass);
+    } else {
+        mask = arena->freeListMask & -(2u << sizeClass);
+    }
+    if (mask != 0) {
+        return arena->freeLists[ARENA_SIZE_CLASS(mask & -mask)];
+    }
+
+    for (iter = arena->freeLists[sizeClass]; iter != NULL; iter = iter->nextFree) {
+        if (iter->size >= size) {
+            return iter;
+        }
+    }
+    return NULL;
+}
+#endif
+
 ArenaNode* ArenaImpl_GetLastBlock(Arena* arena) {
     ArenaNode* last = NULL;
     ArenaNode* iter;
@@ -207,6 +309,9 @@ void __osMallocAddBlock(Arena* arena, void* start, s32 size) {
                 firstNode->prev = lastNode;
                 lastNode->next = firstNode;
             }
+#if ARENA_SIZE_CLASSES
+            ArenaImpl_InsertFree(arena, firstNode);
+#endif
             ArenaImpl_Unlock(arena);
         }
     }
@@ -276,11 +381,18 @@ void* __osMalloc_NoLockDebug(Arena* arena, u32 size, const char* file, int line)
 
     size = ALIGN16(size);
     blockSize = ALIGN16(size) + sizeof(ArenaNode);
+#if ARENA_SIZE_CLASSES
+    iter = ArenaImpl_FindFree(arena, size);
+#else
     iter = arena->head;
+#endif
 
     while (iter != NULL) {
         if (iter->isFree && iter->size >= size) {
             CHECK_FREE_BLOCK(arena, iter);
+#if ARENA_SIZE_CLASSES
+            ArenaImpl_RemoveFree(arena, iter);
+#endif
 
             if (blockSize < iter->size) {
                 newNode = (ArenaNode*)((u32)iter + blockSize);
@@ -296,6 +408,9 @@ void* __osMalloc_NoLockDebug(Arena* arena, u32 size, const char* file, int line)
                 if (next) {
                     next->prev = newNode;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, newNode);
+#endif
             }
 
             iter->isFree = false;
@@ -336,6 +451,9 @@ void* __osMallocRDebug(Arena* arena, u32 size, const char* file, int line) {
     while (iter != NULL) {
         if (iter->isFree && iter->size >= size) {
             CHECK_FREE_BLOCK(arena, iter);
+#if ARENA_SIZE_CLASSES
+            ArenaImpl_RemoveFree(arena, iter);
+#endif
 
             blockSize = ALIGN16(size) + sizeof(ArenaNode);
             if (blockSize < iter->size) {
@@ -351,6 +469,9 @@ void* __osMallocRDebug(Arena* arena, u32 size, const char* file, int line) {
                 if (next) {
                     next->prev = newNode;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, iter);
+#endif
                 iter = newNode;
             }
 
@@ -380,11 +501,18 @@ void* __osMalloc_NoLock(Arena* arena, u32 size) {
 
     size = ALIGN16(size);
     blockSize = ALIGN16(size) + sizeof(ArenaNode);
+#if ARENA_SIZE_CLASSES
+    iter = ArenaImpl_FindFree(arena, size);
+#else
     iter = arena->head;
+#endif
 
     while (iter != NULL) {
         if (iter->isFree && iter->size >= size) {
             CHECK_FREE_BLOCK(arena, iter);
+#if ARENA_SIZE_CLASSES
+            ArenaImpl_RemoveFree(arena, iter);
+#endif
 
             if (blockSize < iter->size) {
                 newNode = (ArenaNode*)((u32)iter + blockSize);
@@ -400,6 +528,9 @@ void* __osMalloc_NoLock(Arena* arena, u32 size) {
                 if (next) {
                     next->prev = newNode;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, newNode);
+#endif
             }
 
             iter->isFree = false;
@@ -444,6 +575,9 @@ void* __osMallocR(Arena* arena, u32 size) {
     while (iter != NULL) {
         if (iter->isFree && iter->size >= size) {
             CHECK_FREE_BLOCK(arena, iter);
+#if ARENA_SIZE_CLASSES
+            ArenaImpl_RemoveFree(arena, iter);
+#endif
 
             if (blockSize < iter->size) {
                 allocNode = (ArenaNode*)((u32)iter + (iter->size - size));
@@ -460,6 +594,9 @@ void* __osMallocR(Arena* arena, u32 size) {
                 if (next) {
                     next->prev = newNode;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, iter);
+#endif
                 iter = newNode;
             }
 
@@ -517,6 +654,10 @@ void __osFree_NoLock(Arena* arena, void* ptr) {
 
     if ((u32)next == (u32)node + sizeof(ArenaNode) + node->size && next->isFree) {
         ArenaNode* newNext = NODE_GET_NEXT(next);
+
+#if ARENA_SIZE_CLASSES
+        ArenaImpl_RemoveFree(arena, next);
+#endif
         if (newNext != NULL) {
             newNext->prev = node;
         }
@@ -528,13 +669,23 @@ void __osFree_NoLock(Arena* arena, void* ptr) {
     }
 
     if (prev != NULL && prev->isFree && (u32)node == (u32)prev + sizeof(ArenaNode) + prev->size) {
+#if ARENA_SIZE_CLASSES
+        ArenaImpl_RemoveFree(arena, prev);
+#endif
         if (next) {
             next->prev = prev;
         }
         prev->next = next;
         prev->size += node->size + sizeof(ArenaNode);
         FILL_FREE_BLOCK_HEADER(arena, node);
+#if ARENA_SIZE_CLASSES
+        node = prev;
+#endif
     }
+
+#if ARENA_SIZE_CLASSES
+    ArenaImpl_InsertFree(arena, node);
+#endif
 }
 
 void __osFree(Arena* arena, void* ptr) {
@@ -583,6 +734,9 @@ void __osFree_NoLockDebug(Arena* arena, void* ptr, const char* file, int line) {
     FILL_FREE_BLOCK_CONTENTS(arena, node);
 
     if ((u32)next == (u32)node + sizeof(ArenaNode) + node->size && next->isFree) {
+#if ARENA_SIZE_CLASSES
+        ArenaImpl_RemoveFree(arena, next);
+#endif
         newNext = NODE_GET_NEXT(next);
         if (newNext != NULL) {
             newNext->prev = node;
@@ -595,13 +749,23 @@ void __osFree_NoLockDebug(Arena* arena, void* ptr, const char* file, int line) {
     }
 
     if (prev != NULL && prev->isFree && (u32)node == (u32)prev + sizeof(ArenaNode) + prev->size) {
+#if ARENA_SIZE_CLASSES
+        ArenaImpl_RemoveFree(arena, prev);
+#endif
         if (next != NULL) {
             next->prev = prev;
         }
         prev->next = next;
         prev->size += node->size + sizeof(ArenaNode);
         FILL_FREE_BLOCK_HEADER(arena, node);
+#if ARENA_SIZE_CLASSES
+        node = prev;
+#endif
     }
+
+#if ARENA_SIZE_CLASSES
+    ArenaImpl_InsertFree(arena, node);
+#endif
 }
 
 void __osFreeDebug(Arena* arena, void* ptr, const char* file, int line) {
@@ -645,6 +809,9 @@ void* __osRealloc(Arena* arena, void* ptr, u32 newSize) {
             if ((u32)next == ((u32)node + node->size + sizeof(ArenaNode)) && next->isFree && next->size >= sizeDiff) {
                 osSyncPrintf(T("現メモリブロックの後ろにフリーブロックがあるので結合します\n",
                                "Merge because there is a free block after the current memory block\n"));
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_RemoveFree(arena, next);
+#endif
                 next->size -= sizeDiff;
                 overNext = NODE_GET_NEXT(next);
                 newNext = (ArenaNode*)((u32)next + sizeDiff);
@@ -654,6 +821,9 @@ void* __osRealloc(Arena* arena, void* ptr, u32 newSize) {
                 node->next = newNext;
                 node->size = newSize;
                 memmove(node->next, next, sizeof(ArenaNode));
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, newNext);
+#endif
             } else {
                 osSyncPrintf(T("新たにメモリブロックを確保して内容を移動します\n",
                                "Allocate a new memory block and move the contents\n"));
@@ -672,6 +842,9 @@ void* __osRealloc(Arena* arena, void* ptr, u32 newSize) {
                 osSyncPrintf(T("現メモリブロックの後ろのフリーブロックを大きくしました\n",
                                "Increased free block behind current memory block\n"));
                 newNext2 = (ArenaNode*)((u32)node + blockSize);
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_RemoveFree(arena, next2);
+#endif
                 localCopy = *next2;
                 *newNext2 = localCopy;
                 newNext2->size += node->size - newSize;
@@ -681,6 +854,9 @@ void* __osRealloc(Arena* arena, void* ptr, u32 newSize) {
                 if (overNext2 != NULL) {
                     overNext2->prev = newNext2;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, newNext2);
+#endif
             } else if (newSize + sizeof(ArenaNode) < node->size) {
                 blockSize = ALIGN16(newSize) + sizeof(ArenaNode);
 
@@ -698,6 +874,9 @@ void* __osRealloc(Arena* arena, void* ptr, u32 newSize) {
                 if (overNext2 != NULL) {
                     overNext2->prev = newNext2;
                 }
+#if ARENA_SIZE_CLASSES
+                ArenaImpl_InsertFree(arena, newNext2);
+#endif
             } else {
                 osSyncPrintf(
                     T("フリーブロック生成するだけの空きがありません\n", "There is no room to generate free blocks\n"));
@@ -879,6 +1058,26 @@ s32 __osCheckArena(Arena* arena) {
         }
         iter = NODE_GET_NEXT(iter);
     }
+#if ARENA_SIZE_CLASSES
+    {
+        s32 i;
+
+        for (i = 0; i < ARENA_SIZE_CLASS_MAX; i++) {
+            for (iter = arena->freeLists[i]; iter != NULL; iter = iter->nextFree) {
+                if (!NODE_IS_VALID(iter) || !iter->isFree || (ARENA_SIZE_CLASS(iter->size) != i)) {
+                    osSyncPrintf("Bad free list node (class %d: %08x %04x %d %08x)\n", i, iter, (u16)iter->magic,
+                                 iter->isFree, iter->size);
+                    error = 1;
+                    break;
+                }
+            }
+            if ((arena->freeLists[i] != NULL) != ((arena->freeListMask >> i) & 1)) {
+                osSyncPrintf("Bad free list mask (class %d: %08x)\n", i, arena->freeListMask);
+                error = 1;
+            }
+        }
+    }
+#endif
     if (error == 0) {
         osSyncPrintf(T("アリーナはまだ、いけそうです\n", "The arena is still going well\n"));
     }
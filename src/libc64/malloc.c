@@ -1,6 +1,7 @@
 #include "libc64/malloc.h"
 
 #include "libc64/os_malloc.h"
+#include "arena_trace.h"
 #include "printf.h"
 #include "translation.h"
 #include "ultra64.h"
@@ -40,6 +41,7 @@ void* SystemArena_Malloc(u32 size) {
     DISABLE_INTERRUPTS();
     ptr = __osMalloc(&gSystemArena, size);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_MALLOC, ptr, NULL, size, NULL, 0);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, size, "malloc", T("確保", "Secure"));
     return ptr;
@@ -53,6 +55,7 @@ void* SystemArena_MallocDebug(u32 size, const char* file, int line) {
     DISABLE_INTERRUPTS();
     ptr = __osMallocDebug(&gSystemArena, size, file, line);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_MALLOC, ptr, NULL, size, file, line);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, size, "malloc_DEBUG", T("確保", "Secure"));
     return ptr;
@@ -66,6 +69,7 @@ void* SystemArena_MallocR(u32 size) {
     DISABLE_INTERRUPTS();
     ptr = __osMallocR(&gSystemArena, size);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_MALLOC_R, ptr, NULL, size, NULL, 0);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, size, "malloc_r", T("確保", "Secure"));
     return ptr;
@@ -79,6 +83,7 @@ void* SystemArena_MallocRDebug(u32 size, const char* file, int line) {
     DISABLE_INTERRUPTS();
     ptr = __osMallocRDebug(&gSystemArena, size, file, line);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_MALLOC_R, ptr, NULL, size, file, line);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, size, "malloc_r_DEBUG", T("確保", "Secure"));
     return ptr;
@@ -87,10 +92,14 @@ void* SystemArena_MallocRDebug(u32 size, const char* file, int line) {
 
 void* SystemArena_Realloc(void* ptr, u32 newSize) {
     DECLARE_INTERRUPT_MASK
+#if ARENA_TRACE_ENABLED
+    void* oldPtr = ptr;
+#endif
 
     DISABLE_INTERRUPTS();
     ptr = __osRealloc(&gSystemArena, ptr, newSize);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_REALLOC, ptr, oldPtr, newSize, NULL, 0);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, newSize, "realloc", T("再確保", "Re-secure"));
     return ptr;
@@ -99,10 +108,14 @@ void* SystemArena_Realloc(void* ptr, u32 newSize) {
 #if DEBUG_FEATURES
 void* SystemArena_ReallocDebug(void* ptr, u32 newSize, const char* file, int line) {
     DECLARE_INTERRUPT_MASK
+#if ARENA_TRACE_ENABLED
+    void* oldPtr = ptr;
+#endif
 
     DISABLE_INTERRUPTS();
     ptr = __osReallocDebug(&gSystemArena, ptr, newSize, file, line);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_REALLOC, ptr, oldPtr, newSize, file, line);
 
     SYSTEM_ARENA_CHECK_POINTER(ptr, newSize, "realloc_DEBUG", T("再確保", "Re-secure"));
     return ptr;
@@ -112,6 +125,7 @@ void* SystemArena_ReallocDebug(void* ptr, u32 newSize, const char* file, int lin
 void SystemArena_Free(void* ptr) {
     DECLARE_INTERRUPT_MASK
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_FREE, ptr, NULL, 0, NULL, 0);
     DISABLE_INTERRUPTS();
     __osFree(&gSystemArena, ptr);
     RESTORE_INTERRUPTS();
@@ -121,6 +135,7 @@ void SystemArena_Free(void* ptr) {
 void SystemArena_FreeDebug(void* ptr, const char* file, int line) {
     DECLARE_INTERRUPT_MASK
 
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_FREE, ptr, NULL, 0, file, line);
     DISABLE_INTERRUPTS();
     __osFreeDebug(&gSystemArena, ptr, file, line);
     RESTORE_INTERRUPTS();
@@ -135,6 +150,7 @@ void* SystemArena_Calloc(u32 num, u32 size) {
     DISABLE_INTERRUPTS();
     ret = __osMalloc(&gSystemArena, n);
     RESTORE_INTERRUPTS();
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_MALLOC, ret, NULL, n, NULL, 0);
 
     if (ret != NULL) {
         bzero(ret, n);
@@ -164,12 +180,14 @@ void SystemArena_Init(void* start, u32 size) {
     gSystemArenaLogSeverity = LOG_SEVERITY_NOLOG;
 #endif
     __osMallocInit(&gSystemArena, start, size);
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_INIT, start, NULL, size, NULL, 0);
 }
 
 void SystemArena_Cleanup(void) {
 #if DEBUG_FEATURES
     gSystemArenaLogSeverity = LOG_SEVERITY_NOLOG;
 #endif
+    ARENA_TRACE_RECORD(ARENA_TRACE_SYSTEM, ARENA_TRACE_OP_CLEANUP, NULL, NULL, 0, NULL, 0);
     __osMallocCleanup(&gSystemArena);
 }
 
@@ -31,7 +31,9 @@
 #include "assets/objects/object_cob/object_cob.h"
 #include "assets/objects/object_os_anime/object_os_anime.h"
 
-#define FLAGS (ACTOR_FLAG_ATTENTION_ENABLED | ACTOR_FLAG_FRIENDLY | ACTOR_FLAG_UPDATE_CULLING_DISABLED)
+#define FLAGS                                                                                    \
+    (ACTOR_FLAG_ATTENTION_ENABLED | ACTOR_FLAG_FRIENDLY | ACTOR_FLAG_UPDATE_CULLING_DISABLED | \
+     ACTOR_FLAG_UPDATE_LOD)
 
 void EnHy_Init(Actor* thisx, PlayState* play);
 void EnHy_Destroy(Actor* thisx, PlayState* play);
@@ -1184,6 +1186,14 @@ void EnHy_WaitForObjects(EnHy* this, PlayState* play) {
         EnHy_InitSetProperties(this);
         this->path = Path_GetByIndex(play, ENHY_GET_PATH_INDEX(&this->actor), 15);
 
+#if ACTOR_UPDATE_LOD
+        // Throttled updates would slow down their walk, as skipped frames are not made up
+        if ((ENHY_GET_TYPE(&this->actor) == ENHY_TYPE_MAN_2_BALD) ||
+            (ENHY_GET_TYPE(&this->actor) == ENHY_TYPE_OLD_MAN)) {
+            this->actor.flags &= ~ACTOR_FLAG_UPDATE_LOD;
+        }
+#endif
+
         switch (ENHY_GET_TYPE(&this->actor)) {
             case ENHY_TYPE_MAN_2_BALD:
                 if (this->path != NULL) {
@@ -0,0 +1,531 @@
+/**
+ * Replays an allocation trace recorded by the game with ARENA_TRACE (see src/code/arena_trace.c) against the arena
+ * allocator from src/libc64/__osMalloc_gc.c built for the host, and reports how the allocator copes with it: peak
+ * usage, fragmentation over time, allocations failing, and the time spent per call site.
+ *
+ * The trace is read from a log of the game's debug output containing the lines printed by ArenaTrace_Dump. Other
+ * lines are ignored. Only the records of one arena are replayed. An initialization record resets the simulated arena,
+ * records before the first one act on an arena of the size last reported by the game.
+ *
+ * Frees of blocks allocated before the start of the trace can't be replayed and are only counted. Traces start with
+ * the oldest record still in the game's ring buffer, so this happens unless the arena was initialized recently.
+ *
+ * ArenaNode holds pointers, so it is larger on a 64-bit host than on console and each block takes a little more of the
+ * arena. Usage and fragmentation are close to the game's but not identical, comparing allocators is what this is for.
+ *
+ * Usage: arena_replay_{firstfit,sizeclass} [-a zelda|system] [-s ARENA_SIZE] [-i FRAMES] [-n SITES] LOG
+ */
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "libc64/os_malloc.h"
+
+// Mirrors include/arena_trace.h, which can't be included here as it uses the game's types
+enum {
+    ARENA_TRACE_SYSTEM,
+    ARENA_TRACE_ZELDA,
+};
+
+enum {
+    ARENA_TRACE_OP_INIT,
+    ARENA_TRACE_OP_CLEANUP,
+    ARENA_TRACE_OP_MALLOC,
+    ARENA_TRACE_OP_MALLOC_R,
+    ARENA_TRACE_OP_REALLOC,
+    ARENA_TRACE_OP_FREE,
+};
+
+typedef struct Record {
+    int op;
+    u32 frame;
+    u32 size;
+    u32 ptr;
+    u32 oldPtr;
+    int site;
+} Record;
+
+typedef struct Site {
+    char* file;
+    int line;
+    u64 calls;
+    u64 failures;
+    u64 bytes;
+    u64 totalNs;
+    u64 maxNs;
+} Site;
+
+// Traced pointer to replayed pointer, open addressing
+typedef struct PtrMapEntry {
+    u32 key;
+    void* value;
+} PtrMapEntry;
+
+static Record* sRecords;
+static size_t sNumRecords;
+static Site* sSites;
+static size_t sNumSites;
+static PtrMapEntry* sPtrMap;
+static size_t sPtrMapCapacity;
+static size_t sPtrMapCount;
+static bool sVerbose;
+
+/* Stubs for the libultra functions used by the allocator */
+
+void osCreateMesgQueue(OSMesgQueue* mq, OSMesg* msg, s32 count) {
+}
+
+s32 osSendMesg(OSMesgQueue* mq, OSMesg msg, s32 flag) {
+    return 0;
+}
+
+s32 osRecvMesg(OSMesgQueue* mq, OSMesg* msg, s32 flag) {
+    return 0;
+}
+
+OSId osGetThreadId(OSThread* thread) {
+    return 0;
+}
+
+OSTime osGetTime(void) {
+    return 0;
+}
+
+void osSyncPrintf(const char* fmt, ...) {
+    va_list args;
+
+    if (sVerbose) {
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+    }
+}
+
+s32 Fault_Printf(const char* fmt, ...) {
+    return 0;
+}
+
+void Fault_SetFontColor(u16 color) {
+}
+
+/* Helpers */
+
+static void* xrealloc(void* p, size_t size) {
+    p = realloc(p, size);
+    if (p == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        exit(1);
+    }
+    return p;
+}
+
+static u64 get_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int get_site(const char* file, int line) {
+    size_t i;
+
+    // Few distinct sites, a linear search is fine while parsing
+    for (i = 0; i < sNumSites; i++) {
+        if (sSites[i].line == line && strcmp(sSites[i].file, file) == 0) {
+            return i;
+        }
+    }
+    sSites = xrealloc(sSites, (sNumSites + 1) * sizeof(Site));
+    memset(&sSites[sNumSites], 0, sizeof(Site));
+    sSites[sNumSites].file = strdup(file);
+    sSites[sNumSites].line = line;
+    return sNumSites++;
+}
+
+static size_t ptr_map_find(u32 key) {
+    size_t i = (key >> 4) * 2654435761u % sPtrMapCapacity;
+
+    while (sPtrMap[i].key != 0 && sPtrMap[i].key != key) {
+        i = (i + 1) % sPtrMapCapacity;
+    }
+    return i;
+}
+
+static void ptr_map_clear(void) {
+    memset(sPtrMap, 0, sPtrMapCapacity * sizeof(PtrMapEntry));
+    sPtrMapCount = 0;
+}
+
+static void ptr_map_put(u32 key, void* value) {
+    size_t i;
+
+    if ((sPtrMapCount + 1) * 2 > sPtrMapCapacity) {
+        PtrMapEntry* old = sPtrMap;
+        size_t oldCapacity = sPtrMapCapacity;
+
+        sPtrMapCapacity = (oldCapacity != 0) ? oldCapacity * 2 : 1024;
+        sPtrMap = calloc(sPtrMapCapacity, sizeof(PtrMapEntry));
+        sPtrMapCount = 0;
+        for (i = 0; i < oldCapacity; i++) {
+            if (old[i].key != 0) {
+                ptr_map_put(old[i].key, old[i].value);
+            }
+        }
+        free(old);
+    }
+
+    i = ptr_map_find(key);
+    if (sPtrMap[i].key == 0) {
+        sPtrMapCount++;
+    }
+    sPtrMap[i].key = key;
+    sPtrMap[i].value = value;
+}
+
+static void* ptr_map_take(u32 key) {
+    size_t i;
+    size_t j;
+    void* value;
+
+    if (sPtrMapCapacity == 0) {
+        return NULL;
+    }
+    i = ptr_map_find(key);
+    if (sPtrMap[i].key == 0) {
+        return NULL;
+    }
+    value = sPtrMap[i].value;
+
+    // Remove the entry, moving back the following entries of the cluster that may need its slot
+    sPtrMap[i].key = 0;
+    sPtrMapCount--;
+    for (j = (i + 1) % sPtrMapCapacity; sPtrMap[j].key != 0; j = (j + 1) % sPtrMapCapacity) {
+        PtrMapEntry entry = sPtrMap[j];
+
+        sPtrMap[j].key = 0;
+        sPtrMapCount--;
+        ptr_map_put(entry.key, entry.value);
+    }
+    return value;
+}
+
+/**
+ * Reads the records of `arena` from the log, and the size of the arena at its last initialization before the dump.
+ */
+static void read_trace(const char* path, int arena, u32* arenaSize) {
+    FILE* f = fopen(path, "r");
+    char line[1024];
+
+    if (f == NULL) {
+        fprintf(stderr, "Could not open %s: %s\n", path, strerror(errno));
+        exit(1);
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        unsigned int recArena;
+        unsigned int op;
+        unsigned int frame;
+        unsigned int size;
+        unsigned int ptr;
+        unsigned int oldPtr;
+        unsigned int fileLine;
+        unsigned int start;
+        int fileOffset;
+        char* file;
+        char* end;
+        Record* record;
+
+        // The log may hold other output, including on the same line as a record
+        char* p = strstr(line, "ARENATRACE");
+
+        if (p == NULL) {
+            continue;
+        }
+        end = p + strcspn(p, "\r\n");
+        *end = '\0';
+
+        if (sscanf(p, "ARENATRACE_ARENA %u %x %u", &recArena, &start, &size) == 3) {
+            if ((int)recArena == arena && size != 0) {
+                *arenaSize = size;
+            }
+            continue;
+        }
+        if (sscanf(p, "ARENATRACE %u %u %u %u %x %x %u %n", &recArena, &op, &frame, &size, &ptr, &oldPtr, &fileLine,
+                   &fileOffset) < 7 ||
+            (int)recArena != arena) {
+            continue;
+        }
+        file = p + fileOffset;
+
+        sRecords = xrealloc(sRecords, (sNumRecords + 1) * sizeof(Record));
+        record = &sRecords[sNumRecords++];
+        record->op = op;
+        record->frame = frame;
+        record->size = size;
+        record->ptr = ptr;
+        record->oldPtr = oldPtr;
+        record->site = get_site((*file != '\0') ? file : "-", fileLine);
+    }
+
+    fclose(f);
+}
+
+static int compare_sites(const void* a, const void* b) {
+    const Site* siteA = a;
+    const Site* siteB = b;
+
+    return (siteA->totalNs < siteB->totalNs) - (siteA->totalNs > siteB->totalNs);
+}
+
+static void usage(const char* progName) {
+    fprintf(stderr, "Usage: %s [-a zelda|system] [-s ARENA_SIZE] [-i FRAMES] [-n SITES] [-v] LOG\n", progName);
+    fprintf(stderr, "  -a  arena to replay (default: zelda)\n");
+    fprintf(stderr, "  -s  size of the simulated arena (default: the size in the trace)\n");
+    fprintf(stderr, "  -i  frames between fragmentation samples (default: 60)\n");
+    fprintf(stderr, "  -n  number of call sites to report (default: 20)\n");
+    fprintf(stderr, "  -v  print the allocator's debug output\n");
+    exit(1);
+}
+
+int main(int argc, char** argv) {
+    static Arena arena;
+    int arenaId = ARENA_TRACE_ZELDA;
+    u32 arenaSize = 0;
+    bool arenaSizeSet = false;
+    u32 interval = 60;
+    int numSitesShown = 20;
+    u8* memory = NULL;
+    size_t memorySize = 0;
+    bool initialized = false;
+    u32 nextSample = 0;
+    u64 liveBytes = 0;
+    u64 peakBytes = 0;
+    u64 gameFailures = 0;
+    u64 replayFailures = 0;
+    u64 unmatchedFrees = 0;
+    u64 totalNs = 0;
+    double fragSum = 0.0;
+    double fragMax = 0.0;
+    u64 numSamples = 0;
+    size_t i;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:s:i:n:v")) != -1) {
+        switch (opt) {
+            case 'a':
+                if (strcmp(optarg, "zelda") == 0) {
+                    arenaId = ARENA_TRACE_ZELDA;
+                } else if (strcmp(optarg, "system") == 0) {
+                    arenaId = ARENA_TRACE_SYSTEM;
+                } else {
+                    usage(argv[0]);
+                }
+                break;
+            case 's':
+                arenaSize = strtoul(optarg, NULL, 0);
+                arenaSizeSet = arenaSize != 0;
+                break;
+            case 'i':
+                interval = strtoul(optarg, NULL, 0);
+                if (interval == 0) {
+                    interval = 1;
+                }
+                break;
+            case 'n':
+                numSitesShown = atoi(optarg);
+                break;
+            case 'v':
+                sVerbose = true;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+    }
+
+    {
+        u32 tracedSize = 0;
+
+        read_trace(argv[optind], arenaId, &tracedSize);
+        if (arenaSize == 0) {
+            arenaSize = tracedSize;
+        }
+    }
+    if (sNumRecords == 0) {
+        fprintf(stderr, "No records for the %s arena in %s\n", arenaId == ARENA_TRACE_ZELDA ? "zelda" : "system",
+                argv[optind]);
+        return 1;
+    }
+    if (arenaSize == 0) {
+        fprintf(stderr, "The arena size isn't in the trace, pass it with -s\n");
+        return 1;
+    }
+
+    printf("%s allocator, %zu records, %zu call sites\n", ALLOCATOR_NAME, sNumRecords, sNumSites);
+    printf("%8s %10s %10s %10s %6s\n", "frame", "allocated", "free", "max free", "frag");
+
+    for (i = 0; i < sNumRecords; i++) {
+        Record* record = &sRecords[i];
+        Site* site = &sSites[record->site];
+        void* ptr = NULL;
+        u64 start;
+        u64 ns;
+
+        if (record->op == ARENA_TRACE_OP_INIT || !initialized) {
+            // The size given with -s replaces the traced one, to see how the same allocations fit in another size
+            size_t size = (record->op == ARENA_TRACE_OP_INIT && !arenaSizeSet) ? record->size : arenaSize;
+
+            if (memory != NULL) {
+                munmap(memory, memorySize);
+            }
+            // The allocator stores pointers in u32, so the arena must be in the low 4GB
+            memorySize = size;
+            memory = mmap(NULL, memorySize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS
+#ifdef MAP_32BIT
+                              | MAP_32BIT
+#endif
+                          ,
+                          -1, 0);
+            if (memory == MAP_FAILED) {
+                fprintf(stderr, "Could not allocate a 0x%zX bytes arena\n", memorySize);
+                return 1;
+            }
+            __osMallocInit(&arena, memory, memorySize);
+            ptr_map_clear();
+            liveBytes = 0;
+            initialized = true;
+            if (record->op == ARENA_TRACE_OP_INIT) {
+                continue;
+            }
+        }
+
+        if (record->frame >= nextSample) {
+            u32 maxFree;
+            u32 freeSize;
+            u32 allocSize;
+            double frag;
+
+            ArenaImpl_GetSizes(&arena, &maxFree, &freeSize, &allocSize);
+            frag = (freeSize != 0) ? 1.0 - (double)maxFree / freeSize : 0.0;
+            printf("%8u %10u %10u %10u %5.1f%%\n", record->frame, allocSize, freeSize, maxFree, frag * 100);
+            fragSum += frag;
+            if (frag > fragMax) {
+                fragMax = frag;
+            }
+            numSamples++;
+            nextSample = record->frame - record->frame % interval + interval;
+        }
+
+        switch (record->op) {
+            case ARENA_TRACE_OP_MALLOC:
+            case ARENA_TRACE_OP_MALLOC_R:
+                start = get_ns();
+                if (record->op == ARENA_TRACE_OP_MALLOC) {
+                    ptr = __osMallocDebug(&arena, record->size, site->file, site->line);
+                } else {
+                    ptr = __osMallocRDebug(&arena, record->size, site->file, site->line);
+                }
+                ns = get_ns() - start;
+
+                if (record->ptr == 0) {
+                    gameFailures++;
+                }
+                if (ptr == NULL) {
+                    replayFailures++;
+                    site->failures++;
+                } else {
+                    ptr_map_put(record->ptr != 0 ? record->ptr : (u32)(uintptr_t)ptr, ptr);
+                    liveBytes += ((ArenaNode*)ptr - 1)->size;
+                    site->bytes += record->size;
+                }
+                break;
+
+            case ARENA_TRACE_OP_REALLOC: {
+                void* oldPtr = (record->oldPtr != 0) ? ptr_map_take(record->oldPtr) : NULL;
+                u32 oldSize = (oldPtr != NULL) ? ((ArenaNode*)oldPtr - 1)->size : 0;
+
+                start = get_ns();
+                ptr = __osReallocDebug(&arena, oldPtr, record->size, site->file, site->line);
+                ns = get_ns() - start;
+
+                if (ptr == NULL && record->size != 0) {
+                    replayFailures++;
+                    site->failures++;
+                    if (oldPtr != NULL) {
+                        ptr_map_put(record->oldPtr, oldPtr);
+                    }
+                } else {
+                    liveBytes -= oldSize;
+                    if (ptr != NULL) {
+                        ptr_map_put(record->ptr != 0 ? record->ptr : (u32)(uintptr_t)ptr, ptr);
+                        liveBytes += ((ArenaNode*)ptr - 1)->size;
+                        site->bytes += record->size;
+                    }
+                }
+                break;
+            }
+
+            case ARENA_TRACE_OP_FREE:
+                if (record->ptr == 0) {
+                    continue;
+                }
+                ptr = ptr_map_take(record->ptr);
+                if (ptr == NULL) {
+                    unmatchedFrees++;
+                    continue;
+                }
+                liveBytes -= ((ArenaNode*)ptr - 1)->size;
+
+                start = get_ns();
+                __osFreeDebug(&arena, ptr, site->file, site->line);
+                ns = get_ns() - start;
+                break;
+
+            default:
+                continue;
+        }
+
+        site->calls++;
+        site->totalNs += ns;
+        if (ns > site->maxNs) {
+            site->maxNs = ns;
+        }
+        totalNs += ns;
+        if (liveBytes > peakBytes) {
+            peakBytes = liveBytes;
+        }
+    }
+
+    printf("\n");
+    printf("Peak usage:            %llu bytes\n", (unsigned long long)peakBytes);
+    printf("Fragmentation:         %.1f%% average, %.1f%% max (1 - largest free block / free space)\n",
+           numSamples != 0 ? fragSum / numSamples * 100 : 0.0, fragMax * 100);
+    printf("Failed allocations:    %llu in the replay, %llu in the game\n", (unsigned long long)replayFailures,
+           (unsigned long long)gameFailures);
+    printf("Unmatched frees:       %llu (blocks allocated before the start of the trace)\n",
+           (unsigned long long)unmatchedFrees);
+    printf("Time in the allocator: %.3f ms\n", totalNs / 1e6);
+
+    qsort(sSites, sNumSites, sizeof(Site), compare_sites);
+    printf("\n%10s %8s %10s %10s %6s  %s\n", "total us", "calls", "avg ns", "max ns", "fails", "site");
+    for (i = 0; i < sNumSites && (int)i < numSitesShown; i++) {
+        Site* site = &sSites[i];
+
+        if (site->calls == 0) {
+            break;
+        }
+        printf("%10.1f %8llu %10llu %10llu %6llu  %s:%d\n", site->totalNs / 1e3, (unsigned long long)site->calls,
+               (unsigned long long)(site->totalNs / site->calls), (unsigned long long)site->maxNs,
+               (unsigned long long)site->failures, site->file, site->line);
+    }
+
+    return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef FAULT_H
+#define FAULT_H
+
+// Stand-in for the crash screen functions used by src/libc64/__osMalloc_gc.c
+
+#include "ultra64.h"
+
+s32 Fault_Printf(const char* fmt, ...);
+void Fault_SetFontColor(u16 color);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef TRANSLATION_H
+#define TRANSLATION_H
+
+#define T(jp, en) en
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef ULTRA64_H
+#define ULTRA64_H
+
+// Minimal stand-in for the libultra header, enough to build src/libc64/__osMalloc_gc.c for the host
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+
+typedef void* OSMesg;
+typedef s32 OSId;
+typedef u64 OSTime;
+typedef struct OSThread OSThread;
+
+typedef struct OSMesgQueue {
+    OSMesg* msg;
+    s32 validCount;
+    s32 msgCount;
+} OSMesgQueue;
+
+#define OS_MESG_NOBLOCK 0
+#define OS_MESG_BLOCK 1
+
+#define OS_CYCLES_TO_NSEC(c) (c)
+
+void osCreateMesgQueue(OSMesgQueue* mq, OSMesg* msg, s32 count);
+s32 osSendMesg(OSMesgQueue* mq, OSMesg msg, s32 flag);
+s32 osRecvMesg(OSMesgQueue* mq, OSMesg* msg, s32 flag);
+OSId osGetThreadId(OSThread* thread);
+OSTime osGetTime(void);
+void osSyncPrintf(const char* fmt, ...);
+
+#endif
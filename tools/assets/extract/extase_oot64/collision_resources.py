@@ -1,6 +1,7 @@
 # SPDX-FileCopyrightText: © 2025 ZeldaRET
 # SPDX-License-Identifier: CC0-1.0
 
+import io
 from typing import TYPE_CHECKING, Optional
 
 if TYPE_CHECKING:
@@ -26,6 +27,14 @@ from ..extase.cdata_resources import (
 
 from .. import oot64_data
 
+from . import static_lookup
+
+# Whether to build the CollisionBvh and the baked StaticLookup tables of scene collision,
+# for COLLISION_BVH and COLLISION_BAKED_LOOKUP. Set by the extraction's command line options,
+# as they are slow to build and only used by builds with these options.
+BUILD_BVH = False
+BUILD_BAKED_LOOKUP = False
+
 # TODO would be better for array resources to be of unknown size at instanciation
 # and have their size set later, like LimbsArrayResource,
 # which allows declaring them with offsets in xmls and have the data parsing
@@ -482,6 +491,68 @@ class CollisionWaterBoxesResource(CDataResource):
         return ("bgcheck.h",)
 
 
+# Must match CollisionBvh traversal in z_bgcheck.c: the traversal stack holds at most one node per level plus one
+BVH_DEPTH_MAX = 47  # BGCHECK_BVH_STACK_MAX - 1
+BVH_LEAF_POLYS_MAX = 4
+
+
+def build_collision_bvh(vtxList: list, polyList: list):
+    """Build a bounding volume hierarchy of the polys, for CollisionBvh.
+
+    Nodes are split at the median of the poly centers, along the axis the centers spread the most on.
+    The two children of a node are next to each other in the node list.
+
+    Returns (nodes, polyIds), nodes being a list of (min, max, start, count) tuples with the root first.
+    """
+    poly_bounds = []
+    for poly in polyList:
+        vtxs = [vtxList[vI & 0x1FFF] for vI in poly["vtxData"]]
+        poly_bounds.append(
+            (
+                tuple(min(vtx[axis] for vtx in vtxs) for axis in "xyz"),
+                tuple(max(vtx[axis] for vtx in vtxs) for axis in "xyz"),
+            )
+        )
+    # doubled, to stay integers
+    poly_centers = [
+        tuple(bmin[i] + bmax[i] for i in range(3)) for bmin, bmax in poly_bounds
+    ]
+
+    nodes: list = [None]
+    polyIds: list[int] = []
+    stack = [(0, list(range(len(polyList))), 0)]
+    while stack:
+        node_index, ids, depth = stack.pop()
+        node_min = tuple(min(poly_bounds[i][0][axis] for i in ids) for axis in range(3))
+        node_max = tuple(max(poly_bounds[i][1][axis] for i in ids) for axis in range(3))
+
+        if len(ids) <= BVH_LEAF_POLYS_MAX:
+            nodes[node_index] = (node_min, node_max, len(polyIds), len(ids))
+            polyIds.extend(ids)
+            continue
+
+        assert depth < BVH_DEPTH_MAX, depth
+
+        split_axis = max(
+            range(3),
+            key=lambda axis: (
+                max(poly_centers[i][axis] for i in ids)
+                - min(poly_centers[i][axis] for i in ids)
+            ),
+        )
+        ids = sorted(ids, key=lambda i: (poly_centers[i][split_axis], i))
+        half = len(ids) // 2
+
+        first_child_index = len(nodes)
+        nodes.extend((None, None))
+        nodes[node_index] = (node_min, node_max, first_child_index, 0)
+        stack.append((first_child_index + 1, ids[half:], depth + 1))
+        stack.append((first_child_index, ids[:half], depth + 1))
+
+    assert len(nodes) <= 0xFFFF, len(nodes)
+    return nodes, polyIds
+
+
 def transfer_HACK_IS_STATIC_ON(source, dest):
     if hasattr(source, "HACK_IS_STATIC_ON"):
         dest.HACK_IS_STATIC_ON = source.HACK_IS_STATIC_ON
@@ -508,7 +579,7 @@ class CollisionResource(CDataResource):
     ):
         assert isinstance(v, int)
         address = v
-        memory_context.report_resource_at_segmented(
+        resource.resource_vtxList = memory_context.report_resource_at_segmented(
             resource,
             address,
             CollisionVtxListResource,
@@ -713,6 +784,11 @@ class CollisionResource(CDataResource):
 
         self.length_exitList: Optional[int] = None
 
+        # Set by the scene commands for the scene's collision, which gets a CollisionBvh and a CollisionBakedLookup
+        self.is_scene_collision = False
+        self.scene_cam_type = None
+
+        self.resource_vtxList: Optional[CollisionVtxListResource] = None
         self.resource_polyList: Optional[CollisionPolyListResource] = None
         self.resource_surfaceTypeList: Optional[CollisionSurfaceTypeListResource] = None
         self.resource_bgCamList: Optional[CollisionBgCamListResource] = None
@@ -816,6 +892,138 @@ class CollisionResource(CDataResource):
         )
         return RESOURCE_PARSE_SUCCESS
 
+    def has_bvh(self):
+        return self.is_scene_collision and self.cdata_unpacked["numPolygons"] != 0
+
+    def get_bvh_filename_stem(self):
+        return f"{self.get_filename_stem()}_Bvh"
+
+    def get_baked_lookup_filename_stem(self):
+        return f"{self.get_filename_stem()}_Baked"
+
+    def write_extracted(self, memory_context):
+        super().write_extracted(memory_context)
+
+        if not self.has_bvh():
+            return
+
+        assert self.resource_vtxList is not None
+        assert self.resource_polyList is not None
+        vtxList = self.resource_vtxList.cdata_unpacked
+        polyList = self.resource_polyList.cdata_unpacked
+
+        if BUILD_BVH:
+            self.write_extracted_bvh(vtxList, polyList)
+        if BUILD_BAKED_LOOKUP:
+            self.write_extracted_baked_lookup(vtxList, polyList)
+
+    def write_extracted_bvh(self, vtxList, polyList):
+        nodes, polyIds = build_collision_bvh(vtxList, polyList)
+
+        with self.extract_to_path.with_name(
+            self.get_bvh_filename_stem() + ".inc.c"
+        ).open("w") as f:
+            f.write(f"static CollisionBvhNode {self.symbol_name}_BvhNodes[] = {{\n")
+            for node_min, node_max, start, count in nodes:
+                f.write(
+                    f"{INDENT}{{ {{ {node_min[0]}, {node_min[1]}, {node_min[2]} }},"
+                    f" {{ {node_max[0]}, {node_max[1]}, {node_max[2]} }}, {start}, {count} }},\n"
+                )
+            f.write("};\n")
+            f.write("\n")
+            f.write(f"static u16 {self.symbol_name}_BvhPolyIds[] = {{\n")
+            for i in range(0, len(polyIds), 16):
+                f.write(INDENT)
+                f.write(" ".join(f"{polyId}," for polyId in polyIds[i : i + 16]))
+                f.write("\n")
+            f.write("};\n")
+            f.write("\n")
+            f.write(f"static CollisionBvh {self.symbol_name}_Bvh = {{\n")
+            f.write(f"{INDENT}ARRAY_COUNT({self.symbol_name}_BvhNodes),\n")
+            f.write(f"{INDENT}{self.symbol_name}_BvhNodes,\n")
+            f.write(f"{INDENT}{self.symbol_name}_BvhPolyIds,\n")
+            f.write("};\n")
+
+    def write_extracted_baked_lookup(self, vtxList, polyList):
+        subdivAmount = static_lookup.get_subdivision_amount(
+            self.file.name, self.scene_cam_type
+        )
+        lookupTbl, ssNodes = static_lookup.StaticLookupBuilder(
+            [(vtx["x"], vtx["y"], vtx["z"]) for vtx in vtxList],
+            polyList,
+            tuple(self.cdata_unpacked["minBounds"][axis] for axis in "xyz"),
+            tuple(self.cdata_unpacked["maxBounds"][axis] for axis in "xyz"),
+            subdivAmount,
+        ).build()
+        # SS_NULL can't be a node index
+        assert len(ssNodes) < static_lookup.SS_NULL, len(ssNodes)
+
+        with self.extract_to_path.with_name(
+            self.get_baked_lookup_filename_stem() + ".inc.c"
+        ).open("w") as f:
+            f.write(f"static StaticLookup {self.symbol_name}_BakedLookupTbl[] = {{\n")
+            for floor, wall, ceiling in lookupTbl:
+                f.write(
+                    f"{INDENT}{{ {{ {floor} }}, {{ {wall} }}, {{ {ceiling} }} }},\n"
+                )
+            f.write("};\n")
+            f.write("\n")
+            f.write(f"static SSNode {self.symbol_name}_BakedNodes[] = {{\n")
+            for polyId, nextNodeId in ssNodes:
+                f.write(f"{INDENT}{{ {polyId}, {nextNodeId} }},\n")
+            f.write("};\n")
+            f.write("\n")
+            f.write(
+                f"static CollisionBakedLookup {self.symbol_name}_BakedLookup = {{\n"
+            )
+            f.write(
+                f"{INDENT}{{ {subdivAmount[0]}, {subdivAmount[1]}, {subdivAmount[2]} }},\n"
+            )
+            f.write(f"{INDENT}ARRAY_COUNT({self.symbol_name}_BakedNodes),\n")
+            f.write(f"{INDENT}{self.symbol_name}_BakedLookupTbl,\n")
+            f.write(f"{INDENT}{self.symbol_name}_BakedNodes,\n")
+            f.write("};\n")
+
+    def write_c_definition(self, c: io.TextIOBase):
+        if not self.has_bvh():
+            return super().write_c_definition(c)
+
+        bvh_inc_c_path = self.inc_c_path.with_name(
+            self.get_bvh_filename_stem() + ".inc.c"
+        )
+        baked_lookup_inc_c_path = self.inc_c_path.with_name(
+            self.get_baked_lookup_filename_stem() + ".inc.c"
+        )
+        # Building with an option whose data was not extracted fails here rather than at link time
+        c.write("#if COLLISION_BVH\n")
+        if BUILD_BVH:
+            c.write(f'#include "{bvh_inc_c_path}"\n')
+        else:
+            c.write(
+                '#error "Extracted without COLLISION_BVH, run make setup with it"\n'
+            )
+        c.write("#endif\n")
+        c.write("#if COLLISION_BAKED_LOOKUP\n")
+        if BUILD_BAKED_LOOKUP:
+            c.write(f'#include "{baked_lookup_inc_c_path}"\n')
+        else:
+            c.write(
+                '#error "Extracted without COLLISION_BAKED_LOOKUP, run make setup with it"\n'
+            )
+        c.write("#endif\n")
+        c.write("\n")
+        c.write(self.get_c_declaration_base())
+        c.write(" = {\n")
+        c.write(f'#include "{self.inc_c_path}"\n')
+        c.write("#if COLLISION_BVH\n")
+        c.write(f"{INDENT}&{self.symbol_name}_Bvh, // bvh\n")
+        c.write("#endif\n")
+        c.write("#if COLLISION_BAKED_LOOKUP\n")
+        c.write(f"{INDENT}&{self.symbol_name}_BakedLookup, // bakedLookup\n")
+        c.write("#endif\n")
+        c.write("};\n")
+        return True
+
     def get_c_declaration_base(self):
         return f"CollisionHeader {self.symbol_name}"
 
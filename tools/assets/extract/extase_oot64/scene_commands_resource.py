@@ -3,7 +3,7 @@
 
 import enum
 import struct
-from typing import TYPE_CHECKING
+from typing import TYPE_CHECKING, Optional
 
 if TYPE_CHECKING:
     from ..extase.memorymap import MemoryContext
@@ -109,6 +109,8 @@ class SceneCommandsResource(Resource, can_size_be_unknown=True):
         self.player_entry_list_length = None
         self.room_list_length = None
         self.exit_list_length = None
+        self.resource_collision: Optional[collision_resources.CollisionResource] = None
+        self.scene_cam_type = None
 
     def try_parse_data(self, memory_context: "MemoryContext"):
         data = self.file.data[self.range_start :]
@@ -204,6 +206,8 @@ class SceneCommandsResource(Resource, can_size_be_unknown=True):
                         file, offset, f"{self.name}_{data2_I:08X}_Col"
                     ),
                 )
+                resource.is_scene_collision = True
+                self.resource_collision = resource
                 new_progress_done.append(("reported CollisionResource", cmd_id))
                 if resource.is_data_parsed:
                     self.exit_list_length = resource.length_exitList
@@ -220,6 +224,10 @@ class SceneCommandsResource(Resource, can_size_be_unknown=True):
                         )
                     )
 
+            if cmd_id == SceneCmdId.SCENE_CMD_ID_MISC_SETTINGS:
+                # The collision StaticLookup subdivisions depend on it, see BgCheck_Allocate
+                self.scene_cam_type = data1
+
             if cmd_id == SceneCmdId.SCENE_CMD_ID_SPAWN_LIST:
                 assert data1 == 0
                 resource = memory_context.report_resource_at_segmented(
@@ -380,6 +388,9 @@ class SceneCommandsResource(Resource, can_size_be_unknown=True):
             raise Exception("reached end of data without encountering end marker")
         assert end_offset is not None
 
+        if self.resource_collision is not None and self.scene_cam_type is not None:
+            self.resource_collision.scene_cam_type = self.scene_cam_type
+
         # Nothing to parse for these commands
         found_commands.discard(SceneCmdId.SCENE_CMD_ID_SOUND_SETTINGS)
         found_commands.discard(SceneCmdId.SCENE_CMD_ID_MISC_SETTINGS)
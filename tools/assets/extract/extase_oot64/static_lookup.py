@@ -0,0 +1,658 @@
+# SPDX-FileCopyrightText: © 2025 ZeldaRET
+# SPDX-License-Identifier: CC0-1.0
+
+"""Offline build of the scene collision StaticLookup tables.
+
+This mirrors BgCheck_Allocate and BgCheck_InitializeStaticLookup in src/code/z_bgcheck.c,
+and the sys_math3d.c functions they use, down to the order of the f32 operations and the
+order the SSNodes are allocated in, so the tables are identical to the ones built at runtime.
+`make check-baked-lookup` checks that against the C functions built for the host.
+"""
+
+import struct
+
+from .. import oot64_data
+
+_f32_struct = struct.Struct(">f")
+
+
+def f32(v: float) -> float:
+    """Round to the nearest f32, like every f32 operation does on the console"""
+    return _f32_struct.unpack(_f32_struct.pack(v))[0]
+
+
+# f32 constants from the C sources
+F_0_5 = f32(0.5)
+F_0_008 = f32(0.008)
+F_1_0 = 1.0
+F_300_0 = 300.0
+COLPOLY_NORMAL_FRAC = f32(1.0 / 32767.0)  # (1.0f / SHT_MAX)
+
+BGCHECK_SUBDIV_OVERLAP = 50
+BGCHECK_SUBDIV_MIN = 150.0
+
+SS_NULL = 0xFFFF
+
+
+def COLPOLY_SNORMAL(x: float):
+    # ((s16)((x) * SHT_MAX))
+    return int(f32(f32(x) * 32767.0))
+
+
+def COLPOLY_VTX_INDEX(vI: int):
+    return vI & 0x1FFF
+
+
+def IS_ZERO(f: float):
+    return abs(f) < F_0_008
+
+
+def add(a, b):
+    return f32(a + b)
+
+
+def sub(a, b):
+    return f32(a - b)
+
+
+def mul(a, b):
+    return f32(a * b)
+
+
+def div(a, b):
+    return f32(a / b)
+
+
+def sq(a):
+    return f32(a * a)
+
+
+def c_mod(a: int, b: int):
+    """C's %, which truncates toward zero"""
+    r = abs(a) % abs(b)
+    return -r if a < 0 else r
+
+
+# BgCheck_Allocate
+
+SCENE_CAM_TYPE_FIXED_SHOP_VIEWPOINT = 0x10
+SCENE_CAM_TYPE_FIXED_TOGGLE_VIEWPOINT = 0x20
+SCENE_CAM_TYPE_FIXED = 0x30
+SCENE_CAM_TYPE_FIXED_MARKET = 0x40
+
+
+def get_subdivision_amount(scene_file_name: str, scene_cam_type: int):
+    if scene_cam_type in {
+        SCENE_CAM_TYPE_FIXED_SHOP_VIEWPOINT,
+        SCENE_CAM_TYPE_FIXED_TOGGLE_VIEWPOINT,
+        SCENE_CAM_TYPE_FIXED,
+        SCENE_CAM_TYPE_FIXED_MARKET,
+    }:
+        return (2, 2, 2)
+    # sceneSubdivisionList, see oot64_data/scene_subdivisions.py
+    subdivAmount = oot64_data.get_scene_subdivision_amount(scene_file_name)
+    if subdivAmount is not None:
+        return subdivAmount
+    # spot scenes use the default subdivisions too
+    return (16, 4, 16)
+
+
+def set_subdivision_dimension(min: float, subdivAmount: int, max: float):
+    """BgCheck_SetSubdivisionDimension, returns (max, subdivLength, subdivLengthInv)"""
+    length = sub(max, min)
+
+    subdivLength = float(int(div(length, float(subdivAmount))) + 1)
+    if subdivLength < BGCHECK_SUBDIV_MIN:
+        subdivLength = BGCHECK_SUBDIV_MIN
+    subdivLengthInv = div(1.0, subdivLength)
+
+    max = add(mul(subdivLength, float(subdivAmount)), min)
+    return max, subdivLength, subdivLengthInv
+
+
+# sys_math3d.c
+
+
+def point_relative_to_cube_faces(point, min, max):
+    ret = 0
+    if point[0] > max[0]:
+        ret = 1
+    if point[0] < min[0]:
+        ret |= 2
+    if point[1] > max[1]:
+        ret |= 4
+    if point[1] < min[1]:
+        ret |= 8
+    if point[2] > max[2]:
+        ret |= 0x10
+    if point[2] < min[2]:
+        ret |= 0x20
+    return ret
+
+
+def point_relative_to_cube_edges(point, min, max):
+    px, py, pz = point
+    ret = 0
+    if add(-min[0], max[1]) < add(-px, py):
+        ret |= 1
+    if add(-px, py) < add(-max[0], min[1]):
+        ret |= 2
+    if add(max[0], max[1]) < add(px, py):
+        ret |= 4
+    if add(px, py) < add(min[0], min[1]):
+        ret |= 8
+    if add(-min[2], max[1]) < add(-pz, py):
+        ret |= 0x10
+    if add(-pz, py) < add(-max[2], min[1]):
+        ret |= 0x20
+    if add(max[2], max[1]) < add(pz, py):
+        ret |= 0x40
+    if add(pz, py) < add(min[2], min[1]):
+        ret |= 0x80
+    if add(-min[2], max[0]) < add(-pz, px):
+        ret |= 0x100
+    if add(-pz, px) < add(-max[2], min[0]):
+        ret |= 0x200
+    if add(max[2], max[0]) < add(pz, px):
+        ret |= 0x400
+    if add(pz, px) < add(min[2], min[0]):
+        ret |= 0x800
+    return ret
+
+
+def point_relative_to_cube_vertices(point, min, max):
+    px, py, pz = point
+    ret = 0
+    if add(add(max[0], max[1]), max[2]) < add(add(px, py), pz):
+        ret = 1
+    if add(add(-min[0], max[1]), max[2]) < add(add(-px, py), pz):
+        ret |= 2
+    if sub(add(-min[0], max[1]), min[2]) < sub(add(-px, py), pz):
+        ret |= 4
+    if sub(add(max[0], max[1]), min[2]) < sub(add(px, py), pz):
+        ret |= 8
+    if add(sub(max[0], min[1]), max[2]) < add(sub(px, py), pz):
+        ret |= 0x10
+    # The next 2 conditions are the same check, like in Math3D_PointRelativeToCubeVertices
+    if add(sub(-min[0], min[1]), max[2]) < add(sub(-px, py), pz):
+        ret |= 0x20
+    if add(sub(-min[0], min[1]), max[2]) < add(sub(-px, py), pz):
+        ret |= 0x40
+    if sub(sub(-min[0], min[1]), min[2]) < sub(sub(-px, py), pz):
+        ret |= 0x80
+    return ret
+
+
+def cir_square_vs_tri_square(x0, y0, x1, y1, x2, y2, centerX, centerY, radius):
+    minX = maxX = x0
+    minY = maxY = y0
+
+    if x1 < minX:
+        minX = x1
+    elif maxX < x1:
+        maxX = x1
+
+    if y1 < minY:
+        minY = y1
+    elif maxY < y1:
+        maxY = y1
+
+    if x2 < minX:
+        minX = x2
+    elif maxX < x2:
+        maxX = x2
+
+    if y2 < minY:
+        minY = y2
+    elif maxY < y2:
+        maxY = y2
+
+    return (
+        sub(minX, radius) <= centerX
+        and add(maxX, radius) >= centerX
+        and sub(minY, radius) <= centerY
+        and add(maxY, radius) >= centerY
+    )
+
+
+def point_dist_sq_to_line_2d(x0, y0, x1, y1, x2, y2):
+    """Math3D_PointDistSqToLine2D, returns (ret, lineLenSq)"""
+    xDiff = sub(x2, x1)
+    yDiff = sub(y2, y1)
+    distSq = add(sq(xDiff), sq(yDiff))
+    if IS_ZERO(distSq):
+        return False, 0.0
+
+    perpendicularRatio = div(
+        add(mul(sub(x0, x1), xDiff), mul(sub(y0, y1), yDiff)), distSq
+    )
+    ret = perpendicularRatio >= 0.0 and perpendicularRatio <= 1.0
+    perpendicularPointX = add(mul(xDiff, perpendicularRatio), x1)
+    perpendicularPointY = add(mul(yDiff, perpendicularRatio), y1)
+    return ret, add(sq(sub(perpendicularPointX, x0)), sq(sub(perpendicularPointY, y0)))
+
+
+def tri_chk_point_para_impl(a0, b0, a1, b1, a2, b2, a, b, detMax, chkDist, n):
+    """Math3D_TriChkPointParaXImpl/YImpl/ZImpl, on the (a, b) components:
+    (y, z) for X, (z, x) for Y, (x, y) for Z
+    """
+    if not cir_square_vs_tri_square(a0, b0, a1, b1, a2, b2, a, b, chkDist):
+        return False
+
+    chkDistSq = sq(chkDist)
+
+    if (
+        add(sq(sub(a0, a)), sq(sub(b0, b))) < chkDistSq
+        or add(sq(sub(a1, a)), sq(sub(b1, b))) < chkDistSq
+        or add(sq(sub(a2, a)), sq(sub(b2, b))) < chkDistSq
+    ):
+        return True
+
+    detv0v1 = sub(mul(sub(a0, a), sub(b1, b)), mul(sub(b0, b), sub(a1, a)))
+    detv1v2 = sub(mul(sub(a1, a), sub(b2, b)), mul(sub(b1, b), sub(a2, a)))
+    detv2v0 = sub(mul(sub(a2, a), sub(b0, b)), mul(sub(b2, b), sub(a0, a)))
+
+    if (detMax >= detv0v1 and detMax >= detv1v2 and detMax >= detv2v0) or (
+        -detMax <= detv0v1 and -detMax <= detv1v2 and -detMax <= detv2v0
+    ):
+        return True
+
+    if abs(n) > F_0_5:
+        for (ea0, eb0), (ea1, eb1) in (
+            ((a0, b0), (a1, b1)),
+            ((a1, b1), (a2, b2)),
+            ((a2, b2), (a0, b0)),
+        ):
+            ret, distToEdgeSq = point_dist_sq_to_line_2d(a, b, ea0, eb0, ea1, eb1)
+            if ret and distToEdgeSq < chkDistSq:
+                return True
+
+    return False
+
+
+def tri_chk_point_para_x(v0, v1, v2, nx, y, z):
+    if IS_ZERO(nx):
+        return False
+    return tri_chk_point_para_impl(
+        v0[1], v0[2], v1[1], v1[2], v2[1], v2[2], y, z, F_300_0, F_1_0, nx
+    )
+
+
+def tri_chk_point_para_y(v0, v1, v2, ny, z, x):
+    if IS_ZERO(ny):
+        return False
+    return tri_chk_point_para_impl(
+        v0[2], v0[0], v1[2], v1[0], v2[2], v2[0], z, x, F_300_0, F_1_0, ny
+    )
+
+
+def tri_chk_point_para_z(v0, v1, v2, nz, x, y):
+    if IS_ZERO(nz):
+        return False
+    return tri_chk_point_para_impl(
+        v0[0], v0[1], v1[0], v1[1], v2[0], v2[1], x, y, F_300_0, F_1_0, nz
+    )
+
+
+def planef(nx, ny, nz, originDist, point):
+    return add(add(add(mul(nx, point[0]), mul(ny, point[1])), mul(nz, point[2])), originDist)
+
+
+def tri_chk_line_seg_para_intersect(v0, v1, v2, n, originDist, axis, a, b, c0, c1):
+    """Math3D_TriChkLineSegParaXIntersect/YIntersect/ZIntersect, for the segment along `axis`
+    from `c0` to `c1`, at (a, b) on the other components: (y, z) for X, (z, x) for Y, (x, y) for Z
+    """
+    if IS_ZERO(n[axis]):
+        return False
+
+    planePosA = [0.0, 0.0, 0.0]
+    planePosA[axis] = c0
+    planePosA[(axis + 1) % 3] = a
+    planePosA[(axis + 2) % 3] = b
+    planePosB = list(planePosA)
+    planePosB[axis] = c1
+    pointADist = planef(n[0], n[1], n[2], originDist, planePosA)
+    pointBDist = planef(n[0], n[1], n[2], originDist, planePosB)
+
+    if (pointADist > 0.0 and pointBDist > 0.0) or (pointADist < 0.0 and pointBDist < 0.0):
+        return False
+
+    if axis == 0:
+        return tri_chk_point_para_x(v0, v1, v2, n[0], a, b)
+    if axis == 1:
+        return tri_chk_point_para_y(v0, v1, v2, n[1], a, b)
+    return tri_chk_point_para_z(v0, v1, v2, n[2], a, b)
+
+
+def line_seg_vs_plane(nx, ny, nz, originDist, linePointA, linePointB):
+    """Math3D_LineSegVsPlane with fromFront = false, returns (ret, intersect)"""
+    pointADist = planef(nx, ny, nz, originDist, linePointA)
+    pointBDist = planef(nx, ny, nz, originDist, linePointB)
+
+    if mul(pointADist, pointBDist) > 0.0:
+        return False, linePointB
+
+    # Math3D_LineSegFindPlaneIntersect
+    distDiff = sub(pointADist, pointBDist)
+    if IS_ZERO(distDiff):
+        return False, linePointB
+
+    if pointADist == 0.0:
+        return True, linePointA
+    if pointBDist == 0.0:
+        return True, linePointB
+
+    # Math3D_LineSplitRatio
+    ratio = div(pointADist, distDiff)
+    return True, tuple(
+        add(mul(sub(linePointB[i], linePointA[i]), ratio), linePointA[i]) for i in range(3)
+    )
+
+
+def tri_line_intersect(v0, v1, v2, nx, ny, nz, originDist, linePointA, linePointB):
+    ret, intersect = line_seg_vs_plane(nx, ny, nz, originDist, linePointA, linePointB)
+    if not ret:
+        return False
+
+    return (
+        (nx == 0.0 or tri_chk_point_para_x(v0, v1, v2, nx, intersect[1], intersect[2]))
+        and (ny == 0.0 or tri_chk_point_para_y(v0, v1, v2, ny, intersect[2], intersect[0]))
+        and (nz == 0.0 or tri_chk_point_para_z(v0, v1, v2, nz, intersect[0], intersect[1]))
+    )
+
+
+def line_vs_cube(min, max, a, b):
+    flags0 = point_relative_to_cube_faces(a, min, max)
+    if not flags0:
+        return True
+
+    flags1 = point_relative_to_cube_faces(b, min, max)
+    if not flags1:
+        return True
+
+    if flags0 & flags1:
+        return False
+
+    flags0 |= point_relative_to_cube_edges(a, min, max) << 8
+    flags1 |= point_relative_to_cube_edges(b, min, max) << 8
+    if flags0 & flags1:
+        return False
+
+    flags0 |= point_relative_to_cube_vertices(a, min, max) << 0x18
+    flags1 |= point_relative_to_cube_vertices(b, min, max) << 0x18
+    if flags0 & flags1:
+        return False
+
+    minX, minY, minZ = min
+    maxX, maxY, maxZ = max
+    tris = (
+        # face 1
+        ((minX, minY, minZ), (minX, minY, maxZ), (minX, maxY, maxZ), (-1.0, 0.0, 0.0, minX)),
+        ((minX, minY, minZ), (minX, maxY, maxZ), (minX, maxY, minZ), (-1.0, 0.0, 0.0, minX)),
+        # face 2
+        ((minX, maxY, maxZ), (minX, minY, maxZ), (maxX, maxY, maxZ), (0.0, 0.0, 1.0, -maxZ)),
+        # Math3D_LineVsCube sets triVtx1.y instead of triVtx2.y for this tri,
+        # so triVtx2.y keeps the previous tri's value
+        ((maxX, maxY, maxZ), (minX, minY, maxZ), (maxX, maxY, maxZ), (0.0, 0.0, 1.0, -maxZ)),
+        # face 3
+        ((maxX, maxY, maxZ), (minX, maxY, minZ), (minX, maxY, maxZ), (0.0, 1.0, 0.0, -maxY)),
+        ((maxX, maxY, maxZ), (maxX, maxY, minZ), (minX, maxY, minZ), (0.0, 1.0, 0.0, -maxY)),
+        # face 4
+        ((minX, minY, minZ), (minX, maxY, minZ), (maxX, maxY, minZ), (0.0, 0.0, -1.0, minZ)),
+        ((minX, minY, minZ), (maxX, maxY, minZ), (maxX, minY, minZ), (0.0, 0.0, -1.0, minZ)),
+        # face 5
+        ((minX, minY, minZ), (maxX, minY, minZ), (maxX, minY, maxZ), (0.0, -1.0, 0.0, minY)),
+        ((minX, minY, minZ), (maxX, minY, maxZ), (minX, minY, maxZ), (0.0, -1.0, 0.0, minY)),
+        # face 6
+        ((maxX, maxY, maxZ), (maxX, minY, minZ), (maxX, maxY, minZ), (1.0, 0.0, 0.0, -maxX)),
+        ((maxX, maxY, maxZ), (maxX, minY, maxZ), (maxX, minY, minZ), (1.0, 0.0, 0.0, -maxX)),
+    )
+    for triVtx0, triVtx1, triVtx2, (nx, ny, nz, originDist) in tris:
+        if tri_line_intersect(triVtx0, triVtx1, triVtx2, nx, ny, nz, originDist, a, b):
+            return True
+
+    return False
+
+
+# z_bgcheck.c
+
+
+class StaticLookupBuilder:
+    def __init__(self, vtxList: list, polyList: list, minBounds, maxBounds, subdivAmount):
+        """`vtxList` is a list of (x, y, z), `polyList` a list of dicts like CollisionPoly"""
+        self.vtxList = vtxList
+        self.polyList = polyList
+        self.subdivAmount = subdivAmount
+
+        self.minBounds = tuple(float(v) for v in minBounds)
+        self.subdivLength = []
+        self.subdivLengthInv = []
+        for i in range(3):
+            _, subdivLength, subdivLengthInv = set_subdivision_dimension(
+                self.minBounds[i], subdivAmount[i], float(maxBounds[i])
+            )
+            self.subdivLength.append(subdivLength)
+            self.subdivLengthInv.append(subdivLengthInv)
+
+        # lookupTbl[i] = [floor, wall, ceiling] heads
+        self.lookupTbl = [
+            [SS_NULL, SS_NULL, SS_NULL]
+            for _ in range(subdivAmount[0] * subdivAmount[1] * subdivAmount[2])
+        ]
+        # (polyId, next)
+        self.nodes: list[list[int]] = []
+
+    def vtx_f(self, vI):
+        return tuple(float(c) for c in self.vtxList[vI])
+
+    def get_subdivision_min_bounds(self, pos):
+        s = []
+        for i in range(3):
+            d = sub(pos[i], self.minBounds[i])
+            si = int(mul(d, self.subdivLengthInv[i]))
+            if (c_mod(int(d), int(self.subdivLength[i])) < BGCHECK_SUBDIV_OVERLAP) and si > 0:
+                si -= 1
+            s.append(si)
+        return s
+
+    def get_subdivision_max_bounds(self, pos):
+        s = []
+        for i in range(3):
+            d = sub(pos[i], self.minBounds[i])
+            si = int(mul(d, self.subdivLengthInv[i]))
+            if (
+                int(self.subdivLength[i]) - BGCHECK_SUBDIV_OVERLAP
+                < c_mod(int(d), int(self.subdivLength[i]))
+            ) and si < self.subdivAmount[i] - 1:
+                si += 1
+            s.append(si)
+        return s
+
+    def get_poly_subdivision_bounds(self, polyId):
+        vtxData = self.polyList[polyId]["vtxData"]
+        maxVtx = list(self.vtx_f(COLPOLY_VTX_INDEX(vtxData[0])))
+        minVtx = list(maxVtx)
+
+        for vI in vtxData[1:3]:
+            vtx = self.vtx_f(COLPOLY_VTX_INDEX(vI))
+            for i in range(3):
+                if minVtx[i] > vtx[i]:
+                    minVtx[i] = vtx[i]
+                elif maxVtx[i] < vtx[i]:
+                    maxVtx[i] = vtx[i]
+
+        return (
+            self.get_subdivision_min_bounds(minVtx),
+            self.get_subdivision_max_bounds(maxVtx),
+        )
+
+    def poly_intersects_subdivision(self, min, max, polyId):
+        poly = self.polyList[polyId]
+        vtxData = poly["vtxData"]
+
+        va = self.vtx_f(COLPOLY_VTX_INDEX(vtxData[0]))
+        flags0 = point_relative_to_cube_faces(va, min, max)
+        if flags0 == 0:
+            return True
+
+        vb = self.vtx_f(COLPOLY_VTX_INDEX(vtxData[1]))
+        flags1 = point_relative_to_cube_faces(vb, min, max)
+        if flags1 == 0:
+            return True
+
+        # vIC is not masked with COLPOLY_VTX_INDEX
+        vc = self.vtx_f(vtxData[2])
+        flags2 = point_relative_to_cube_faces(vc, min, max)
+        if flags2 == 0:
+            return True
+
+        if flags0 & flags1 & flags2:
+            return False
+
+        flags0 |= point_relative_to_cube_edges(va, min, max) << 8
+        flags1 |= point_relative_to_cube_edges(vb, min, max) << 8
+        flags2 |= point_relative_to_cube_edges(vc, min, max) << 8
+        if flags0 & flags1 & flags2:
+            return False
+
+        flags0 |= point_relative_to_cube_vertices(va, min, max) << 0x18
+        flags1 |= point_relative_to_cube_vertices(vb, min, max) << 0x18
+        flags2 |= point_relative_to_cube_vertices(vc, min, max) << 0x18
+        if flags0 & flags1 & flags2:
+            return False
+
+        # CollisionPoly_GetNormalF
+        n = tuple(mul(float(poly["normal"][axis]), COLPOLY_NORMAL_FRAC) for axis in "xyz")
+        dist = float(poly["dist"])
+
+        # Math3D_TriChkLineSegParaYIntersect, at (z, x) for each vertical edge of the cube
+        for z, x in ((min[2], min[0]), (max[2], min[0]), (min[2], max[0]), (max[2], max[0])):
+            if tri_chk_line_seg_para_intersect(va, vb, vc, n, dist, 1, z, x, min[1], max[1]):
+                return True
+        # Math3D_TriChkLineSegParaZIntersect, at (x, y)
+        for x, y in ((min[0], min[1]), (min[0], max[1]), (max[0], min[1]), (max[0], max[1])):
+            if tri_chk_line_seg_para_intersect(va, vb, vc, n, dist, 2, x, y, min[2], max[2]):
+                return True
+        # Math3D_TriChkLineSegParaXIntersect, at (y, z)
+        for y, z in ((min[1], min[2]), (min[1], max[2]), (max[1], min[2]), (max[1], max[2])):
+            if tri_chk_line_seg_para_intersect(va, vb, vc, n, dist, 0, y, z, min[0], max[0]):
+                return True
+
+        if (
+            line_vs_cube(min, max, va, vb)
+            or line_vs_cube(min, max, vb, vc)
+            or line_vs_cube(min, max, vc, va)
+        ):
+            return True
+        return False
+
+    def get_poly_min_y(self, polyId):
+        """CollisionPoly_GetMinY"""
+        poly = self.polyList[polyId]
+        vtxData = poly["vtxData"]
+        a = COLPOLY_VTX_INDEX(vtxData[0])
+        if poly["normal"]["y"] in {COLPOLY_SNORMAL(1.0), COLPOLY_SNORMAL(-1.0)}:
+            return self.vtxList[a][1]
+        b = COLPOLY_VTX_INDEX(vtxData[1])
+        c = vtxData[2]
+        min = self.vtxList[a][1]
+        if min > self.vtxList[b][1]:
+            min = self.vtxList[b][1]
+        if min < self.vtxList[c][1]:
+            return min
+        return self.vtxList[c][1]
+
+    def is_poly_above(self, polyYMin, polyId):
+        vtxData = self.polyList[polyId]["vtxData"]
+        return (
+            polyYMin < self.vtxList[COLPOLY_VTX_INDEX(vtxData[0])][1]
+            and polyYMin < self.vtxList[COLPOLY_VTX_INDEX(vtxData[1])][1]
+            and polyYMin < self.vtxList[vtxData[2]][1]
+        )
+
+    def add_node(self, polyId, next):
+        self.nodes.append([polyId, next])
+        return len(self.nodes) - 1
+
+    def add_poly_to_ss_list(self, lookup, list_index, polyId):
+        """StaticLookup_AddPolyToSSList"""
+        if lookup[list_index] == SS_NULL:
+            lookup[list_index] = self.add_node(polyId, lookup[list_index])
+            return
+
+        polyYMin = self.get_poly_min_y(polyId)
+        curNode = self.nodes[lookup[list_index]]
+
+        if self.is_poly_above(polyYMin, curNode[0]):
+            lookup[list_index] = self.add_node(polyId, lookup[list_index])
+            return
+
+        while True:
+            if curNode[1] == SS_NULL:
+                curNode[1] = self.add_node(polyId, SS_NULL)
+                return
+
+            nextNode = self.nodes[curNode[1]]
+            if self.is_poly_above(polyYMin, nextNode[0]):
+                curNode[1] = self.add_node(polyId, curNode[1])
+                return
+            curNode = nextNode
+
+    def add_poly(self, lookup, polyId):
+        """StaticLookup_AddPoly"""
+        normalY = self.polyList[polyId]["normal"]["y"]
+        if normalY > COLPOLY_SNORMAL(0.5):
+            self.add_poly_to_ss_list(lookup, 0, polyId)
+        elif normalY < COLPOLY_SNORMAL(-0.8):
+            self.add_poly_to_ss_list(lookup, 2, polyId)
+        else:
+            self.add_poly_to_ss_list(lookup, 1, polyId)
+
+    def get_subdivision_start(self, axis, s):
+        """Minimum of the subdivision `s` along `axis`, including the overlap"""
+        return sub(
+            add(mul(self.subdivLength[axis], float(s)), self.minBounds[axis]),
+            BGCHECK_SUBDIV_OVERLAP,
+        )
+
+    def build(self):
+        """BgCheck_InitializeStaticLookup"""
+        subdivAmountX, subdivAmountY, _ = self.subdivAmount
+        subdivLengthX, subdivLengthY, subdivLengthZ = self.subdivLength
+        subdivLengthOverlap = [
+            add(self.subdivLength[i], float(2 * BGCHECK_SUBDIV_OVERLAP))
+            for i in range(3)
+        ]
+        curSubdivMin = [0.0, 0.0, 0.0]
+        curSubdivMax = [0.0, 0.0, 0.0]
+
+        for polyId in range(len(self.polyList)):
+            subdivMin, subdivMax = self.get_poly_subdivision_bounds(polyId)
+            sxMin, syMin, szMin = subdivMin
+            sxMax, syMax, szMax = subdivMax
+
+            curSubdivMin[2] = self.get_subdivision_start(2, szMin)
+            curSubdivMax[2] = add(curSubdivMin[2], subdivLengthOverlap[2])
+
+            for sz in range(szMin, szMax + 1):
+                curSubdivMin[1] = self.get_subdivision_start(1, syMin)
+                curSubdivMax[1] = add(curSubdivMin[1], subdivLengthOverlap[1])
+
+                for sy in range(syMin, syMax + 1):
+                    curSubdivMin[0] = self.get_subdivision_start(0, sxMin)
+                    curSubdivMax[0] = add(curSubdivMin[0], subdivLengthOverlap[0])
+
+                    for sx in range(sxMin, sxMax + 1):
+                        if self.poly_intersects_subdivision(
+                            curSubdivMin, curSubdivMax, polyId
+                        ):
+                            lookupIdx = (sz * subdivAmountY + sy) * subdivAmountX + sx
+                            self.add_poly(self.lookupTbl[lookupIdx], polyId)
+                        curSubdivMin[0] = add(curSubdivMin[0], subdivLengthX)
+                        curSubdivMax[0] = add(curSubdivMax[0], subdivLengthX)
+                    curSubdivMin[1] = add(curSubdivMin[1], subdivLengthY)
+                    curSubdivMax[1] = add(curSubdivMax[1], subdivLengthY)
+                curSubdivMin[2] = add(curSubdivMin[2], subdivLengthZ)
+                curSubdivMax[2] = add(curSubdivMax[2], subdivLengthZ)
+
+        return self.lookupTbl, self.nodes
@@ -347,8 +347,23 @@ def main():
     parser.add_argument("-f", dest="force", action="store_true")
     parser.add_argument("-s", dest="single", default=None)
     parser.add_argument("-r", dest="single_is_regex", default=None, action="store_true")
+    parser.add_argument(
+        "--collision-bvh",
+        action="store_true",
+        help="Build the scene collision BVHs, for COLLISION_BVH",
+    )
+    parser.add_argument(
+        "--collision-baked-lookup",
+        action="store_true",
+        help="Build the scene collision StaticLookup tables, for COLLISION_BAKED_LOOKUP",
+    )
     args = parser.parse_args()
 
+    from .extase_oot64 import collision_resources
+
+    collision_resources.BUILD_BVH = args.collision_bvh
+    collision_resources.BUILD_BAKED_LOOKUP = args.collision_baked_lookup
+
     vc = version_config.load_version_config(args.oot_version)
 
     dma_entries = dmadata.read_dmadata(
@@ -369,6 +384,9 @@ def main():
     except (OSError, json.decoder.JSONDecodeError):
         last_extracts = dict()
 
+    # Files are also extracted again when the options that change what is extracted change
+    extract_options = [args.collision_bvh, args.collision_baked_lookup]
+
     def is_pool_desc_modified(pool_desc: ResourcesDescCollectionsPool):
         modified = False
         for rdc in pool_desc.collections:
@@ -377,6 +395,10 @@ def main():
                     f"{rdc.out_path} {rdc.backing_memory.name}", 0
                 ):
                     modified = True
+                if extract_options != last_extracts.get(
+                    f"{rdc.out_path} {rdc.backing_memory.name} options"
+                ):
+                    modified = True
         return modified
 
     def set_pool_desc_modified(pool_desc: ResourcesDescCollectionsPool):
@@ -385,6 +407,9 @@ def main():
                 last_extracts[f"{rdc.out_path} {rdc.backing_memory.name}"] = (
                     rdc.last_modified_time
                 )
+                last_extracts[f"{rdc.out_path} {rdc.backing_memory.name} options"] = (
+                    extract_options
+                )
 
     version_memctx_base = MemoryContext(dmadata_table_rom_file_name_by_vrom)
 
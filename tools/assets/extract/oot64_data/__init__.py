@@ -1,7 +1,7 @@
 # SPDX-FileCopyrightText: © 2025 ZeldaRET
 # SPDX-License-Identifier: CC0-1.0
 
-from typing import Sequence
+from typing import Optional, Sequence
 
 
 I_D_OMEGALUL = True
@@ -78,6 +78,25 @@ def get_scene_id_from_rom_file_name(rom_file_name: str) -> int:
     return scene_id_by_rom_file_name[rom_file_name]
 
 
+from . import scene_subdivisions
+
+
+scene_subdivision_amount_by_scene_id_name = {
+    scene_id_name: subdivAmount
+    for scene_id_name, subdivAmount, nodeListMax in scene_subdivisions.DATA
+}
+
+
+def get_scene_subdivision_amount(
+    rom_file_name: str,
+) -> Optional[tuple[int, int, int]]:
+    """The scene's subdivisions in the sceneSubdivisionList of BgCheck_Allocate, if any"""
+    scene_id = scene_id_by_rom_file_name.get(rom_file_name)
+    if scene_id is None:
+        return None
+    return scene_subdivision_amount_by_scene_id_name.get(get_scene_id_name(scene_id))
+
+
 from . import audio_ids
 
 
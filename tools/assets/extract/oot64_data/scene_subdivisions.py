@@ -0,0 +1,6 @@
+# This file was generated from ../../../..//src/code/z_bgcheck.c
+
+DATA = (
+    ("SCENE_SHADOW_TEMPLE", (23, 7, 14), -1),
+    ("SCENE_FOREST_TEMPLE", (38, 1, 38), -1),
+)
@@ -0,0 +1,374 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: 2025 zeldaret
+# SPDX-License-Identifier: CC0-1.0
+
+"""
+Check the StaticLookup tables baked by the asset extraction for COLLISION_BAKED_LOOKUP
+against BgCheck_InitializeStaticLookup itself.
+
+The functions building the tables are copied out of src/code/z_bgcheck.c, src/code/sys_math3d.c
+and src/code/z_lib.c, compiled for the host with the extracted scenes' collision and main.c,
+which builds the tables of every scene and compares them with the baked ones.
+
+The subdivisions the tables were baked for are checked against the sceneSubdivisionList of
+BgCheck_Allocate, and so is oot64_data/scene_subdivisions.py that the extraction takes them from.
+
+Usage example, after extracting the assets:
+    python3 tools/check_baked_lookup/check_baked_lookup.py extracted/gc-eu-mq-dbg/assets \
+        build/gc-eu-mq-dbg/check_baked_lookup
+"""
+
+from __future__ import annotations
+
+import argparse
+import os
+from pathlib import Path
+import re
+import subprocess
+import sys
+
+TOOL_DIR = Path(__file__).parent
+ROOT = TOOL_DIR.parent.parent
+
+sys.path.insert(0, str(ROOT / "tools" / "assets" / "extract"))
+import oot64_data.scene_subdivisions
+
+# (source file, functions) the tables are built with, in an order that needs no prototypes
+SOURCE_FUNCTIONS = (
+    (
+        "src/code/z_lib.c",
+        ("Math_Vec3f_Copy", "Math_Vec3s_ToVec3f", "Math_Vec3f_Diff"),
+    ),
+    (
+        "src/code/sys_math3d.c",
+        (
+            "Math3D_PointOnInfiniteLine",
+            "Math3D_LineSplitRatio",
+            "Math3D_PointRelativeToCubeFaces",
+            "Math3D_PointRelativeToCubeEdges",
+            "Math3D_PointRelativeToCubeVertices",
+            "Math3D_Planef",
+            "Math3D_CirSquareVsTriSquare",
+            "Math3D_PointDistSqToLine2D",
+            "Math3D_TriChkPointParaYImpl",
+            "Math3D_TriChkPointParaY",
+            "Math3D_TriChkLineSegParaYIntersect",
+            "Math3D_TriChkPointParaXImpl",
+            "Math3D_TriChkPointParaX",
+            "Math3D_TriChkLineSegParaXIntersect",
+            "Math3D_TriChkPointParaZImpl",
+            "Math3D_TriChkPointParaZ",
+            "Math3D_TriChkLineSegParaZIntersect",
+            "Math3D_LineSegFindPlaneIntersect",
+            "Math3D_LineSegVsPlane",
+            "Math3D_TriLineIntersect",
+            "Math3D_LineVsCube",
+        ),
+    ),
+    (
+        "src/code/z_bgcheck.c",
+        (
+            "SSNode_SetValue",
+            "SSNodeList_SetSSListHead",
+            "SSNodeList_GetNextNodeIdx",
+            "BgCheck_Vec3sToVec3f",
+            "CollisionPoly_GetMinY",
+            "CollisionPoly_GetNormalF",
+            "StaticLookup_AddPolyToSSList",
+            "StaticLookup_AddPoly",
+            "BgCheck_GetSubdivisionMinBounds",
+            "BgCheck_GetSubdivisionMaxBounds",
+            "BgCheck_GetPolySubdivisionBounds",
+            "BgCheck_PolyIntersectsSubdivision",
+            "BgCheck_InitializeStaticLookup",
+            "BgCheck_SetSubdivisionDimension",
+        ),
+    ),
+)
+
+# (header, macros) used by those functions and by the extracted collision
+SOURCE_DEFINES = (
+    ("include/array_count.h", ("ARRAY_COUNT",)),
+    ("include/libc/math.h", ("SHT_MAX",)),
+    ("include/z_math.h", ("SQ", "CLAMP_MIN", "IS_ZERO")),
+    (
+        "include/bgcheck.h",
+        (
+            "BGCHECK_SUBDIV_OVERLAP",
+            "BGCHECK_SUBDIV_MIN",
+            "COLPOLY_NORMAL_FRAC",
+            "COLPOLY_SNORMAL",
+            "COLPOLY_GET_NORMAL",
+            "COLPOLY_VTX_INDEX",
+            "COLPOLY_VTX",
+            "COLPOLY_IGNORE_CAMERA",
+            "COLPOLY_IGNORE_ENTITY",
+            "COLPOLY_IGNORE_PROJECTILES",
+            "COLPOLY_IS_FLOOR_CONVEYOR",
+        ),
+    ),
+    ("src/code/z_bgcheck.c", ("SS_NULL",)),
+)
+
+# BgCheck_Allocate's subdivisions for the scenes not in sceneSubdivisionList,
+# and for the fixed camera scenes
+DEFAULT_SUBDIV_AMOUNT = (16, 4, 16)
+FIXED_CAMERA_SUBDIV_AMOUNT = (2, 2, 2)
+
+
+def get_function(source: str, name: str):
+    """Returns (prototype, definition) of the function `name` in `source`"""
+    matches = [
+        m
+        for m in re.finditer(
+            rf"^(?:static )?\w+\*? {re.escape(name)}\(", source, re.MULTILINE
+        )
+        # skip prototypes
+        if ";" not in source[m.start() : source.index("{", m.start())]
+    ]
+    assert len(matches) == 1, (name, len(matches))
+    start = matches[0].start()
+    body_start = source.index("{", start)
+    depth = 0
+    for i in range(body_start, len(source)):
+        if source[i] == "{":
+            depth += 1
+        elif source[i] == "}":
+            depth -= 1
+            if depth == 0:
+                break
+    else:
+        raise ValueError(f"{name} doesn't end")
+    prototype = source[start:body_start].strip() + ";"
+    return prototype, source[start : i + 1]
+
+
+def get_define(source: str, name: str):
+    m = re.search(rf"^#define {re.escape(name)}\b.*$", source, re.MULTILINE)
+    assert m is not None, name
+    return m.group(0)
+
+
+def write_sources(out_dir: Path):
+    """Write sources.h and sources.c, with the macros and functions copied from the sources"""
+    with (out_dir / "sources.h").open("w") as f:
+        f.write("// Generated by check_baked_lookup.py\n")
+        for path, names in SOURCE_DEFINES:
+            source = (ROOT / path).read_text()
+            f.write(f"\n// {path}\n")
+            for name in names:
+                f.write(get_define(source, name) + "\n")
+        for path, names in SOURCE_FUNCTIONS:
+            source = (ROOT / path).read_text()
+            f.write(f"\n// {path}\n")
+            for name in names:
+                f.write(get_function(source, name)[0] + "\n")
+
+    with (out_dir / "sources.c").open("w") as f:
+        f.write("// Generated by check_baked_lookup.py\n")
+        f.write('#include "host.h"\n')
+        for path, names in SOURCE_FUNCTIONS:
+            source = (ROOT / path).read_text()
+            f.write(f"\n// {path}\n")
+            for name in names:
+                f.write("\n" + get_function(source, name)[1] + "\n")
+
+
+def get_scene_subdivisions():
+    """The sceneSubdivisionList of BgCheck_Allocate, as {scene file name: subdivAmount}"""
+    bgcheck = (ROOT / "src/code/z_bgcheck.c").read_text()
+    m = re.search(r"sceneSubdivisionList\[\] = \{(.*?)\};", bgcheck, re.DOTALL)
+    assert m is not None
+    entries = [
+        (scene_id_name, tuple(int(v) for v in subdiv_amount), int(node_list_max))
+        for scene_id_name, *subdiv_amount, node_list_max in re.findall(
+            r"\{\s*(\w+),\s*\{\s*(-?\d+),\s*(-?\d+),\s*(-?\d+)\s*\},\s*(-?\d+)\s*\}",
+            m.group(1),
+        )
+    ]
+
+    if entries != [tuple(entry) for entry in oot64_data.scene_subdivisions.DATA]:
+        print(
+            "oot64_data/scene_subdivisions.py doesn't match sceneSubdivisionList,"
+            " run `make -C tools/assets/extract/oot64_data scene_subdivisions.py`"
+            " and extract the assets again"
+        )
+        sys.exit(1)
+
+    scene_table = (ROOT / "include/tables/scene_table.h").read_text()
+    scene_file_names = {
+        scene_id_name: file_name
+        for file_name, scene_id_name in re.findall(
+            r"DEFINE_SCENE\((\w+), \w+, (\w+),", scene_table
+        )
+    }
+    return {
+        scene_file_names[scene_id_name]: subdiv_amount
+        for scene_id_name, subdiv_amount, node_list_max in entries
+    }
+
+
+def get_int_list(text: str):
+    return [int(v) for v in re.findall(r"-?\d+", re.sub(r"//.*", "", text))]
+
+
+class Scene:
+    def __init__(self, baked_path: Path):
+        self.baked_path = baked_path
+        self.header_path = baked_path.with_name(
+            baked_path.name.removesuffix("_Baked.inc.c") + ".inc.c"
+        )
+        self.name = self.header_path.name.removesuffix(".inc.c")
+
+        baked = baked_path.read_text()
+        m = re.search(r"CollisionBakedLookup (\w+) = \{\s*\{([^{}]*)\}", baked)
+        assert m is not None, baked_path
+        self.baked_lookup_symbol = m.group(1)
+        self.subdiv_amount = tuple(get_int_list(m.group(2)))
+
+        # The CollisionHeader, see CollisionResource in collision_resources.py
+        header = self.header_path.read_text()
+        self.min_bounds = get_int_list(
+            re.search(r"\{([^{}]*)\}, // minBounds", header).group(1)
+        )
+        self.max_bounds = get_int_list(
+            re.search(r"\{([^{}]*)\}, // maxBounds", header).group(1)
+        )
+        self.vtx_list_path = self.header_path.with_name(
+            re.search(r"(\w+), // vtxList", header).group(1) + ".inc.c"
+        )
+        self.poly_list_path = self.header_path.with_name(
+            re.search(r"(\w+), // polyList", header).group(1) + ".inc.c"
+        )
+
+    def check_subdiv_amount(self, scene_subdivisions: dict):
+        """Returns an error if the tables weren't baked for BgCheck_Allocate's subdivisions"""
+        # Only the scene's collision is baked, and it is named after the scene
+        m = re.match(r"(\w+_scene)", self.name)
+        scene_file_name = m.group(1) if m is not None else None
+
+        if scene_file_name in scene_subdivisions:
+            expected = (scene_subdivisions[scene_file_name],)
+        else:
+            expected = (DEFAULT_SUBDIV_AMOUNT, FIXED_CAMERA_SUBDIV_AMOUNT)
+        if self.subdiv_amount not in expected:
+            return (
+                f"{self.name}: baked for subdivisions {self.subdiv_amount},"
+                f" expected {' or '.join(map(str, expected))}"
+            )
+        return None
+
+    def write_c(self, f, index: int):
+        f.write('#include "host.h"\n')
+        f.write("\n")
+        f.write("static Vec3s sVtxList[] = {\n")
+        f.write(f'#include "{self.vtx_list_path.resolve()}"\n')
+        f.write("};\n")
+        f.write("\n")
+        f.write("static CollisionPoly sPolyList[] = {\n")
+        f.write(f'#include "{self.poly_list_path.resolve()}"\n')
+        f.write("};\n")
+        f.write("\n")
+        f.write(f'#include "{self.baked_path.resolve()}"\n')
+        f.write("\n")
+        f.write("static CollisionHeader sColHeader = {\n")
+        f.write(f"    {{ {', '.join(map(str, self.min_bounds))} }},\n")
+        f.write(f"    {{ {', '.join(map(str, self.max_bounds))} }},\n")
+        f.write("    ARRAY_COUNT(sVtxList),\n")
+        f.write("    sVtxList,\n")
+        f.write("    ARRAY_COUNT(sPolyList),\n")
+        f.write("    sPolyList,\n")
+        f.write("};\n")
+        f.write("\n")
+        f.write(
+            f"HostScene gHostScene{index} = "
+            f'{{ "{self.name}", &sColHeader, &{self.baked_lookup_symbol} }};\n'
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Check the StaticLookup tables baked by the asset extraction"
+        " against BgCheck_InitializeStaticLookup"
+    )
+    parser.add_argument(
+        "assets_dir",
+        type=Path,
+        help="Extracted assets, e.g. extracted/gc-eu-mq-dbg/assets",
+    )
+    parser.add_argument("out_dir", type=Path, help="Directory to build the check in")
+    parser.add_argument(
+        "--cc", default=os.environ.get("HOST_CC", "cc"), help="Host C compiler"
+    )
+    parser.add_argument(
+        "-v", "--verbose", action="store_true", help="List every scene checked"
+    )
+    args = parser.parse_args()
+
+    scene_subdivisions = get_scene_subdivisions()
+
+    scenes = [Scene(path) for path in sorted(args.assets_dir.rglob("*_Baked.inc.c"))]
+    if not scenes:
+        print(
+            f"No baked StaticLookup tables in {args.assets_dir},"
+            " run make setup with COLLISION_BAKED_LOOKUP=1 first"
+        )
+        sys.exit(1)
+
+    errors = [
+        error
+        for error in (scene.check_subdiv_amount(scene_subdivisions) for scene in scenes)
+        if error is not None
+    ]
+    for error in errors:
+        print(error)
+
+    args.out_dir.mkdir(parents=True, exist_ok=True)
+    write_sources(args.out_dir)
+    c_files = [TOOL_DIR / "main.c", args.out_dir / "sources.c"]
+    for i, scene in enumerate(scenes):
+        c_file = args.out_dir / f"scene_{i}.c"
+        with c_file.open("w") as f:
+            scene.write_c(f, i)
+        c_files.append(c_file)
+    with (args.out_dir / "scenes.c").open("w") as f:
+        f.write('#include "host.h"\n')
+        f.write("\n")
+        for i in range(len(scenes)):
+            f.write(f"extern HostScene gHostScene{i};\n")
+        f.write("\n")
+        f.write("HostScene* gHostScenes[] = {\n")
+        for i in range(len(scenes)):
+            f.write(f"    &gHostScene{i},\n")
+        f.write("};\n")
+        f.write("\n")
+        f.write("s32 gHostSceneCount = ARRAY_COUNT(gHostScenes);\n")
+    c_files.append(args.out_dir / "scenes.c")
+
+    program = args.out_dir / "check_baked_lookup"
+    subprocess.run(
+        [
+            args.cc,
+            "-std=gnu99",
+            "-O2",
+            # The f32 operations must be done one by one, as on console
+            "-ffp-contract=off",
+            "-w",
+            f"-I{TOOL_DIR}",
+            f"-I{args.out_dir}",
+            *map(str, c_files),
+            "-o",
+            str(program),
+            "-lm",
+        ],
+        check=True,
+    )
+    result = subprocess.run([str(program.resolve())] + (["-v"] if args.verbose else []))
+
+    if errors or result.returncode != 0:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
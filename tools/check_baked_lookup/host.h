@@ -0,0 +1,125 @@
+#ifndef HOST_H
+#define HOST_H
+
+// Stand-in for the game's headers, enough to build the StaticLookup functions copied out of src/code/sys_math3d.c and
+// src/code/z_bgcheck.c by check_baked_lookup.py for the host. The macros they use are copied from the game's headers
+// into sources.h along with them, the types here only have the fields these functions use.
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef float f32;
+
+#define true 1
+#define false 0
+
+#define ASSERT(cond, msg, file, line) ((cond) ? (void)0 : Host_Assert(msg, file, line))
+#define PRINTF(...) (void)0
+#define PRINTF_COLOR_WARNING() (void)0
+#define PRINTF_RST() (void)0
+#define T(jp, en) en
+#define UNUSED
+
+void Host_Assert(const char* msg, const char* file, int line);
+
+typedef struct Vec3f {
+    f32 x, y, z;
+} Vec3f;
+
+typedef struct Vec3s {
+    s16 x, y, z;
+} Vec3s;
+
+typedef struct InfiniteLine {
+    Vec3f point;
+    Vec3f dir;
+} InfiniteLine;
+
+typedef struct Linef {
+    Vec3f a;
+    Vec3f b;
+} Linef;
+
+typedef struct CollisionPoly {
+    u16 type;
+    union {
+        u16 vtxData[3];
+        struct {
+            u16 flags_vIA;
+            u16 flags_vIB;
+            u16 vIC;
+        };
+    };
+    Vec3s normal;
+    s16 dist;
+} CollisionPoly;
+
+typedef struct CollisionHeader {
+    Vec3s minBounds;
+    Vec3s maxBounds;
+    u16 numVertices;
+    Vec3s* vtxList;
+    u16 numPolygons;
+    CollisionPoly* polyList;
+} CollisionHeader;
+
+typedef struct SSNode {
+    s16 polyId;
+    u16 next;
+} SSNode;
+
+typedef struct SSList {
+    u16 head;
+} SSList;
+
+typedef struct SSNodeList {
+    u16 max;
+    u16 count;
+    SSNode* tbl;
+    u8* polyCheckTbl;
+} SSNodeList;
+
+typedef struct StaticLookup {
+    SSList floor;
+    SSList wall;
+    SSList ceiling;
+} StaticLookup;
+
+typedef struct CollisionBakedLookup {
+    Vec3s subdivAmount;
+    u16 numNodes;
+    StaticLookup* lookupTbl;
+    SSNode* nodes;
+} CollisionBakedLookup;
+
+typedef struct CollisionContext {
+    CollisionHeader* colHeader;
+    Vec3f minBounds;
+    Vec3f maxBounds;
+    Vec3s subdivAmount;
+    Vec3f subdivLength;
+    Vec3f subdivLengthInv;
+    StaticLookup* lookupTbl;
+    SSNodeList polyNodes;
+} CollisionContext;
+
+typedef struct PlayState PlayState;
+
+// One scene's collision, as extracted, with the tables baked for it
+typedef struct HostScene {
+    const char* name;
+    CollisionHeader* colHeader;
+    CollisionBakedLookup* bakedLookup;
+} HostScene;
+
+#include "sources.h"
+
+#endif
@@ -0,0 +1,125 @@
+/**
+ * Builds the StaticLookup tables of each extracted scene with BgCheck_InitializeStaticLookup, compiled for the host from
+ * src/code/z_bgcheck.c and src/code/sys_math3d.c, and compares them with the tables baked for the scene by the asset
+ * extraction (tools/assets/extract/extase_oot64/static_lookup.py) for COLLISION_BAKED_LOOKUP.
+ *
+ * The tables are built for the subdivisions they were baked for, like BgCheck_Allocate does with
+ * COLLISION_BAKED_LOOKUP_CHECK. check_baked_lookup.py checks those subdivisions against BgCheck_Allocate's.
+ *
+ * The host must do the f32 operations like the console, in single precision and without contracting them into fused
+ * multiply-adds, so this is built with -ffp-contract=off and without -ffast-math.
+ *
+ * Usage: check_baked_lookup [-v]
+ */
+#include <string.h>
+
+#include "host.h"
+
+extern HostScene* gHostScenes[];
+extern s32 gHostSceneCount;
+
+void Host_Assert(const char* msg, const char* file, int line) {
+    fprintf(stderr, "ASSERT: %s (%s:%d)\n", msg, file, line);
+    exit(2);
+}
+
+/**
+ * Mirrors the parts of BgCheck_Allocate that BgCheck_InitializeStaticLookup depends on
+ */
+static void Host_AllocateCollision(CollisionContext* colCtx, HostScene* scene) {
+    CollisionHeader* colHeader = scene->colHeader;
+    Vec3s* subdivAmount = &scene->bakedLookup->subdivAmount;
+
+    colCtx->colHeader = colHeader;
+    colCtx->subdivAmount = *subdivAmount;
+    colCtx->minBounds.x = colHeader->minBounds.x;
+    colCtx->minBounds.y = colHeader->minBounds.y;
+    colCtx->minBounds.z = colHeader->minBounds.z;
+    colCtx->maxBounds.x = colHeader->maxBounds.x;
+    colCtx->maxBounds.y = colHeader->maxBounds.y;
+    colCtx->maxBounds.z = colHeader->maxBounds.z;
+    BgCheck_SetSubdivisionDimension(colCtx->minBounds.x, colCtx->subdivAmount.x, &colCtx->maxBounds.x,
+                                    &colCtx->subdivLength.x, &colCtx->subdivLengthInv.x);
+    BgCheck_SetSubdivisionDimension(colCtx->minBounds.y, colCtx->subdivAmount.y, &colCtx->maxBounds.y,
+                                    &colCtx->subdivLength.y, &colCtx->subdivLengthInv.y);
+    BgCheck_SetSubdivisionDimension(colCtx->minBounds.z, colCtx->subdivAmount.z, &colCtx->maxBounds.z,
+                                    &colCtx->subdivLength.z, &colCtx->subdivLengthInv.z);
+
+    colCtx->lookupTbl = calloc(subdivAmount->x * subdivAmount->y * subdivAmount->z, sizeof(StaticLookup));
+    // Node indices must stay below SS_NULL
+    colCtx->polyNodes.max = SS_NULL;
+    colCtx->polyNodes.count = 0;
+    colCtx->polyNodes.tbl = calloc(colCtx->polyNodes.max, sizeof(SSNode));
+    colCtx->polyNodes.polyCheckTbl = NULL;
+}
+
+/**
+ * Returns the number of differences between the built and the baked tables, printing the first few
+ */
+static s32 Host_CompareLookup(CollisionContext* colCtx, HostScene* scene) {
+    CollisionBakedLookup* bakedLookup = scene->bakedLookup;
+    s32 lookupCount = colCtx->subdivAmount.x * colCtx->subdivAmount.y * colCtx->subdivAmount.z;
+    s32 diffs = 0;
+    s32 i;
+
+    for (i = 0; i < lookupCount; i++) {
+        StaticLookup* built = &colCtx->lookupTbl[i];
+        StaticLookup* baked = &bakedLookup->lookupTbl[i];
+
+        if ((built->floor.head != baked->floor.head) || (built->wall.head != baked->wall.head) ||
+            (built->ceiling.head != baked->ceiling.head)) {
+            if (diffs++ < 8) {
+                printf("%s: lookupTbl[%d] built { %d, %d, %d } baked { %d, %d, %d }\n", scene->name, i,
+                       built->floor.head, built->wall.head, built->ceiling.head, baked->floor.head, baked->wall.head,
+                       baked->ceiling.head);
+            }
+        }
+    }
+
+    if (colCtx->polyNodes.count != bakedLookup->numNodes) {
+        diffs++;
+        printf("%s: built %d nodes, baked %d\n", scene->name, colCtx->polyNodes.count, bakedLookup->numNodes);
+    }
+    for (i = 0; (i < colCtx->polyNodes.count) && (i < bakedLookup->numNodes); i++) {
+        SSNode* built = &colCtx->polyNodes.tbl[i];
+        SSNode* baked = &bakedLookup->nodes[i];
+
+        if ((built->polyId != baked->polyId) || (built->next != baked->next)) {
+            if (diffs++ < 8) {
+                printf("%s: nodes[%d] built { %d, %d } baked { %d, %d }\n", scene->name, i, built->polyId, built->next,
+                       baked->polyId, baked->next);
+            }
+        }
+    }
+
+    return diffs;
+}
+
+int main(int argc, char** argv) {
+    s32 verbose = (argc > 1) && (strcmp(argv[1], "-v") == 0);
+    s32 failures = 0;
+    s32 i;
+
+    for (i = 0; i < gHostSceneCount; i++) {
+        HostScene* scene = gHostScenes[i];
+        CollisionContext colCtx;
+        s32 diffs;
+
+        Host_AllocateCollision(&colCtx, scene);
+        BgCheck_InitializeStaticLookup(&colCtx, NULL, colCtx.lookupTbl);
+        diffs = Host_CompareLookup(&colCtx, scene);
+
+        if (diffs != 0) {
+            failures++;
+            printf("%s: %d differences\n", scene->name, diffs);
+        } else if (verbose) {
+            printf("%s: OK, %d nodes\n", scene->name, colCtx.polyNodes.count);
+        }
+
+        free(colCtx.lookupTbl);
+        free(colCtx.polyNodes.tbl);
+    }
+
+    printf("%d scenes checked, %d with differences\n", gHostSceneCount, failures);
+    return (failures != 0) ? 1 : 0;
+}
@@ -8,26 +8,212 @@ from __future__ import annotations
 import argparse
 from pathlib import Path
 import dataclasses
+import hashlib
+import importlib.metadata
+import os
 import time
 import multiprocessing
 import multiprocessing.pool
+import struct
+import subprocess
 
 import crunch64
 
 import dmadata
 
 
+YAZ0_NATIVE_P = Path(__file__).parent / "yaz0"
+
+
+def compress_yaz0_native(data: bytes):
+    """
+    Compress with the multithreaded Yaz0 encoder built by tools/Makefile, using
+    its optimal parse. The output is smaller than the original encoder's, so
+    this is for modding only as the compressed rom won't match.
+    """
+    return subprocess.run(
+        [str(YAZ0_NATIVE_P), "-O", "-", "-"],
+        input=data,
+        stdout=subprocess.PIPE,
+        check=True,
+    ).stdout
+
+
+LZ4_MIN_MATCH = 4
+LZ4_MAX_OFFSET = 0xFFFF
+# The LZ4 block format requires the last 5 bytes to be literals, and the last
+# match to start at least 12 bytes before the end
+LZ4_LAST_LITERALS = 5
+LZ4_MF_LIMIT = 12
+
+
+def compress_lz4(data: bytes):
+    """
+    Compress to the format decoded by Lz4_Decompress in src/boot/lz4.c:
+    a 0x10 bytes header ("LZ4B", the big-endian uncompressed size, 8 zero bytes)
+    followed by an LZ4 block.
+    """
+
+    def write_length(out: bytearray, length: int):
+        while length >= 0xFF:
+            out.append(0xFF)
+            length -= 0xFF
+        out.append(length)
+
+    def write_sequence(out: bytearray, literals: bytes, offset: int, match_len: int):
+        lit_len = len(literals)
+        token_lit = min(lit_len, 0xF)
+        token_match = min(match_len - LZ4_MIN_MATCH, 0xF) if offset != 0 else 0
+        out.append(token_lit << 4 | token_match)
+        if token_lit == 0xF:
+            write_length(out, lit_len - 0xF)
+        out += literals
+        if offset != 0:
+            out += offset.to_bytes(2, "little")
+            if token_match == 0xF:
+                write_length(out, match_len - LZ4_MIN_MATCH - 0xF)
+
+    out = bytearray(b"LZ4B" + len(data).to_bytes(4, "big") + bytes(8))
+    # Last position of each 4-byte sequence
+    positions: dict[bytes, int] = {}
+    match_limit = len(data) - LZ4_MF_LIMIT
+    anchor = 0
+    pos = 0
+    while pos < match_limit:
+        key = data[pos : pos + LZ4_MIN_MATCH]
+        cand = positions.get(key)
+        positions[key] = pos
+        if cand is None or pos - cand > LZ4_MAX_OFFSET:
+            pos += 1
+            continue
+
+        match_end = pos + LZ4_MIN_MATCH
+        max_match_end = len(data) - LZ4_LAST_LITERALS
+        while (
+            match_end < max_match_end
+            and data[match_end] == data[cand + match_end - pos]
+        ):
+            match_end += 1
+
+        write_sequence(out, data[anchor:pos], pos - cand, match_end - pos)
+
+        # Index some of the positions the match covered so later matches can
+        # refer to them
+        for i in range(pos + 1, min(match_end, match_limit), 2):
+            positions[data[i : i + LZ4_MIN_MATCH]] = i
+        pos = anchor = match_end
+
+    # The last sequence only has literals
+    write_sequence(out, data[anchor:], 0, 0)
+    return bytes(out)
+
+
 COMPRESSION_METHODS = {
     "yaz0": crunch64.yaz0.compress,
     "gzip": crunch64.gzip.compress,
+    "yaz0-native": compress_yaz0_native,
+    "lz4": compress_lz4,
 }
 
 
+def get_encoder_identity(compression_format: str):
+    """
+    Identify the encoder of a compression format, so that its cached output
+    isn't reused once the encoder changes.
+    """
+    if compression_format == "yaz0-native":
+        # The binary built by tools/Makefile, rebuilt when its source changes
+        return "yaz0-native " + hashlib.sha256(YAZ0_NATIVE_P.read_bytes()).hexdigest()
+    elif compression_format == "lz4":
+        # compress_lz4 is in this file
+        return "lz4 " + hashlib.sha256(Path(__file__).read_bytes()).hexdigest()
+    else:
+        try:
+            version = importlib.metadata.version("crunch64")
+        except importlib.metadata.PackageNotFoundError:
+            version = getattr(crunch64, "__version__", "unknown")
+        return "crunch64 " + version
+
+
+class CompressionCache:
+    """
+    On-disk cache of compressed segments, keyed by a hash of the uncompressed
+    data, the compression format and the identity of its encoder (see
+    get_encoder_identity).
+    """
+
+    def __init__(self, cache_dir: Path):
+        self.cache_dir = cache_dir
+        self.encoder_identities: dict[str, str] = {}
+        self.hits = 0
+        self.misses = 0
+        self.cache_dir.mkdir(parents=True, exist_ok=True)
+
+    def _path(self, data: bytes, compression_format: str):
+        encoder_identity = self.encoder_identities.get(compression_format)
+        if encoder_identity is None:
+            encoder_identity = get_encoder_identity(compression_format)
+            self.encoder_identities[compression_format] = encoder_identity
+        h = hashlib.sha256()
+        h.update(compression_format.encode())
+        h.update(b"\0")
+        h.update(encoder_identity.encode())
+        h.update(b"\0")
+        h.update(data)
+        key = h.hexdigest()
+        return self.cache_dir / key[:2] / f"{key}.{compression_format}"
+
+    def get(self, data: bytes, compression_format: str):
+        try:
+            compressed_data = self._path(data, compression_format).read_bytes()
+        except FileNotFoundError:
+            self.misses += 1
+            return None
+        self.hits += 1
+        return compressed_data
+
+    def put(self, data: bytes, compression_format: str, compressed_data: bytes):
+        path = self._path(data, compression_format)
+        path.parent.mkdir(exist_ok=True)
+        # Write to a temporary file first so an interrupted run can't leave a
+        # truncated entry behind
+        tmp_path = path.with_name(f"{path.name}.{os.getpid()}.tmp")
+        tmp_path.write_bytes(compressed_data)
+        os.replace(tmp_path, path)
+
+    def print_stats(self):
+        total = self.hits + self.misses
+        hit_rate = self.hits / total if total != 0 else 0
+        print(
+            f"Compression cache: {self.hits}/{total} hits ({hit_rate * 100:.1f}%)"
+        )
+
+
+# Chunked containers, see make_chunked_container
+STRUCT_CHUNKED_HEADER = struct.Struct(">4sIII")
+CHUNKED_MAGIC = b"YAZC"
+# Must match YAZ0_CHUNKED_MAX_BLOCK_SIZE in src/boot/yaz0.c, the size of the buffer chunks are decoded through
+MAX_CHUNK_SIZE = 0x2000
+DEFAULT_CHUNK_SIZE = MAX_CHUNK_SIZE
+
+
 def align(v: int):
     v += 0xF
     return v // 0x10 * 0x10
 
 
+@dataclasses.dataclass
+class CompressionJob:
+    """
+    Data compressed as one unit: a whole segment, or one block of a chunked segment.
+    """
+
+    data_uncompressed: bytes
+    compression_format: str
+    data: bytes | None = None
+    data_async: multiprocessing.pool.AsyncResult | None = None
+
+
 @dataclasses.dataclass
 class RomSegment:
     vrom_start: int
@@ -35,13 +221,48 @@ class RomSegment:
     is_compressed: bool
     is_syms: bool
     data: memoryview | None
-    data_async: multiprocessing.pool.AsyncResult | None
+    # For compressed segments, the jobs to put together to make `data`
+    compression_jobs: list[CompressionJob]
+    # Whether the segment is stored as a chunked container instead of a single compressed file
+    chunk_size: int | None = None
+    is_lz4: bool = False
 
     @property
     def uncompressed_size(self):
         return self.vrom_end - self.vrom_start
 
 
+def make_chunked_container(uncompressed_size: int, chunk_size: int, chunks: list[bytes]):
+    """
+    Put together independently compressed chunks into a chunked container, see
+    Yaz0_DecompressChunked in src/boot/yaz0.c:
+    ```c
+    typedef struct Yaz0ChunkedHeader {
+        /* 0x00 */ char magic[4]; // YAZC
+        /* 0x04 */ u32 decSize;
+        /* 0x08 */ u32 blockSize;
+        /* 0x0C */ u32 numBlocks;
+    } Yaz0ChunkedHeader; // size = 0x10, followed by the block offsets
+    ```
+    """
+    offsets_start = STRUCT_CHUNKED_HEADER.size
+    offsets = []
+    offset = align(offsets_start + 4 * (len(chunks) + 1))
+    for chunk in chunks:
+        offsets.append(offset)
+        offset = align(offset + len(chunk))
+    offsets.append(offset)
+
+    container = bytearray(offset)
+    STRUCT_CHUNKED_HEADER.pack_into(
+        container, 0, CHUNKED_MAGIC, uncompressed_size, chunk_size, len(chunks)
+    )
+    struct.pack_into(f">{len(offsets)}I", container, offsets_start, *offsets)
+    for chunk, chunk_offset in zip(chunks, offsets):
+        container[chunk_offset : chunk_offset + len(chunk)] = chunk
+    return bytes(container)
+
+
 # Make interrupting the compression with ^C less jank
 # https://stackoverflow.com/questions/72967793/keyboardinterrupt-with-python-multiprocessing-pool
 def set_sigint_ignored():
@@ -58,6 +279,11 @@ def compress_rom(
     pad_to_multiple_of: int,
     fill_padding_bytes: bool,
     n_threads: int = None,
+    cache: CompressionCache | None = None,
+    chunked_min_size: int | None = None,
+    chunk_size: int = DEFAULT_CHUNK_SIZE,
+    lz4_entries_indices: set[int] = set(),
+    keep_table_order: bool = False,
 ):
     """
     rom_data: the uncompressed rom data
@@ -67,11 +293,13 @@ def compress_rom(
     pad_to_multiple_of: pad the compressed rom to a multiple of this size, in bytes
     fill_padding_bytes: fill the padding bytes with a 0x00 0x01 0x02 ... pattern instead of zeros
     n_threads: how many cores to use for compression
+    cache: if set, reuse previously compressed segments and store new ones
+    chunked_min_size: if set, compressed segments at least this large (uncompressed) are stored as chunked containers
+    chunk_size: the uncompressed size of each chunk in chunked containers
+    lz4_entries_indices: the indices in the dmadata of the segments that should be compressed with lz4 instead
+    keep_table_order: write the new dmadata in the order of the uncompressed dmadata instead of in ROM order
     """
 
-    # Compression function
-    compress = COMPRESSION_METHODS[compression_format]
-
     # Segments of the compressed rom (not all are compressed)
     compressed_rom_segments: list[RomSegment] = []
 
@@ -79,7 +307,13 @@ def compress_rom(
     # We sort the DMA entries by ROM start because `compress_entries_indices`
     # refers to indices in ROM order, but the uncompressed dmadata might not be
     # in ROM order.
-    dma_entries.sort(key=lambda dma_entry: dma_entry.vrom_start)
+    # With `keep_table_order`, the new dmadata is written back in the original
+    # order, which the game's dmadata index relies on (see DmaMgr_FindEntry in
+    # src/boot/z_std_dma.c).
+    dma_entries_table_indices = sorted(
+        range(len(dma_entries)), key=lambda i: dma_entries[i].vrom_start
+    )
+    dma_entries = [dma_entries[i] for i in dma_entries_table_indices]
 
     with multiprocessing.Pool(n_threads, initializer=set_sigint_ignored) as p:
         # Extract each segment from the input rom
@@ -90,17 +324,45 @@ def compress_rom(
             )
             segment_data_uncompressed = rom_data[segment_rom_start:segment_rom_end]
 
-            is_compressed = entry_index in compress_entries_indices
+            is_lz4 = entry_index in lz4_entries_indices
+            is_compressed = is_lz4 or entry_index in compress_entries_indices
+            segment_compression_format = "lz4" if is_lz4 else compression_format
 
+            segment_chunk_size = None
+            compression_jobs = []
             if is_compressed:
                 segment_data = None
-                segment_data_async = p.apply_async(
-                    compress,
-                    (bytes(segment_data_uncompressed),),
-                )
+                if (
+                    not is_lz4
+                    and chunked_min_size is not None
+                    and len(segment_data_uncompressed) >= chunked_min_size
+                ):
+                    # Chunks are compressed independently, so they can be
+                    # compressed in parallel too
+                    segment_chunk_size = chunk_size
+                    chunks_uncompressed = [
+                        segment_data_uncompressed[i : i + chunk_size]
+                        for i in range(0, len(segment_data_uncompressed), chunk_size)
+                    ]
+                else:
+                    chunks_uncompressed = [segment_data_uncompressed]
+
+                for chunk_uncompressed in chunks_uncompressed:
+                    job = CompressionJob(
+                        bytes(chunk_uncompressed), segment_compression_format
+                    )
+                    if cache is not None:
+                        job.data = cache.get(
+                            job.data_uncompressed, job.compression_format
+                        )
+                    if job.data is None:
+                        job.data_async = p.apply_async(
+                            COMPRESSION_METHODS[job.compression_format],
+                            (job.data_uncompressed,),
+                        )
+                    compression_jobs.append(job)
             else:
                 segment_data = segment_data_uncompressed
-                segment_data_async = None
 
             compressed_rom_segments.append(
                 RomSegment(
@@ -109,19 +371,24 @@ def compress_rom(
                     is_compressed,
                     dma_entry.is_syms(),
                     segment_data,
-                    segment_data_async,
+                    compression_jobs,
+                    segment_chunk_size,
+                    is_lz4,
                 )
             )
 
-        # Wait on compression of all compressed segments
-        waiting_on_segments = [
-            segment for segment in compressed_rom_segments if segment.is_compressed
+        # Wait on all compression jobs
+        waiting_on_jobs = [
+            job
+            for segment in compressed_rom_segments
+            for job in segment.compression_jobs
+            if job.data_async is not None
         ]
         total_uncompressed_size_of_data_to_compress = sum(
-            segment.uncompressed_size for segment in waiting_on_segments
+            len(job.data_uncompressed) for job in waiting_on_jobs
         )
         uncompressed_size_of_data_compressed_so_far = 0
-        while waiting_on_segments:
+        while waiting_on_jobs:
             # Show progress
             progress = (
                 uncompressed_size_of_data_compressed_so_far
@@ -129,34 +396,59 @@ def compress_rom(
             )
             print(f"Compressing... {progress * 100:.1f}%", end="\r")
 
-            # The segments for which the compression is not finished yet are
+            # The jobs for which the compression is not finished yet are
             # added to this list
-            still_waiting_on_segments = []
+            still_waiting_on_jobs = []
             got_some_results = False
-            for segment in waiting_on_segments:
-                assert segment.data is None
-                assert segment.data_async is not None
+            for job in waiting_on_jobs:
+                assert job.data is None
+                assert job.data_async is not None
 
                 try:
-                    compressed_data = segment.data_async.get(0)
+                    compressed_data = job.data_async.get(0)
                 except multiprocessing.TimeoutError:
                     # Compression not finished yet
-                    still_waiting_on_segments.append(segment)
+                    still_waiting_on_jobs.append(job)
                 else:
                     # Compression finished!
                     assert isinstance(compressed_data, bytes)
-                    segment.data = memoryview(compressed_data)
-                    uncompressed_size_of_data_compressed_so_far += (
-                        segment.uncompressed_size
+                    job.data = compressed_data
+                    uncompressed_size_of_data_compressed_so_far += len(
+                        job.data_uncompressed
                     )
                     got_some_results = True
-                    segment.data_async = None
-
-            if not got_some_results and still_waiting_on_segments:
+                    job.data_async = None
+                    if cache is not None:
+                        cache.put(
+                            job.data_uncompressed,
+                            job.compression_format,
+                            compressed_data,
+                        )
+
+            if not got_some_results and still_waiting_on_jobs:
                 # Nothing happened this wait iteration, idle a bit
                 time.sleep(0.010)
 
-            waiting_on_segments = still_waiting_on_segments
+            waiting_on_jobs = still_waiting_on_jobs
+
+    for segment in compressed_rom_segments:
+        if not segment.is_compressed:
+            continue
+        if segment.chunk_size is not None:
+            segment.data = memoryview(
+                make_chunked_container(
+                    segment.uncompressed_size,
+                    segment.chunk_size,
+                    [job.data for job in segment.compression_jobs],
+                )
+            )
+        else:
+            (job,) = segment.compression_jobs
+            segment.data = memoryview(job.data)
+        segment.compression_jobs = []
+
+    if cache is not None:
+        cache.print_stats()
 
     print("Putting together the compressed rom...")
 
@@ -189,6 +481,10 @@ def compress_rom(
             segment_rom_end = 0xFFFFFFFF
         elif not segment.is_compressed:
             segment_rom_end = 0
+        elif segment.chunk_size is not None:
+            segment_rom_end |= dmadata.ROM_END_FLAG_CHUNKED
+        elif segment.is_lz4:
+            segment_rom_end |= dmadata.ROM_END_FLAG_LZ4
 
         compressed_rom_dma_entries.append(
             dmadata.DmaEntry(
@@ -206,14 +502,48 @@ def compress_rom(
             compressed_rom_data[i] = i % 256
 
     # Write the new dmadata
-    offset = dmadata_start
-    for dma_entry in compressed_rom_dma_entries:
-        dma_entry.to_bin(compressed_rom_data[offset:])
-        offset += dmadata.DmaEntry.SIZE_BYTES
+    if keep_table_order:
+        for table_index, dma_entry in zip(
+            dma_entries_table_indices, compressed_rom_dma_entries
+        ):
+            offset = dmadata_start + table_index * dmadata.DmaEntry.SIZE_BYTES
+            dma_entry.to_bin(compressed_rom_data[offset:])
+    else:
+        offset = dmadata_start
+        for dma_entry in compressed_rom_dma_entries:
+            dma_entry.to_bin(compressed_rom_data[offset:])
+            offset += dmadata.DmaEntry.SIZE_BYTES
 
     return compressed_rom_data
 
 
+def parse_compress_ranges(compress_ranges_str: str):
+    """
+    Parse a comma-separated list of individual indices and inclusive ranges,
+    e.g. '0-1,3,5,6-9', into a set of indices.
+    """
+    compress_entries_indices: set[int] = set()
+    if compress_ranges_str == "":
+        return compress_entries_indices
+    for compress_range_str in compress_ranges_str.split(","):
+        compress_range_ends_str = compress_range_str.split("-")
+        assert len(compress_range_ends_str) <= 2, (
+            compress_range_ends_str,
+            compress_range_str,
+            compress_ranges_str,
+        )
+        compress_range_ends = [int(v_str) for v_str in compress_range_ends_str]
+        if len(compress_range_ends) == 1:
+            compress_entries_indices.add(compress_range_ends[0])
+        else:
+            assert len(compress_range_ends) == 2
+            compress_range_first, compress_range_last = compress_range_ends
+            compress_entries_indices.update(
+                range(compress_range_first, compress_range_last + 1)
+            )
+    return compress_entries_indices
+
+
 def main():
     parser = argparse.ArgumentParser()
     parser.add_argument(
@@ -248,10 +578,20 @@ def main():
             " e.g. '0-1,3,5,6-9' is all indices from 0 to 9 (included) except 2 and 4."
         ),
     )
+    parser.add_argument(
+        "--compress-lz4",
+        dest="compress_lz4_ranges",
+        default="",
+        help=(
+            "The indices in the dmadata of the entries to be compressed with lz4 instead of --format,"
+            " in the same format as --compress."
+            " The game must be built with LZ4_COMPRESSION=1 to load them."
+        ),
+    )
     parser.add_argument(
         "--format",
         dest="format",
-        choices=COMPRESSION_METHODS.keys(),
+        choices=[f for f in COMPRESSION_METHODS.keys() if f != "lz4"],
         default="yaz0",
         help="compression format to use (default: yaz0)",
     )
@@ -274,8 +614,48 @@ def main():
         default=1,
         help="how many cores to use for parallel compression",
     )
+    parser.add_argument(
+        "--cache-dir",
+        dest="cache_dir",
+        type=Path,
+        help=(
+            "directory of a persistent cache of compressed segments,"
+            " segments whose data is unchanged since a previous run are not compressed again"
+        ),
+    )
+    parser.add_argument(
+        "--chunked-min-size",
+        dest="chunked_min_size",
+        type=lambda s: int(s, 16),
+        help=(
+            "store compressed segments at least this large (uncompressed, in hex) as chunked containers"
+            " of independently compressed chunks, which the game must be built with CHUNKED_YAZ0=1 to load"
+        ),
+    )
+    parser.add_argument(
+        "--chunk-size",
+        dest="chunk_size",
+        type=lambda s: int(s, 16),
+        default=DEFAULT_CHUNK_SIZE,
+        help=f"uncompressed size of the chunks of chunked containers, in hex (default: 0x{DEFAULT_CHUNK_SIZE:X})",
+    )
+    parser.add_argument(
+        "--keep-table-order",
+        dest="keep_table_order",
+        action="store_true",
+        help=(
+            "write the new dmadata in the order of the input dmadata instead of in ROM order,"
+            " which the game must be built with DMA_TABLE_INDEX=1 to rely on"
+        ),
+    )
     args = parser.parse_args()
 
+    if not (0 < args.chunk_size <= MAX_CHUNK_SIZE):
+        parser.error(
+            f"--chunk-size must be between 0x1 and 0x{MAX_CHUNK_SIZE:X},"
+            " the size of the game's chunk buffer."
+        )
+
     in_rom_p = Path(args.in_rom)
     if not in_rom_p.exists():
         parser.error(f"Input rom file {in_rom_p} doesn't exist.")
@@ -284,29 +664,17 @@ def main():
 
     dmadata_start = args.dmadata_start
 
-    compress_ranges_str: str = args.compress_ranges
-    compress_entries_indices = set()
-    for compress_range_str in compress_ranges_str.split(","):
-        compress_range_ends_str = compress_range_str.split("-")
-        assert len(compress_range_ends_str) <= 2, (
-            compress_range_ends_str,
-            compress_range_str,
-            compress_ranges_str,
-        )
-        compress_range_ends = [int(v_str) for v_str in compress_range_ends_str]
-        if len(compress_range_ends) == 1:
-            compress_entries_indices.add(compress_range_ends[0])
-        else:
-            assert len(compress_range_ends) == 2
-            compress_range_first, compress_range_last = compress_range_ends
-            compress_entries_indices.update(
-                range(compress_range_first, compress_range_last + 1)
-            )
+    compress_entries_indices = parse_compress_ranges(args.compress_ranges)
 
     compression_format = args.format
     pad_to_multiple_of = args.pad_to
     fill_padding_bytes = args.fill_padding_bytes
     n_threads = args.n_threads
+    cache = (
+        CompressionCache(args.cache_dir)
+        if args.cache_dir is not None
+        else None
+    )
 
     in_rom_data = in_rom_p.read_bytes()
     out_rom_data = compress_rom(
@@ -317,6 +685,11 @@ def main():
         pad_to_multiple_of,
         fill_padding_bytes,
         n_threads,
+        cache,
+        args.chunked_min_size,
+        args.chunk_size,
+        parse_compress_ranges(args.compress_lz4_ranges),
+        args.keep_table_order,
     )
     out_rom_p.write_bytes(out_rom_data)
 
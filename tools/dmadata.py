@@ -9,6 +9,14 @@ import struct
 
 STRUCT_IIII = struct.Struct(">IIII")
 
+# Segments are 16-byte aligned in the rom, so the low bits of the rom end of
+# compressed segments are used as flags (see DMA_ENTRY_ROM_END_FLAGS in include/dma.h)
+ROM_END_FLAGS_MASK = 0xF
+# The segment is a chunked container (see compress.make_chunked_container)
+ROM_END_FLAG_CHUNKED = 1 << 0
+# The segment is compressed with lz4 (see compress.compress_lz4)
+ROM_END_FLAG_LZ4 = 1 << 1
+
 
 @dataclasses.dataclass
 class DmaEntry:
@@ -26,7 +26,22 @@ static void write_dmadata_table(FILE *fout)
     }
 }
 
-static void write_compress_ranges(FILE *fout)
+// The linker lays out segments in the ROM in spec order, so this is also the order of their VROM addresses.
+// The dmadata table itself may use a different order (see include/tables/dmadata_table.h).
+static void write_dmadata_index(FILE *fout)
+{
+    int i;
+
+    for (i = 0; i < g_segmentsCount; i++) {
+        if (g_segments[i].flags & FLAG_NOLOAD) {
+            continue;
+        }
+
+        fprintf(fout, "DEFINE_DMA_INDEX_ENTRY(%s)\n", g_segments[i].name);
+    }
+}
+
+static void write_compress_ranges(FILE *fout, CompressFormat format)
 {
     int i;
     int rom_index = 0;
@@ -34,7 +49,7 @@ static void write_compress_ranges(FILE *fout)
     int stride_first = -1;
 
     for (i = 0; i < g_segmentsCount; i++) {
-        bool compress = g_segments[i].compress;
+        bool compress = g_segments[i].compress && g_segments[i].compressFormat == format;
 
         // Don't consider segments set with NOLOAD when calculating indices
         if (g_segments[i].flags & FLAG_NOLOAD) {
@@ -68,10 +83,12 @@ static void write_compress_ranges(FILE *fout)
 static void usage(const char *execname)
 {
     fprintf(stderr, "zelda64 dmadata generation tool v0.01\n"
-                    "usage: %s SPEC_FILE DMADATA_TABLE COMPRESS_RANGES\n"
+                    "usage: %s SPEC_FILE DMADATA_TABLE COMPRESS_RANGES [LZ4_RANGES [DMADATA_INDEX]]\n"
                     "SPEC_FILE      file describing the organization of object files into segments\n"
                     "DMADATA_TABLE  filename of output dmadata table header\n"
-                    "COMPRESS_RANGES filename to write which files are compressed (e.g. 0-5,7,10-20)\n",
+                    "COMPRESS_RANGES filename to write which files are compressed (e.g. 0-5,7,10-20)\n"
+                    "LZ4_RANGES     filename to write which files are compressed with 'compress lz4'\n"
+                    "DMADATA_INDEX  filename of output header listing the dmadata entries in VROM order\n",
                     execname);
 }
 
@@ -79,10 +96,12 @@ int main(int argc, char **argv)
 {
     FILE *dmaout;
     FILE *compress_ranges_out;
+    FILE *lz4_ranges_out;
+    FILE *index_out;
     void *spec;
     size_t size;
 
-    if (argc != 4)
+    if (argc < 4 || argc > 6)
     {
         usage(argv[0]);
         return 1;
@@ -100,9 +119,27 @@ int main(int argc, char **argv)
     compress_ranges_out = fopen(argv[3], "w");
     if (compress_ranges_out == NULL)
         util_fatal_error("failed to open file '%s' for writing", argv[3]);
-    write_compress_ranges(compress_ranges_out);
+    write_compress_ranges(compress_ranges_out, COMPRESS_FORMAT_DEFAULT);
     fclose(compress_ranges_out);
 
+    if (argc >= 5)
+    {
+        lz4_ranges_out = fopen(argv[4], "w");
+        if (lz4_ranges_out == NULL)
+            util_fatal_error("failed to open file '%s' for writing", argv[4]);
+        write_compress_ranges(lz4_ranges_out, COMPRESS_FORMAT_LZ4);
+        fclose(lz4_ranges_out);
+    }
+
+    if (argc == 6)
+    {
+        index_out = fopen(argv[5], "w");
+        if (index_out == NULL)
+            util_fatal_error("failed to open file '%s' for writing", argv[5]);
+        write_dmadata_index(index_out);
+        fclose(index_out);
+    }
+
     free_rom_spec(g_segments, g_segmentsCount);
     free(spec);
 
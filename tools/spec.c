@@ -224,6 +224,12 @@ bool parse_segment_statement(struct Segment *currSeg, STMTId stmt, char* args, i
         break;
     case STMT_compress:
         currSeg->compress = true;
+        if (args[0] == 0)
+            currSeg->compressFormat = COMPRESS_FORMAT_DEFAULT;
+        else if (strcmp(args, "lz4") == 0)
+            currSeg->compressFormat = COMPRESS_FORMAT_LZ4;
+        else
+            util_fatal_error("line %i: unknown compression format '%s'", lineNum, args);
         break;
     case STMT_pad_text:
         currSeg->includes[currSeg->includesCount - 1].linkerPadding += 0x10;
@@ -30,6 +30,11 @@ enum {
     FLAG_SYMS = (1 << 4)
 };
 
+typedef enum {
+    COMPRESS_FORMAT_DEFAULT, // Yaz0, or gzip on iQue
+    COMPRESS_FORMAT_LZ4,
+} CompressFormat;
+
 struct Include {
     char* fpath;
     int linkerPadding;
@@ -50,6 +55,7 @@ typedef struct Segment {
     struct Include* includes;
     int includesCount;
     bool compress;
+    CompressFormat compressFormat;
 } Segment;
 
 void parse_rom_spec(char* spec, struct Segment** segments, int* segment_count);
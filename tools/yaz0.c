@@ -0,0 +1,505 @@
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "util.h"
+
+/*
+ * Yaz0 encoder/decoder.
+ *
+ * The output is decodable by Yaz0_DecompressImpl (src/boot/yaz0.c):
+ *  - 16 bytes header: "Yaz0", big-endian uncompressed size, 8 zero bytes
+ *  - groups of one flag byte followed by 8 chunks, MSB first
+ *    - flag bit set: one literal byte
+ *    - flag bit clear: back-reference, 2 bytes NB BB (length N + 2, 3 to 17)
+ *      or 3 bytes 0B BB NN (length NN + 0x12, 18 to 273), copying from
+ *      B + 1 bytes back (1 to 4096)
+ *
+ * Match finding is the expensive part of compression, so it is done up front
+ * for every input position and split across threads for large inputs. The
+ * parse (greedy with one step of lookahead like the original encoder, or an
+ * optimal parse minimizing the output size) then runs serially over the
+ * precomputed matches.
+ */
+
+#define YAZ0_HEADER_SIZE 0x10
+#define WINDOW_SIZE 0x1000
+#define MIN_MATCH 3
+#define MAX_MATCH (0xFF + 0x12)
+#define MAX_SHORT_MATCH (0xF + 2)
+
+#define HASH_BITS 15
+#define HASH_SIZE (1 << HASH_BITS)
+
+// Candidates tried per position before settling for the longest match found so far
+#define DEFAULT_MAX_CHAIN_DEPTH 256
+
+// Inputs smaller than this are not worth splitting across threads
+#define MIN_BYTES_PER_THREAD 0x10000
+
+typedef struct {
+    const uint8_t *src;
+    size_t srcSize;
+    size_t start;
+    size_t end;
+    int maxChainDepth;
+    // Longest match length (0 if shorter than MIN_MATCH) and its distance, for each position
+    uint16_t *matchLen;
+    uint16_t *matchDist;
+} MatchFinderJob;
+
+static inline uint32_t hash3(const uint8_t *p)
+{
+    return ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> (32 - HASH_BITS);
+}
+
+static void *find_matches(void *arg)
+{
+    MatchFinderJob *job = arg;
+    const uint8_t *src = job->src;
+    size_t srcSize = job->srcSize;
+    int32_t *head = malloc(HASH_SIZE * sizeof(int32_t));
+    int32_t *prev = malloc(WINDOW_SIZE * sizeof(int32_t));
+    size_t windowStart = (job->start > WINDOW_SIZE) ? job->start - WINDOW_SIZE : 0;
+    size_t pos;
+
+    if (head == NULL || prev == NULL)
+        util_fatal_error("out of memory");
+
+    for (pos = 0; pos < HASH_SIZE; pos++)
+        head[pos] = -1;
+
+    // The hash chains hold the window preceding each position, so each job
+    // first inserts the positions just before its range
+    for (pos = windowStart; pos < job->end; pos++) {
+        size_t maxLen = srcSize - pos;
+        size_t bestLen = 0;
+        size_t bestDist = 0;
+        uint32_t h;
+
+        if (maxLen < MIN_MATCH) {
+            if (pos >= job->start)
+                job->matchLen[pos] = 0;
+            continue;
+        }
+        if (maxLen > MAX_MATCH)
+            maxLen = MAX_MATCH;
+
+        h = hash3(&src[pos]);
+
+        if (pos >= job->start) {
+            int32_t cand = head[h];
+            int depth = job->maxChainDepth;
+
+            while (cand >= 0 && pos - cand <= WINDOW_SIZE && depth-- != 0) {
+                const uint8_t *a = &src[cand];
+                const uint8_t *b = &src[pos];
+
+                // Only a candidate that extends past the current best can improve on it
+                if (a[bestLen] == b[bestLen] && a[0] == b[0]) {
+                    size_t len = 0;
+
+                    while (len < maxLen && a[len] == b[len])
+                        len++;
+
+                    if (len > bestLen) {
+                        bestLen = len;
+                        bestDist = pos - cand;
+                        if (len == maxLen)
+                            break;
+                    }
+                }
+                cand = prev[cand % WINDOW_SIZE];
+            }
+
+            if (bestLen < MIN_MATCH) {
+                bestLen = 0;
+                bestDist = 0;
+            }
+            job->matchLen[pos] = bestLen;
+            job->matchDist[pos] = bestDist;
+        }
+
+        prev[pos % WINDOW_SIZE] = head[h];
+        head[h] = pos;
+    }
+
+    free(head);
+    free(prev);
+    return NULL;
+}
+
+static void find_all_matches(const uint8_t *src, size_t srcSize, uint16_t *matchLen, uint16_t *matchDist,
+                             int numThreads, int maxChainDepth)
+{
+    MatchFinderJob *jobs;
+    pthread_t *threads;
+    size_t chunkSize;
+    int i;
+
+    if (numThreads < 1)
+        numThreads = 1;
+    if ((size_t)numThreads > srcSize / MIN_BYTES_PER_THREAD)
+        numThreads = (srcSize / MIN_BYTES_PER_THREAD > 0) ? srcSize / MIN_BYTES_PER_THREAD : 1;
+
+    jobs = calloc(numThreads, sizeof(MatchFinderJob));
+    threads = calloc(numThreads, sizeof(pthread_t));
+    if (jobs == NULL || threads == NULL)
+        util_fatal_error("out of memory");
+
+    chunkSize = (srcSize + numThreads - 1) / numThreads;
+    for (i = 0; i < numThreads; i++) {
+        jobs[i].src = src;
+        jobs[i].srcSize = srcSize;
+        jobs[i].start = i * chunkSize;
+        jobs[i].end = (i == numThreads - 1) ? srcSize : (i + 1) * chunkSize;
+        jobs[i].maxChainDepth = maxChainDepth;
+        jobs[i].matchLen = matchLen;
+        jobs[i].matchDist = matchDist;
+    }
+
+    if (numThreads == 1) {
+        find_matches(&jobs[0]);
+    } else {
+        for (i = 0; i < numThreads; i++) {
+            if (pthread_create(&threads[i], NULL, find_matches, &jobs[i]) != 0)
+                util_fatal_error("failed to create thread: %s", strerror(errno));
+        }
+        for (i = 0; i < numThreads; i++)
+            pthread_join(threads[i], NULL);
+    }
+
+    free(jobs);
+    free(threads);
+}
+
+// Size of a back-reference in bits, including its flag bit
+static inline uint32_t match_cost(size_t len)
+{
+    return 1 + ((len <= MAX_SHORT_MATCH) ? 16 : 24);
+}
+
+#define LITERAL_COST (1 + 8)
+
+// Chooses the length of the chunk emitted at each position (1 for a literal)
+// so the total output size is minimal. Since the cost of a back-reference
+// does not depend on its distance, any length up to the longest match at a
+// position is available at the same distance.
+static void parse_optimal(size_t srcSize, const uint16_t *matchLen, uint16_t *chunkLen)
+{
+    uint32_t *cost = malloc((srcSize + 1) * sizeof(uint32_t));
+    size_t pos;
+
+    if (cost == NULL)
+        util_fatal_error("out of memory");
+
+    cost[srcSize] = 0;
+    for (pos = srcSize; pos-- != 0;) {
+        uint32_t best = LITERAL_COST + cost[pos + 1];
+        size_t bestLen = 1;
+        size_t len;
+
+        for (len = MIN_MATCH; len <= matchLen[pos]; len++) {
+            uint32_t c = match_cost(len) + cost[pos + len];
+
+            if (c < best) {
+                best = c;
+                bestLen = len;
+            }
+        }
+        cost[pos] = best;
+        chunkLen[pos] = bestLen;
+    }
+
+    free(cost);
+}
+
+// Takes the longest match at each position, unless the match at the next
+// position is at least 2 bytes longer, in which case a literal is emitted first.
+static void parse_greedy(size_t srcSize, const uint16_t *matchLen, uint16_t *chunkLen)
+{
+    size_t pos;
+
+    for (pos = 0; pos < srcSize; pos++) {
+        size_t len = matchLen[pos];
+
+        if (len != 0 && pos + 1 < srcSize && matchLen[pos + 1] >= len + 2)
+            len = 0;
+        chunkLen[pos] = (len != 0) ? len : 1;
+    }
+}
+
+static uint8_t *yaz0_compress(const uint8_t *src, size_t srcSize, size_t *pDstSize, bool optimal, int numThreads,
+                              int maxChainDepth)
+{
+    uint16_t *matchLen = malloc((srcSize + 1) * sizeof(uint16_t));
+    uint16_t *matchDist = malloc((srcSize + 1) * sizeof(uint16_t));
+    uint16_t *chunkLen = malloc((srcSize + 1) * sizeof(uint16_t));
+    // Worst case is all literals: one flag byte per 8 bytes
+    uint8_t *dst = malloc(YAZ0_HEADER_SIZE + srcSize + (srcSize + 7) / 8 + 0x10);
+    uint8_t *out;
+    uint8_t *flagPtr = NULL;
+    int flagBit = 0;
+    size_t pos;
+
+    if (matchLen == NULL || matchDist == NULL || chunkLen == NULL || dst == NULL)
+        util_fatal_error("out of memory");
+
+    find_all_matches(src, srcSize, matchLen, matchDist, numThreads, maxChainDepth);
+
+    if (optimal)
+        parse_optimal(srcSize, matchLen, chunkLen);
+    else
+        parse_greedy(srcSize, matchLen, chunkLen);
+
+    memcpy(dst, "Yaz0", 4);
+    util_write_uint32_be(&dst[4], srcSize);
+    memset(&dst[8], 0, 8);
+    out = &dst[YAZ0_HEADER_SIZE];
+
+    pos = 0;
+    while (pos < srcSize) {
+        size_t len = chunkLen[pos];
+
+        if (flagBit == 0) {
+            flagPtr = out++;
+            *flagPtr = 0;
+            flagBit = 8;
+        }
+        flagBit--;
+
+        if (len == 1) {
+            *flagPtr |= 1 << flagBit;
+            *out++ = src[pos];
+        } else {
+            size_t off = matchDist[pos] - 1;
+
+            if (len <= MAX_SHORT_MATCH) {
+                *out++ = (len - 2) << 4 | off >> 8;
+                *out++ = off & 0xFF;
+            } else {
+                *out++ = off >> 8;
+                *out++ = off & 0xFF;
+                *out++ = len - 0x12;
+            }
+        }
+        pos += len;
+    }
+
+    free(matchLen);
+    free(matchDist);
+    free(chunkLen);
+
+    *pDstSize = out - dst;
+    return dst;
+}
+
+// Mirrors Yaz0_DecompressImpl, with bounds checks
+static uint8_t *yaz0_decompress(const uint8_t *src, size_t srcSize, size_t *pDstSize)
+{
+    const uint8_t *srcEnd = src + srcSize;
+    uint8_t *dst;
+    size_t dstSize;
+    size_t pos = 0;
+    uint32_t chunkHeader = 0;
+    int bitIdx = 0;
+
+    if (srcSize < YAZ0_HEADER_SIZE || memcmp(src, "Yaz0", 4) != 0)
+        util_fatal_error("input is not Yaz0 data");
+
+    dstSize = util_read_uint32_be(&src[4]);
+    dst = malloc(dstSize + 1);
+    if (dst == NULL)
+        util_fatal_error("out of memory");
+    src += YAZ0_HEADER_SIZE;
+
+    while (pos < dstSize) {
+        if (bitIdx == 0) {
+            if (src >= srcEnd)
+                util_fatal_error("truncated Yaz0 data");
+            chunkHeader = *src++;
+            bitIdx = 8;
+        }
+
+        if (chunkHeader & (1 << 7)) {
+            if (src >= srcEnd)
+                util_fatal_error("truncated Yaz0 data");
+            dst[pos++] = *src++;
+        } else {
+            size_t off;
+            size_t len;
+
+            if (src + 2 > srcEnd)
+                util_fatal_error("truncated Yaz0 data");
+            off = (src[0] & 0xF) << 8 | src[1];
+            len = src[0] >> 4;
+            src += 2;
+            if (len == 0) {
+                if (src >= srcEnd)
+                    util_fatal_error("truncated Yaz0 data");
+                len = *src++ + 0x12;
+            } else {
+                len += 2;
+            }
+
+            if (off + 1 > pos || pos + len > dstSize)
+                util_fatal_error("invalid back-reference at output offset 0x%zX", pos);
+
+            while (len-- != 0) {
+                dst[pos] = dst[pos - off - 1];
+                pos++;
+            }
+        }
+        chunkHeader <<= 1;
+        bitIdx--;
+    }
+
+    *pDstSize = dstSize;
+    return dst;
+}
+
+static uint8_t *read_input(const char *filename, size_t *pSize)
+{
+    uint8_t *buffer;
+    size_t size = 0;
+    size_t capacity = 0x10000;
+    size_t n;
+
+    if (strcmp(filename, "-") != 0)
+        return util_read_whole_file(filename, pSize);
+
+    buffer = malloc(capacity);
+    if (buffer == NULL)
+        util_fatal_error("out of memory");
+    while ((n = fread(buffer + size, 1, capacity - size, stdin)) != 0) {
+        size += n;
+        if (size == capacity) {
+            capacity *= 2;
+            buffer = realloc(buffer, capacity);
+            if (buffer == NULL)
+                util_fatal_error("out of memory");
+        }
+    }
+    if (ferror(stdin))
+        util_fatal_error("error reading from stdin: %s", strerror(errno));
+
+    *pSize = size;
+    return buffer;
+}
+
+static void write_output(const char *filename, const void *data, size_t size)
+{
+    if (strcmp(filename, "-") != 0) {
+        util_write_whole_file(filename, data, size);
+        return;
+    }
+
+    if (size != 0 && fwrite(data, size, 1, stdout) != 1)
+        util_fatal_error("error writing to stdout: %s", strerror(errno));
+    fflush(stdout);
+}
+
+static double get_time(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void usage(const char *execname)
+{
+    fprintf(stderr, "zelda64 Yaz0 compression tool\n"
+                    "usage: %s [-d] [-O] [-j THREADS] [-c DEPTH] [-v] INPUT OUTPUT\n"
+                    "INPUT       input file, or - for stdin\n"
+                    "OUTPUT      output file, or - for stdout\n"
+                    "-d          decompress instead of compressing\n"
+                    "-O          use an optimal parse (smallest output, differs from the original encoder)\n"
+                    "-j THREADS  number of threads to find matches with (default: number of CPUs)\n"
+                    "-c DEPTH    maximum number of match candidates tried per position, -1 for no limit\n"
+                    "            (default: %d)\n"
+                    "-v          print sizes and timings to stderr, and check the output decompresses\n"
+                    "            back to the input\n",
+                    execname, DEFAULT_MAX_CHAIN_DEPTH);
+}
+
+int main(int argc, char **argv)
+{
+    const char *inPath = NULL;
+    const char *outPath = NULL;
+    bool decompress = false;
+    bool optimal = false;
+    bool verbose = false;
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int maxChainDepth = DEFAULT_MAX_CHAIN_DEPTH;
+    uint8_t *input;
+    uint8_t *output;
+    size_t inSize;
+    size_t outSize;
+    double startTime;
+    double elapsed;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-d") == 0) {
+            decompress = true;
+        } else if (strcmp(argv[i], "-O") == 0) {
+            optimal = true;
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            numThreads = strtol(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            maxChainDepth = strtol(argv[++i], NULL, 0);
+        } else if (inPath == NULL && (argv[i][0] != '-' || argv[i][1] == '\0')) {
+            inPath = argv[i];
+        } else if (outPath == NULL && (argv[i][0] != '-' || argv[i][1] == '\0')) {
+            outPath = argv[i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (inPath == NULL || outPath == NULL) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    input = read_input(inPath, &inSize);
+
+    startTime = get_time();
+    if (decompress)
+        output = yaz0_decompress(input, inSize, &outSize);
+    else
+        output = yaz0_compress(input, inSize, &outSize, optimal, numThreads, maxChainDepth);
+    elapsed = get_time() - startTime;
+
+    if (verbose) {
+        size_t uncompressedSize = decompress ? outSize : inSize;
+
+        fprintf(stderr, "%s: 0x%zX -> 0x%zX bytes in %.3f ms (%.2f MB/s)\n", inPath, inSize, outSize,
+                elapsed * 1e3, (elapsed > 0) ? uncompressedSize / elapsed / 1e6 : 0.0);
+
+        if (!decompress) {
+            size_t checkSize;
+            uint8_t *check = yaz0_decompress(output, outSize, &checkSize);
+
+            if (checkSize != inSize || memcmp(check, input, inSize) != 0)
+                util_fatal_error("%s: compressed data does not decompress back to the input", inPath);
+            free(check);
+        }
+    }
+
+    write_output(outPath, output, outSize);
+
+    free(input);
+    free(output);
+    return 0;
+}
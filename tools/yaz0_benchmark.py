@@ -0,0 +1,154 @@
+#!/usr/bin/env python3
+
+# SPDX-FileCopyrightText: 2025 zeldaret
+# SPDX-License-Identifier: CC0-1.0
+
+"""
+Compare the native Yaz0 encoder (tools/yaz0) against crunch64 on the segments
+of an uncompressed rom, in terms of compression ratio and speed.
+
+Usage example, after building the rom and tools:
+    python3 tools/yaz0_benchmark.py --in build/gc-eu-mq-dbg/oot-gc-eu-mq-dbg.z64 \
+        --dmadata-start `./tools/dmadata_start.sh mips-linux-gnu-nm build/gc-eu-mq-dbg/oot-gc-eu-mq-dbg.elf` \
+        --compress `cat build/gc-eu-mq-dbg/compress_ranges.txt` --largest 20
+"""
+
+from __future__ import annotations
+
+import argparse
+import dataclasses
+from pathlib import Path
+import re
+import subprocess
+import tempfile
+import time
+
+import crunch64
+
+import compress
+import dmadata
+
+
+YAZ0_NATIVE_P = compress.YAZ0_NATIVE_P
+
+# Matches the timing line printed by `yaz0 -v`
+NATIVE_TIMING_RE = re.compile(r": 0x[0-9A-F]+ -> 0x([0-9A-F]+) bytes in ([0-9.]+) ms")
+
+
+@dataclasses.dataclass
+class Result:
+    compressed_size: int = 0
+    seconds: float = 0.0
+
+    def add(self, compressed_size: int, seconds: float):
+        self.compressed_size += compressed_size
+        self.seconds += seconds
+
+
+def run_native(in_p: Path, out_p: Path, extra_args: list[str]):
+    """
+    Run the native encoder, which also checks the output decompresses back to
+    the input with -v. The time reported by the encoder itself is used, so
+    process startup and file I/O aren't counted.
+    """
+    proc = subprocess.run(
+        [str(YAZ0_NATIVE_P), "-v", *extra_args, str(in_p), str(out_p)],
+        stderr=subprocess.PIPE,
+        text=True,
+        check=True,
+    )
+    m = NATIVE_TIMING_RE.search(proc.stderr)
+    assert m is not None, proc.stderr
+    return int(m.group(1), 16), float(m.group(2)) / 1000
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Benchmark the native Yaz0 encoder against crunch64"
+    )
+    parser.add_argument(
+        "--in",
+        dest="in_rom",
+        required=True,
+        help="path to an uncompressed rom",
+    )
+    parser.add_argument(
+        "--dmadata-start",
+        dest="dmadata_start",
+        type=lambda s: int(s, 16),
+        required=True,
+        help="the dmadata location in the rom, as a hexadecimal offset",
+    )
+    parser.add_argument(
+        "--compress",
+        dest="compress_ranges",
+        required=True,
+        help="the indices in the dmadata of the entries to benchmark, in the same format as compress.py",
+    )
+    parser.add_argument(
+        "--largest",
+        dest="largest",
+        type=int,
+        help="only benchmark this many of the largest segments",
+    )
+    parser.add_argument(
+        "--threads",
+        dest="n_threads",
+        type=int,
+        help="number of threads for the native encoder (default: number of CPUs)",
+    )
+    args = parser.parse_args()
+
+    if not YAZ0_NATIVE_P.exists():
+        parser.error(f"{YAZ0_NATIVE_P} doesn't exist, build it with `make -C tools`")
+
+    rom_data = memoryview(Path(args.in_rom).read_bytes())
+    compress_entries_indices = compress.parse_compress_ranges(args.compress_ranges)
+
+    dma_entries = dmadata.read_dmadata(rom_data, args.dmadata_start)
+    dma_entries.sort(key=lambda dma_entry: dma_entry.vrom_start)
+    segments = [
+        bytes(rom_data[e.rom_start : e.rom_start + (e.vrom_end - e.vrom_start)])
+        for i, e in enumerate(dma_entries)
+        if i in compress_entries_indices
+    ]
+    segments.sort(key=len, reverse=True)
+    if args.largest is not None:
+        segments = segments[: args.largest]
+
+    native_args = [] if args.n_threads is None else ["-j", str(args.n_threads)]
+    methods = {
+        "crunch64": None,
+        "native": native_args,
+        "native -O": ["-O", *native_args],
+    }
+    results = {name: Result() for name in methods}
+    total_size = sum(len(segment) for segment in segments)
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        in_p = Path(tmp_dir) / "in.bin"
+        out_p = Path(tmp_dir) / "out.yaz0"
+
+        for i, segment in enumerate(segments):
+            print(f"Segment {i + 1}/{len(segments)} (0x{len(segment):X} bytes)", end="\r")
+
+            start = time.perf_counter()
+            crunch64_data = crunch64.yaz0.compress(segment)
+            results["crunch64"].add(len(crunch64_data), time.perf_counter() - start)
+
+            in_p.write_bytes(segment)
+            for name, extra_args in methods.items():
+                if extra_args is not None:
+                    results[name].add(*run_native(in_p, out_p, extra_args))
+
+    print()
+    print(f"{len(segments)} segments, {total_size / 1e6:.2f} MB uncompressed")
+    print(f"{'encoder':<12} {'compressed':>12} {'ratio':>8} {'MB/s':>8}")
+    for name, result in results.items():
+        ratio = result.compressed_size / total_size
+        speed = total_size / result.seconds / 1e6 if result.seconds > 0 else 0
+        print(f"{name:<12} {result.compressed_size:>12} {ratio:>8.2%} {speed:>8.2f}")
+
+
+if __name__ == "__main__":
+    main()
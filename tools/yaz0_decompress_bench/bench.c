@@ -0,0 +1,382 @@
+/**
+ * Host benchmark for the Yaz0 decoder in src/boot/yaz0.c, and the LZ4 decoder in src/boot/lz4.c.
+ *
+ * Decompresses every Yaz0-compressed segment of a baserom with the game's decoder, checks the output against a plain
+ * decoder, and reports the decoding speed. The decoder's DMAs are copies out of the rom loaded in memory, so the
+ * numbers only measure the decoding loop, which is what changes between decoder versions. They are not a prediction
+ * of the speed on console, but are good enough to compare two versions of the decoder on the same machine.
+ *
+ * With BENCH_LZ4, the same segments are compressed again with LZ4 and decompressed with Lz4_Decompress instead, to
+ * compare the two formats on the same data.
+ *
+ * Usage: yaz0_decompress_bench_{ref,fast,lz4} ROM DMADATA_START [REPEAT]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef BENCH_LZ4
+#define BENCH_LZ4 0
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_RDTSC 1
+#else
+#define HAVE_RDTSC 0
+#endif
+
+#if BENCH_LZ4
+#include "array_count.h"
+#include "lz4.h"
+#else
+#include "yaz0.h"
+#endif
+
+#define YAZ0_HEADER_SIZE 0x10
+
+static u8* sRom;
+static size_t sRomSize;
+// What the decoder's DMAs copy from, the rom or the segment compressed with LZ4
+static u8* sDmaSource;
+static size_t sDmaSourceSize;
+static uintptr_t sSegmentRomStart;
+
+static u32 read_u32_be(const u8* p) {
+    return (u32)p[0] << 24 | (u32)p[1] << 16 | (u32)p[2] << 8 | p[3];
+}
+
+void DmaMgr_DmaRomToRam(uintptr_t rom, void* ram, size_t size) {
+    if (rom + size > sDmaSourceSize) {
+        fprintf(stderr, "DMA out of the rom: 0x%08zX-0x%08zX\n", (size_t)rom, (size_t)(rom + size));
+        exit(1);
+    }
+    memcpy(ram, sDmaSource + rom, size);
+
+    // Yaz0_DecompressImpl reads the size in the header as a native u32, swap it to host order
+    if (!BENCH_LZ4 && rom == sSegmentRomStart && size >= YAZ0_HEADER_SIZE) {
+        u32 decSize = read_u32_be((u8*)ram + 4);
+
+        memcpy((u8*)ram + 4, &decSize, sizeof(decSize));
+    }
+}
+
+/**
+ * Straightforward decoder used to check the output of the game's decoder.
+ */
+static int decompress_plain(const u8* src, size_t srcSize, u8* dst, size_t dstSize) {
+    size_t srcPos = YAZ0_HEADER_SIZE;
+    size_t dstPos = 0;
+    u32 header = 0;
+    int bitsLeft = 0;
+
+    while (dstPos < dstSize) {
+        if (bitsLeft == 0) {
+            if (srcPos >= srcSize) {
+                return -1;
+            }
+            header = src[srcPos++];
+            bitsLeft = 8;
+        }
+        if (header & 0x80) {
+            if (srcPos >= srcSize) {
+                return -1;
+            }
+            dst[dstPos++] = src[srcPos++];
+        } else {
+            size_t dist;
+            size_t len;
+
+            if (srcPos + 2 > srcSize) {
+                return -1;
+            }
+            dist = ((src[srcPos] & 0xF) << 8 | src[srcPos + 1]) + 1;
+            len = src[srcPos] >> 4;
+            srcPos += 2;
+            if (len == 0) {
+                if (srcPos >= srcSize) {
+                    return -1;
+                }
+                len = src[srcPos++] + 0x12;
+            } else {
+                len += 2;
+            }
+            if (dist > dstPos || dstPos + len > dstSize) {
+                return -1;
+            }
+            while (len-- != 0) {
+                dst[dstPos] = dst[dstPos - dist];
+                dstPos++;
+            }
+        }
+        header <<= 1;
+        bitsLeft--;
+    }
+    return 0;
+}
+
+#if BENCH_LZ4
+#define LZ4_HEADER_SIZE 0x10
+#define LZ4_MIN_MATCH 4
+#define LZ4_MAX_OFFSET 0xFFFF
+#define LZ4_LAST_LITERALS 5
+#define LZ4_MF_LIMIT 12
+#define LZ4_HASH_BITS 16
+
+static u8* lz4_write_length(u8* out, size_t length) {
+    while (length >= 0xFF) {
+        *out++ = 0xFF;
+        length -= 0xFF;
+    }
+    *out++ = length;
+    return out;
+}
+
+static u8* lz4_write_sequence(u8* out, const u8* literals, size_t litLen, size_t offset, size_t matchLen) {
+    size_t tokenLit = litLen < 0xF ? litLen : 0xF;
+    size_t tokenMatch = 0;
+
+    if (offset != 0) {
+        tokenMatch = matchLen - LZ4_MIN_MATCH < 0xF ? matchLen - LZ4_MIN_MATCH : 0xF;
+    }
+    *out++ = tokenLit << 4 | tokenMatch;
+    if (tokenLit == 0xF) {
+        out = lz4_write_length(out, litLen - 0xF);
+    }
+    memcpy(out, literals, litLen);
+    out += litLen;
+    if (offset != 0) {
+        *out++ = offset & 0xFF;
+        *out++ = offset >> 8;
+        if (tokenMatch == 0xF) {
+            out = lz4_write_length(out, matchLen - LZ4_MIN_MATCH - 0xF);
+        }
+    }
+    return out;
+}
+
+static u32 lz4_hash(const u8* p) {
+    u32 v;
+
+    memcpy(&v, p, sizeof(v));
+    return (v * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+/**
+ * Same greedy parse as compress_lz4 in tools/compress.py, with a hash table of the last position of each 4-byte
+ * sequence instead of a dict, so a hash collision can lose a match that compress_lz4 would find.
+ *
+ * @param out at least size + size / 255 + 0x20 bytes
+ * @return the compressed size
+ */
+static size_t lz4_compress(const u8* data, size_t size, u8* out) {
+    static long positions[1 << LZ4_HASH_BITS];
+    long matchLimit = (long)size - LZ4_MF_LIMIT;
+    long maxMatchEnd = (long)size - LZ4_LAST_LITERALS;
+    long anchor = 0;
+    long pos = 0;
+    u8* outStart = out;
+    size_t i;
+
+    memcpy(out, "LZ4B", 4);
+    out[4] = size >> 24;
+    out[5] = size >> 16;
+    out[6] = size >> 8;
+    out[7] = size;
+    memset(out + 8, 0, 8);
+    out += LZ4_HEADER_SIZE;
+
+    for (i = 0; i < ARRAY_COUNT(positions); i++) {
+        positions[i] = -1;
+    }
+
+    while (pos < matchLimit) {
+        u32 hash = lz4_hash(data + pos);
+        long cand = positions[hash];
+        long matchEnd;
+        long j;
+
+        positions[hash] = pos;
+        if (cand < 0 || pos - cand > LZ4_MAX_OFFSET || memcmp(data + cand, data + pos, LZ4_MIN_MATCH) != 0) {
+            pos++;
+            continue;
+        }
+
+        matchEnd = pos + LZ4_MIN_MATCH;
+        while (matchEnd < maxMatchEnd && data[matchEnd] == data[cand + matchEnd - pos]) {
+            matchEnd++;
+        }
+
+        out = lz4_write_sequence(out, data + anchor, pos - anchor, pos - cand, matchEnd - pos);
+
+        for (j = pos + 1; j < (matchEnd < matchLimit ? matchEnd : matchLimit); j += 2) {
+            positions[lz4_hash(data + j)] = j;
+        }
+        pos = anchor = matchEnd;
+    }
+
+    out = lz4_write_sequence(out, data + anchor, size - anchor, 0, 0);
+    return out - outStart;
+}
+#endif
+
+static u64 get_ticks(void) {
+#if HAVE_RDTSC
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static u64 get_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static u8* read_file(const char* path, size_t* size) {
+    FILE* f = fopen(path, "rb");
+    u8* data;
+    long len;
+
+    if (f == NULL) {
+        fprintf(stderr, "Could not open %s\n", path);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    data = malloc(len);
+    if (data == NULL || fread(data, 1, len, f) != (size_t)len) {
+        fprintf(stderr, "Could not read %s\n", path);
+        exit(1);
+    }
+    fclose(f);
+    *size = len;
+    return data;
+}
+
+int main(int argc, char** argv) {
+    size_t dmadataStart;
+    int repeat = 5;
+    size_t entry;
+    int numSegments = 0;
+    u64 totalCompSize = 0;
+    u64 totalDecSize = 0;
+    u64 totalTicks = 0;
+    u64 totalNs = 0;
+
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "Usage: %s ROM DMADATA_START [REPEAT]\n", argv[0]);
+        return 1;
+    }
+    sRom = read_file(argv[1], &sRomSize);
+    dmadataStart = strtoul(argv[2], NULL, 0);
+    if (argc == 4) {
+        repeat = atoi(argv[3]);
+        if (repeat < 1) {
+            repeat = 1;
+        }
+    }
+
+    if (sRomSize < 4 || read_u32_be(sRom) != 0x80371240) {
+        fprintf(stderr, "%s is not a big-endian (.z64) rom\n", argv[1]);
+        return 1;
+    }
+
+    for (entry = dmadataStart; entry + 0x10 <= sRomSize; entry += 0x10) {
+        u32 vromStart = read_u32_be(sRom + entry + 0x0);
+        u32 vromEnd = read_u32_be(sRom + entry + 0x4);
+        u32 romStart = read_u32_be(sRom + entry + 0x8);
+        u32 romEnd = read_u32_be(sRom + entry + 0xC);
+        size_t decSize = vromEnd - vromStart;
+        u64 bestTicks = UINT64_MAX;
+        u64 bestNs = UINT64_MAX;
+        u8* expected;
+        u8* out;
+        uintptr_t compStart;
+        size_t compSize;
+        int i;
+
+        if (vromStart == 0 && vromEnd == 0 && romStart == 0 && romEnd == 0) {
+            break;
+        }
+        if (romEnd == 0 || romStart == 0xFFFFFFFF || romEnd > sRomSize ||
+            memcmp(sRom + romStart, "Yaz0", 4) != 0) {
+            continue;
+        }
+
+        expected = malloc(decSize);
+        out = malloc(decSize);
+        if (decompress_plain(sRom + romStart, romEnd - romStart, expected, decSize) != 0) {
+            fprintf(stderr, "Segment at 0x%08X is not valid Yaz0 data\n", romStart);
+            return 1;
+        }
+
+#if BENCH_LZ4
+        sDmaSource = malloc(decSize + decSize / 255 + 0x20);
+        compStart = 0;
+        compSize = lz4_compress(expected, decSize, sDmaSource);
+        sDmaSourceSize = compSize;
+#else
+        sDmaSource = sRom;
+        sDmaSourceSize = sRomSize;
+        compStart = romStart;
+        compSize = romEnd - romStart;
+#endif
+
+        sSegmentRomStart = compStart;
+        for (i = 0; i < repeat; i++) {
+            u64 startNs = get_ns();
+            u64 startTicks = get_ticks();
+            u64 ticks;
+            u64 ns;
+
+#if BENCH_LZ4
+            Lz4_Decompress(compStart, out, compSize);
+#else
+            Yaz0_Decompress(compStart, out, compSize);
+#endif
+            ticks = get_ticks() - startTicks;
+            ns = get_ns() - startNs;
+
+            if (memcmp(out, expected, decSize) != 0) {
+                fprintf(stderr, "Wrong output for the segment at 0x%08X\n", romStart);
+                return 1;
+            }
+            if (ticks < bestTicks) {
+                bestTicks = ticks;
+            }
+            if (ns < bestNs) {
+                bestNs = ns;
+            }
+        }
+
+        free(expected);
+        free(out);
+#if BENCH_LZ4
+        free(sDmaSource);
+#endif
+
+        numSegments++;
+        totalCompSize += compSize;
+        totalDecSize += decSize;
+        totalTicks += bestTicks;
+        totalNs += bestNs;
+    }
+
+    printf("%s decoder: %d segments, 0x%llX -> 0x%llX bytes\n", DECODER_NAME, numSegments,
+           (unsigned long long)totalCompSize, (unsigned long long)totalDecSize);
+    printf("  %.2f ms, %.1f MB/s, %.3f bytes/%s, %.1f %s/KB (best of %d per segment)\n", totalNs / 1e6,
+           totalNs != 0 ? totalDecSize * 1e3 / totalNs : 0.0, totalTicks != 0 ? (double)totalDecSize / totalTicks : 0.0,
+           HAVE_RDTSC ? "cycle" : "ns", totalDecSize != 0 ? totalTicks * 1024.0 / totalDecSize : 0.0,
+           HAVE_RDTSC ? "cycles" : "ns", repeat);
+
+    free(sRom);
+    return 0;
+}
@@ -0,0 +1,9 @@
+#ifndef DMA_H
+#define DMA_H
+
+#include "ultra64.h"
+
+// Implemented by the harness as a copy out of the rom loaded in memory
+void DmaMgr_DmaRomToRam(uintptr_t rom, void* ram, size_t size);
+
+#endif
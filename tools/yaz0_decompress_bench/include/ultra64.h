@@ -0,0 +1,20 @@
+#ifndef ULTRA64_H
+#define ULTRA64_H
+
+// Minimal stand-in for the libultra header, enough to build src/boot/yaz0.c for the host
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <strings.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef int64_t s64;
+
+#endif